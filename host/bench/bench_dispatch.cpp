@@ -0,0 +1,93 @@
+// Host-Benchmark: Subscription-Dispatch von bus::emit_sticky.
+// Registriert S nicht passende Abos (exakt / prefix-* / suffix-*) plus eine feste
+// Menge passender Abos und misst die Emit-Kosten. Erwartung: ns/op hängt an der
+// Trefferzahl, nicht an S. Vorab: Treffer-Check gegen die einfache '*'-Semantik
+// und gegen mehr Treffer als MAX_HITS (alle Handler, Überlauf gezählt).
+// bench_dispatch_prof: dieselbe Messung mit -D BUS_PROFILE=1 (Overhead des Profilings).
+
+#include <Arduino.h>
+#include "core/bus.hpp"
+
+#include <chrono>
+#include <vector>
+
+static unsigned s_calls = 0;
+static void on_evt(bus::topic_t, const bus::Payload&) { ++s_calls; }
+
+// Referenz: '*' als Prefix-/Suffix-Wildcard ("pre*post")
+static bool ref_match(const String& p, const String& t) {
+  int star = p.indexOf('*');
+  if (star < 0) return p == t;
+  String pre = p.substring(0, star), post = p.substring(star + 1);
+  return t.length() >= pre.length() + post.length() && t.startsWith(pre) && t.endsWith(post);
+}
+
+static bool check_semantics() {
+  const char* pats[] = { "*", "power.*", "power.dev.*", "ui.brightness", "*.ready", "*.dev.prevent_standby",
+                         "pow*", "*ness", "power.*.prevent_standby", "display", "display.*", "*.*" };
+  const char* topics[] = { "power.dev.prevent_standby", "ui.brightness", "display.ready", "display",
+                           "power", "power.", "time.ready", "powerx", "x.ready.y", "a" };
+  bool ok = true;
+  for (const char* t : topics) {
+    bus::init(nullptr);
+    unsigned expect = 0;
+    for (const char* p : pats) { bus::subscribe(p, on_evt); if (ref_match(p, t)) ++expect; }
+    s_calls = 0;
+    bus::emit_sticky(t, "value=1");
+    if (s_calls != expect) { printf("MISMATCH topic=%s calls=%u expect=%u\n", t, s_calls, expect); ok = false; }
+  }
+  // Mehr Treffer als der Stack-Puffer fasst: jeder Handler wird aufgerufen (Heap-Pfad)
+  bus::init(nullptr);
+  const unsigned MANY = 100;
+  for (unsigned i = 0; i < MANY; ++i) bus::subscribe(i % 2 ? "ui.*" : "ui.brightness", on_evt);
+  const uint32_t spills = bus::hit_spills();
+  s_calls = 0;
+  bus::emit_sticky("ui.brightness", "value=1");
+  if (s_calls != MANY || bus::hit_spills() != spills + 1) {
+    printf("MISMATCH many calls=%u expect=%u spills=%u\n", s_calls, MANY, (unsigned)(bus::hit_spills() - spills));
+    ok = false;
+  }
+  return ok;
+}
+
+int main() {
+  if (!check_semantics()) return 1;
+
+  static const size_t SUBS[] = { 0, 16, 64, 256, 1024, 4096 };
+  static const size_t OPS = 200000;
+  const bus::topic_t topic = bus::t::backlight_gamma;
+  const bus::Payload kv = bus::Payload().set(bus::k::value, 2.2f);
+
+  printf("%8s %8s %14s\n", "subs", "hits", "emit ns/op");
+  for (size_t n : SUBS) {
+    bus::init(nullptr);
+    bus::subscribe("backlight.*", on_evt);
+    bus::subscribe("backlight.gamma", on_evt);
+    bus::subscribe("*.gamma", on_evt);
+    for (size_t i = 0; i < n; ++i) {
+      String sec = String("sec") + String((unsigned)i);
+      switch (i % 3) {
+        case 0: bus::subscribe(sec + ".key", on_evt); break;
+        case 1: bus::subscribe(sec + ".*", on_evt); break;
+        case 2: bus::subscribe(String("*.") + sec, on_evt); break;
+      }
+    }
+    s_calls = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPS; ++i) bus::emit_sticky(topic, kv);
+    auto dt = std::chrono::steady_clock::now() - t0;
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / OPS;
+    printf("%8zu %8u %14.1f\n", n, s_calls / (unsigned)OPS, ns);
+  }
+
+  // Mit BUS_PROFILE: Plausibilität der Zähler aus dem letzten Lauf
+  if (bus::profiling()) {
+    bus::SubProfile sp[3];
+    const size_t k = bus::profile_top_subs(sp, 3);
+    for (size_t i = 0; i < k; ++i) {
+      printf("prof sub=%-16s calls=%u total_us=%u max_us=%u\n", bus::sub_pattern(sp[i].id).c_str(),
+             sp[i].calls, sp[i].total_us, sp[i].max_us);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,183 @@
+// Host-Benchmark: INI laden (ini_reader + config::init) mit Allokationszähler
+// (globaler operator new wie in bench_parser).
+// Erzeugt dev.ini mit 1k bzw. 10k Keys (100 Keys je Section, CRLF, Inline-
+// Kommentare, Kommentarzeilen) in einem Temp-Verzeichnis; user.ini fehlt.
+//   String-Zeilenleser  – alter Weg (readStringUntil/trim/substring), Referenz
+//   ini::Reader         – Zerlegung allein, muss 0 alloc/key bleiben
+//   config load (cold)  – erster Ladevorgang (einmal): Topic-Namen/Stickies
+//                         werden neu angelegt (Bus-Speicher, nicht der Leser)
+//   config load (warm)  – config::init erneut: alles existiert schon → der
+//                         INI-Pfad selbst; 10k − 1k Keys dürfen keine
+//                         Allokation mehr kosten als 1k
+// Median aus REPS Läufen, Cache aus (config::set_cache(false)). Exit 1 bei Allokationen je Key.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "host_shim.h"
+#include "core/bus.hpp"
+#include "services/ini_reader.hpp"
+#include "services/service_config.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace stdfs = std::filesystem;
+
+void* operator new(size_t n) {
+  host::heap_note_alloc(n);
+  if (void* p = std::malloc(n)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t n) { return operator new(n); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+static const int REPS = 5;
+
+struct Result { double ns_per_key; double allocs_per_key; uint64_t allocs; };
+
+template <typename F>
+static Result run(size_t keys, F&& body, int reps = REPS) {
+  std::vector<double> ns;
+  std::vector<uint64_t> al;
+  for (int r = 0; r < reps; ++r) {
+    const uint64_t a0 = host::heap_alloc_count();
+    auto t0 = std::chrono::steady_clock::now();
+    body();
+    auto dt = std::chrono::steady_clock::now() - t0;
+    ns.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / (double)keys);
+    al.push_back(host::heap_alloc_count() - a0);
+  }
+  std::sort(ns.begin(), ns.end());
+  std::sort(al.begin(), al.end());
+  const uint64_t a = al[al.size() / 2];
+  return { ns[ns.size() / 2], (double)a / (double)keys, a };
+}
+
+static void report(const char* name, size_t keys, const Result& r) {
+  printf("%-28s %8zu %10.1f %12.0f %12.4f %10llu\n", name, keys, r.ns_per_key, 1e9 / r.ns_per_key,
+         r.allocs_per_key, (unsigned long long)r.allocs);
+}
+
+static void write_ini(const stdfs::path& p, size_t keys) {
+  std::ofstream f(p, std::ios::binary);
+  f << "; generiert von bench_ini\r\n";
+  for (size_t i = 0; i < keys; ++i) {
+    if (i % 100 == 0) f << "\r\n[bench" << keys << ".s" << i / 100 << "]\r\n# Section " << i / 100 << "\r\n";
+    f << "k" << i % 100 << " = " << (i % 3 ? std::to_string(i) : "v" + std::to_string(i % 1000));
+    if (i % 7 == 0) f << "   ; Inline-Kommentar";
+    f << "\r\n";
+  }
+}
+
+// Alter Zeilenleser aus service_config.cpp (nur Zerlegung, zum Vergleich)
+static size_t string_reader() {
+  File f = LittleFS.open("/config/dev.ini", "r");
+  size_t n = 0;
+  String section;
+  while (f.available()) {
+    String line = f.readStringUntil('\n');
+    line.trim();
+    if (!line.length() || line.startsWith(";") || line.startsWith("#")) continue;
+    if (line.startsWith("[") && line.endsWith("]")) {
+      section = line.substring(1, line.length() - 1);
+      section.trim();
+      continue;
+    }
+    int eq = line.indexOf('=');
+    if (eq <= 0) continue;
+    String key = line.substring(0, eq); key.trim();
+    String val = line.substring(eq + 1); val.trim();
+    n += key.length() + val.length();
+  }
+  f.close();
+  return n;
+}
+
+int main() {
+  const stdfs::path root = stdfs::temp_directory_path() / ("twatch_bench_ini_" + std::to_string(getpid()));
+  stdfs::remove_all(root);
+  stdfs::create_directories(root / "config");
+  host::fs_set_root(root.string());
+  LittleFS.begin(false);
+  Serial.host_mute(true);
+  config::set_cache(false);
+
+  printf("%-28s %8s %10s %12s %12s %10s\n", "case", "keys", "ns/key", "keys/s", "allocs/key", "allocs");
+
+  int fails = 0;
+  uint64_t warm_allocs[2] = {};
+  const size_t SIZES[2] = { 1000, 10000 };
+  for (int s = 0; s < 2; ++s) {
+    const size_t K = SIZES[s];
+    write_ini(root / "config" / "dev.ini", K);
+    char name[48];
+
+    size_t sink = 0;
+    Result r = run(K, [&] { sink += string_reader(); });
+    snprintf(name, sizeof(name), "String-Zeilenleser %zuk", K / 1000);
+    report(name, K, r);
+
+    // Reader allein: Allokationen nur innerhalb der Schleife (open/close sind je Datei)
+    size_t got = 0, skipped = 0;
+    uint64_t reader_allocs = 0;
+    r = run(K, [&] {
+      File f = LittleFS.open("/config/dev.ini", "r");
+      const uint64_t a0 = host::heap_alloc_count();
+      ini::Reader rd(f);
+      ini::Entry e;
+      got = 0;
+      while (rd.next(e)) { ++got; sink += e.value.n; }
+      skipped = rd.skipped();
+      reader_allocs = host::heap_alloc_count() - a0;
+      f.close();
+    });
+    r.allocs = reader_allocs;
+    r.allocs_per_key = (double)reader_allocs / (double)K;
+    snprintf(name, sizeof(name), "ini::Reader %zuk", K / 1000);
+    report(name, K, r);
+    if (got != K || skipped) { printf("FAIL reader: %zu/%zu keys, skipped=%zu\n", got, K, skipped); ++fails; }
+    if (reader_allocs) { printf("FAIL reader: %llu allocs\n", (unsigned long long)reader_allocs); ++fails; }
+
+    r = run(K, [&] { bus::init(nullptr); config::init(); }, 1);   // einmalig: Topics neu
+    snprintf(name, sizeof(name), "config load %zuk (cold)", K / 1000);
+    report(name, K, r);
+
+    r = run(K, [&] { config::init(); });
+    snprintf(name, sizeof(name), "config load %zuk (warm)", K / 1000);
+    report(name, K, r);
+    warm_allocs[s] = r.allocs;
+    // Topic-IDs sind FNV-1a (32 Bit): kollidierende Namen bekommen eine Ausweich-ID
+    size_t accepted = 0;
+    for (size_t i = 0; i < K; ++i) {
+      const int n = snprintf(name, sizeof(name), "bench%zu.s%zu.k%zu", K, i / 100, i % 100);
+      const bus::topic_t id = bus::intern(name, (size_t)n);
+      if (id != bus::topic_t::NONE && bus::find_topic(name, (size_t)n) == id) ++accepted;
+    }
+    printf("%-28s %8zu stickies=%u (FNV-Kollisionen auf Ausweich-ID: %u)\n", "", K, (unsigned)bus::sticky_count(),
+           (unsigned)bus::topic_probed());
+    if (accepted != K) { printf("FAIL config: %zu/%zu Topics interniert\n", accepted, K); ++fails; }
+    if (bus::sticky_count() != K) { printf("FAIL config: stickies=%u != %zu\n", (unsigned)bus::sticky_count(), K); ++fails; }
+    if (!sink) return 2;
+  }
+
+  // Zuwachs 1k → 10k im warmen Pfad = Allokationen je zusätzlichem Key
+  const double marginal = ((double)warm_allocs[1] - (double)warm_allocs[0]) / (double)(SIZES[1] - SIZES[0]);
+  printf("\nconfig load allocs/key (10k vs 1k, warm): %.4f (%llu vs %llu je Ladevorgang)\n", marginal,
+         (unsigned long long)warm_allocs[1], (unsigned long long)warm_allocs[0]);
+  if (warm_allocs[1] > warm_allocs[0]) { printf("FAIL config: Allokationen wachsen mit der Key-Zahl\n"); ++fails; }
+
+  stdfs::remove_all(root);
+  printf(fails ? "FAIL (%d)\n" : "PASS\n", fails);
+  return fails ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+// Host-Benchmark: Firmware-Stack ohne Hardware (Parser, Services, Treiber-Fakes).
+// Misst auf einer Kopie von data/ (LittleFS-Wurzel im Temp-Verzeichnis):
+//   - Emit-Durchsatz: ui.brightness (mit Service-Abos) und ein Topic ohne Abos
+//   - Parser: gemischte Konsolenbefehle pro Sekunde über api::handleLine
+//   - Config: bus::init + config::init je Ladevorgang, INI-Parser vs. cache.bin;
+//     do config.reload ohne Änderung (nur Diff, keine Emits);
+//     Write-Behind: set ui.brightness im Drag-Tempo → Schreibvorgänge
+//   - Konsole: Bytes je state.power.telemetry-Event, Textzeile vs. bin-Frame
+// Jede Messung läuft REPS-mal mit festen Iterationszahlen; ausgegeben wird der
+// Median → auf einer CI-Maschine reproduzierbar (Serial ist stummgeschaltet).
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "host_shim.h"
+#include "core/bus.hpp"
+#include "core/console.hpp"
+#include "core/console_frame.hpp"
+#include "core/api_parser.hpp"
+#include "services/service_config.hpp"
+#include "services/service_power.hpp"
+#include "services/service_display.hpp"
+#include "services/service_touch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+#include <unistd.h>
+
+namespace stdfs = std::filesystem;
+
+static const int REPS = 5;
+
+static void outln(const String& s) { console::println(s); }
+
+static double median(std::vector<double> v) {
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+template <typename F>
+static double ns_per_op(size_t ops, F&& body) {
+  std::vector<double> runs;
+  for (int r = 0; r < REPS; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    body();
+    auto dt = std::chrono::steady_clock::now() - t0;
+    runs.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / (double)ops);
+  }
+  return median(runs);
+}
+
+static void report(const char* name, size_t ops, double ns) {
+  printf("%-28s %10zu %12.1f %14.0f\n", name, ops, ns, 1e9 / ns);
+}
+
+// Wie setup() in main.cpp, ohne Boot-Ausgaben
+static void boot_stack() {
+  bus::init(outln);
+  config::init();
+  svc::power::init();
+  svc::power::hw_init();   // Boot-Stages synchron (in main.cpp auf dem Hintergrund-Task)
+  svc::power::hw_attach();
+  svc::display::hw_init();
+  svc::display::init();
+  svc::touch::hw_init();
+  svc::touch::init();
+  svc::power::telemetry_read();
+  svc::power::telemetry_publish();
+  api::init(outln);
+}
+
+int main() {
+  // Arbeitskopie von data/ → Benchmarks schreiben nie ins Repo
+  const stdfs::path root = stdfs::temp_directory_path() / ("twatch_bench_" + std::to_string(getpid()));
+  stdfs::remove_all(root);
+  stdfs::copy(HOST_DATA_DIR, root, stdfs::copy_options::recursive);
+  host::fs_set_root(root.string());
+  LittleFS.begin(false);
+  Serial.host_mute(true);
+
+  boot_stack();
+
+  printf("%-28s %10s %12s %14s\n", "case", "ops", "ns/op", "ops/s");
+
+  // --- Emit ---
+  {
+    const size_t OPS = 200000;
+    double ns = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i)
+        bus::emit_sticky(bus::t::ui_brightness, bus::Payload().set(bus::k::value, (int)(i % 100)));
+    });
+    report("emit ui.brightness", OPS, ns);
+
+    const bus::topic_t quiet = bus::intern(String("bench.quiet"));
+    ns = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) bus::emit_sticky(quiet, bus::Payload().set(bus::k::value, (int)i));
+    });
+    report("emit (no subscribers)", OPS, ns);
+  }
+
+  // --- Parser ---
+  {
+    static const char* const CMDS[] = {
+      "ping",
+      "set ui.brightness value=40",
+      "set backlight.gamma value=2.2",
+      "info bus.queue",
+      "get ui.brightness",
+      "emit bench.parser value=1",
+      "info heap",
+      "set ui.brightness value=60",
+    };
+    const size_t N = sizeof(CMDS) / sizeof(CMDS[0]);
+    std::vector<String> lines(CMDS, CMDS + N);
+    const size_t OPS = 100000;
+    double ns = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) api::handleLine(lines[i % N]);
+    });
+    report("parser mixed cmds", OPS, ns);
+  }
+
+  // --- Config: INI-Parser vs. Binär-Image (cache.bin) ---
+  {
+    const size_t OPS = 200;
+    config::set_cache(false);
+    double ns = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) { bus::init(outln); config::init(); }
+    });
+    printf("%-28s %10zu %12.1f %14.0f   (stickies=%u)\n", "config load (dev+user.ini)", OPS, ns, 1e9 / ns,
+           (unsigned)bus::sticky_count());
+
+    config::set_cache(true);
+    LittleFS.remove("/config/cache.bin");
+    bus::init(outln); config::init();             // erster Boot: INIs parsen + Image bauen
+    const config::LoadStats build = config::load_stats();
+    ns = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) { bus::init(outln); config::init(); }
+    });
+    const config::LoadStats& hit = config::load_stats();
+    printf("%-28s %10zu %12.1f %14.0f   (stickies=%u cached=%d image=%u B, build=%u us)\n",
+           "config load (cache.bin)", OPS, ns, 1e9 / ns, (unsigned)bus::sticky_count(), hit.cached ? 1 : 0,
+           (unsigned)hit.bytes, (unsigned)build.write_us);
+  }
+
+  // --- Config: Reload (Diff gegen die Stickies) vs. komplettes init ---
+  {
+    const size_t OPS = 200;
+    bus::init(outln); config::init();
+    double ns = ns_per_op(OPS, [&] { for (size_t i = 0; i < OPS; ++i) config::reload(); });
+    const config::ReloadStats r = config::reload();
+    printf("%-28s %10zu %12.1f %14.0f   (changed=%u same=%u)\n", "config reload (no edit)", OPS, ns, 1e9 / ns,
+           (unsigned)r.changed, (unsigned)r.same);
+  }
+
+  // --- Config: Write-Behind (Slider-Drag → ein Schreibvorgang pro Fenster) ---
+  {
+    bus::Payload dp;
+    config::accept(bus::intern(String("config.persist.debounce_ms")), "20", 2, dp);
+    const uint32_t w0 = config::persist_stats().writes;
+    const size_t OPS = 100;
+    char cmd[48];
+    double ns = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) {
+        snprintf(cmd, sizeof(cmd), "set ui.brightness value=%u", (unsigned)(i % 100));
+        api::handleLine(cmd, strlen(cmd));
+        config::poll();
+      }
+    });
+    while (config::is_dirty()) { config::poll(); delay(1); }   // Fenster abwarten
+    const config::PersistStats& ps = config::persist_stats();
+    printf("%-28s %10zu %12.1f %14.0f   (writes=%u for %u sets, %u B, write=%u us)\n", "config set (write-behind)",
+           OPS, ns, 1e9 / ns, (unsigned)(ps.writes - w0), (unsigned)(REPS * OPS), (unsigned)ps.last_bytes,
+           (unsigned)ps.last_us);
+  }
+
+  // --- Konsole: Telemetrie text vs. bin ---
+  {
+    bus::Payload p;
+    p.set(bus::k::phase, "ready").set(bus::k::vbat_mv, 4012).set(bus::k::vsys_mv, 4950).set(bus::k::vbus_mv, 5012);
+    const uint32_t id = (uint32_t)bus::t::state_power_telemetry;
+    const size_t OPS = 200000;
+    size_t text_bytes = 0, bin_bytes = 0;
+    char kv[192];
+    double ns_text = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) {
+        const size_t n = p.render(kv, sizeof(kv));   // wie bus::sink_evt
+        String line = "evt ";
+        line += bus::topic_name(bus::t::state_power_telemetry);
+        if (n) { line += " "; line += kv; }
+        text_bytes = line.length() + 2;              // + CR/LF
+      }
+    });
+    uint8_t f[console::frame::FRAME_MAX];
+    double ns_bin = ns_per_op(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) bin_bytes = console::encode_evt(id, p, f, sizeof(f));
+    });
+    report("telemetry evt text", OPS, ns_text);
+    report("telemetry evt bin", OPS, ns_bin);
+    printf("%-28s %10zu B %10zu B %10.1fx\n", "telemetry bytes text/bin", text_bytes, bin_bytes,
+           (double)text_bytes / (double)bin_bytes);
+  }
+
+  stdfs::remove_all(root);
+  return 0;
+}
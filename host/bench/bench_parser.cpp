@@ -0,0 +1,285 @@
+// Host-Benchmark: Konsolen-Parser (api_tokenizer + api::handleLine).
+// Befehle aus den Golden Paths (docs/07, docs/08: Boot→App→Brightness) plus
+// Quote-Werte. Gemessen je Fall: ns/cmd, cmds/s und Heap-Allokationen pro Befehl
+// (globaler operator new zählt über host::heap_note_alloc).
+//   tokenize      – nur Zerlegung, muss 0 alloc/cmd bleiben
+//   route lookup  – Verb + Routing-Tabelle (api_routes), unabhängig von der Tabellengröße
+//   handleLine    – kompletter Pfad inkl. Emit und Antwortzeile (Sink bekommt String)
+// Median aus REPS Läufen, Serial stummgeschaltet.
+//
+// Regressionsprüfung gegen eine gespeicherte Baseline (parser_baseline.txt):
+//   bench_parser --check  <baseline>   exit 1, wenn cmds/s, allocs/cmd oder der
+//                                      Heap-Spitzenwert je Befehl schlechter werden
+//   bench_parser --update <baseline>   aktuelle Werte als neue Baseline schreiben
+// Zeit schwankt auf Host-Maschinen stark → eigene (großzügige) Toleranz; Heap ist
+// deterministisch und bekommt nur wenig Spielraum.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "host_shim.h"
+#include "core/bus.hpp"
+#include "core/console.hpp"
+#include "core/api_parser.hpp"
+#include "core/api_tokenizer.hpp"
+#include "core/api_routes.hpp"
+#include "services/service_config.hpp"
+#include "services/service_power.hpp"
+#include "services/service_display.hpp"
+#include "services/service_touch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace stdfs = std::filesystem;
+
+// --- Allokationszähler + belegter Heap (Größe im Kopf vor dem Block) ---
+static const size_t HDR = alignof(std::max_align_t);
+static size_t s_live = 0, s_peak = 0;
+
+void* operator new(size_t n) {
+  host::heap_note_alloc(n);
+  if (char* p = (char*)std::malloc(n + HDR)) {
+    *(size_t*)p = n;
+    s_live += n;
+    if (s_live > s_peak) s_peak = s_live;
+    return p + HDR;
+  }
+  throw std::bad_alloc();
+}
+void* operator new[](size_t n) { return operator new(n); }
+void  operator delete(void* p) noexcept {
+  if (!p) return;
+  char* h = (char*)p - HDR;
+  s_live -= *(size_t*)h;
+  std::free(h);
+}
+void  operator delete[](void* p) noexcept { operator delete(p); }
+void  operator delete(void* p, size_t) noexcept { operator delete(p); }
+void  operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+static const int REPS = 5;
+
+static size_t s_sink_lines = 0;
+static void sink(const String&) { ++s_sink_lines; }   // Antworten zählen, nicht ausgeben
+static void outln(const String& s) { console::println(s); }
+
+static const char* const CMDS[] = {
+  "ping",
+  "get time.now",
+  "get ui.brightness",
+  "get backlight.gamma",
+  "get power.* fields=value",
+  "set ui.brightness value=65",
+  "do power.ready",
+  "sub power.*",
+  "unsub *",
+  "info heap",
+  "set backlight.gamma value=2.2",
+  "do display.cal gamma=2.2",
+  "emit app.note text=\"hello world\" n=3",
+  "emit app.note text=\"say \\\"hi\\\"\"",
+};
+static const size_t NCMDS = sizeof(CMDS) / sizeof(CMDS[0]);
+
+struct Result { double ns; double allocs; double best_ns; };
+
+template <typename F>
+static Result run(size_t ops, F&& body) {
+  std::vector<double> ns, al;
+  for (int r = 0; r < REPS; ++r) {
+    const uint64_t a0 = host::heap_alloc_count();
+    auto t0 = std::chrono::steady_clock::now();
+    body();
+    auto dt = std::chrono::steady_clock::now() - t0;
+    ns.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / (double)ops);
+    al.push_back((double)(host::heap_alloc_count() - a0) / (double)ops);
+  }
+  std::sort(ns.begin(), ns.end());
+  std::sort(al.begin(), al.end());
+  return { ns[ns.size() / 2], al[al.size() / 2], ns.front() };
+}
+
+static void report(const char* name, size_t ops, const Result& r) {
+  printf("%-40s %10zu %12.1f %14.0f %12.2f\n", name, ops, r.ns, 1e9 / r.ns, r.allocs);
+}
+
+// Baseline im INI-Stil: "key = value", '#'/';' Kommentar
+struct Baseline {
+  double cmds_per_s        = 0;
+  double allocs_per_cmd    = 0;
+  double peak_heap_per_cmd = 0;
+  double time_tolerance_pct = 50;
+  double heap_tolerance_pct = 10;
+};
+
+static bool baseline_load(const char* path, Baseline& b) {
+  std::ifstream f(path);
+  if (!f) return false;
+  std::string line;
+  while (std::getline(f, line)) {
+    const size_t eq = line.find('=');
+    if (line.empty() || line[0] == '#' || line[0] == ';' || eq == std::string::npos) continue;
+    std::string k = line.substr(0, eq);
+    k.erase(k.find_last_not_of(" \t") + 1);
+    const double v = atof(line.c_str() + eq + 1);
+    if      (k == "cmds_per_s")         b.cmds_per_s = v;
+    else if (k == "allocs_per_cmd")     b.allocs_per_cmd = v;
+    else if (k == "peak_heap_per_cmd")  b.peak_heap_per_cmd = v;
+    else if (k == "time_tolerance_pct") b.time_tolerance_pct = v;
+    else if (k == "heap_tolerance_pct") b.heap_tolerance_pct = v;
+  }
+  return b.cmds_per_s > 0;
+}
+
+static bool baseline_store(const char* path, const Baseline& b) {
+  std::ofstream f(path);
+  if (!f) return false;
+  f << "# bench_parser --check: handleLine (golden paths), bester von " << REPS << " Läufen\n"
+    << "# cmds_per_s: Untergrenze abzüglich time_tolerance_pct\n"
+    << "# allocs_per_cmd, peak_heap_per_cmd (Bytes): Obergrenze zuzüglich heap_tolerance_pct\n"
+    << "# neu schreiben: bench_parser --update <datei>\n"
+    << "cmds_per_s = " << (long)b.cmds_per_s << "\n"
+    << "allocs_per_cmd = " << b.allocs_per_cmd << "\n"
+    << "peak_heap_per_cmd = " << (long)b.peak_heap_per_cmd << "\n"
+    << "time_tolerance_pct = " << b.time_tolerance_pct << "\n"
+    << "heap_tolerance_pct = " << b.heap_tolerance_pct << "\n";
+  return (bool)f;
+}
+
+static bool check(const char* what, double got, double limit, bool upper) {
+  const bool ok = upper ? got <= limit : got >= limit;
+  printf("check %-20s %12.2f %s %12.2f  %s\n", what, got, upper ? "<=" : ">=", limit, ok ? "ok" : "REGRESSION");
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  const char* check_path  = nullptr;
+  const char* update_path = nullptr;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (!strcmp(argv[i], "--check"))  check_path  = argv[++i];
+    else if (!strcmp(argv[i], "--update")) update_path = argv[++i];
+  }
+
+  const stdfs::path root = stdfs::temp_directory_path() / ("twatch_bench_parser_" + std::to_string(getpid()));
+  stdfs::remove_all(root);
+  stdfs::copy(HOST_DATA_DIR, root, stdfs::copy_options::recursive);
+  host::fs_set_root(root.string());
+  LittleFS.begin(false);
+  Serial.host_mute(true);
+
+  bus::init(outln);
+  config::init();
+  svc::power::init();
+  svc::power::hw_init();   // Boot-Stages synchron (in main.cpp auf dem Hintergrund-Task)
+  svc::power::hw_attach();
+  svc::display::hw_init();
+  svc::display::init();
+  svc::touch::hw_init();
+  svc::touch::init();
+  svc::power::telemetry_read();
+  svc::power::telemetry_publish();
+  api::init(sink);
+
+  // Plausibilität: Quote-Werte und exakte Keys
+  {
+    static api::Tokens t;
+    const char* l = "emit app.note xvalue=1 text=\"a \\\"b\\\" c\" value=7";
+    api::Span v;
+    if (api::tokenize(l, strlen(l), t) != api::TOK_OK || !t.get("text", v) || !v.eq("a \"b\" c") ||
+        !t.get("value", v) || !v.eq("7") || t.has("xval")) {
+      fprintf(stderr, "tokenizer self-check failed\n");
+      return 1;
+    }
+  }
+
+  printf("%-40s %10s %12s %14s %12s\n", "case", "ops", "ns/cmd", "cmds/s", "allocs/cmd");
+
+  const size_t OPS = 120000;
+  {
+    static api::Tokens t;
+    size_t keep = 0;
+    Result r = run(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) {
+        const char* l = CMDS[i % NCMDS];
+        api::tokenize(l, strlen(l), t);
+        keep += t.nkv;
+      }
+    });
+    report("tokenize (golden paths)", OPS, r);
+    if (!keep) return 1;
+  }
+  {
+    // Routing allein: vorzerlegte Zeilen, verb_of + route_find (perfekter Hash)
+    static api::Tokens toks[NCMDS];
+    for (size_t c = 0; c < NCMDS; ++c) api::tokenize(CMDS[c], strlen(CMDS[c]), toks[c]);
+    size_t hits = 0;
+    Result r = run(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) {
+        const api::Tokens& t = toks[i % NCMDS];
+        api::Verb v;
+        if (api::verb_of(t.verb, v) && api::route_find(v, t.subj)) ++hits;
+      }
+    });
+    report("route lookup", OPS, r);
+    if (!hits) return 1;
+  }
+  Baseline cur;
+  {
+    Result r = run(OPS, [&] {
+      for (size_t i = 0; i < OPS; ++i) {
+        const char* l = CMDS[i % NCMDS];
+        api::handleLine(l, strlen(l));
+      }
+    });
+    report("handleLine (golden paths)", OPS, r);
+    cur.cmds_per_s = 1e9 / r.best_ns;           // bester Lauf: robuster gegen Störungen als der Median
+    cur.allocs_per_cmd = r.allocs;
+  }
+  printf("responses: %zu\n\n", s_sink_lines);
+
+  // Aufschlüsselung je Befehl: 1 alloc = Antwortzeile; mehr stammt aus Abo-Anlage bzw. Service-Handlern.
+  // heap peak = höchster zusätzlich belegter Heap während eines einzelnen Aufrufs.
+  printf("%-40s %10s %12s %14s %12s %10s\n", "command", "ops", "ns/cmd", "cmds/s", "allocs/cmd", "heap peak");
+  for (size_t c = 0; c < NCMDS; ++c) {
+    const size_t N = 10000;
+    Result r = run(N, [&] { for (size_t i = 0; i < N; ++i) api::handleLine(CMDS[c], strlen(CMDS[c])); });
+    const size_t base = s_live;
+    s_peak = s_live;
+    api::handleLine(CMDS[c], strlen(CMDS[c]));
+    const size_t peak = s_peak - base;
+    if (peak > cur.peak_heap_per_cmd) cur.peak_heap_per_cmd = (double)peak;
+    printf("%-40s %10zu %12.1f %14.0f %12.2f %10zu\n", CMDS[c], N, r.ns, 1e9 / r.ns, r.allocs, peak);
+    api::handleLine("unsub *", 7);
+  }
+
+  stdfs::remove_all(root);
+
+  if (update_path) {
+    Baseline old;
+    if (baseline_load(update_path, old)) {
+      cur.time_tolerance_pct = old.time_tolerance_pct;
+      cur.heap_tolerance_pct = old.heap_tolerance_pct;
+    }
+    if (!baseline_store(update_path, cur)) { fprintf(stderr, "cannot write %s\n", update_path); return 2; }
+    printf("\nbaseline written: %s\n", update_path);
+  }
+  if (check_path) {
+    Baseline b;
+    if (!baseline_load(check_path, b)) { fprintf(stderr, "cannot read baseline %s\n", check_path); return 2; }
+    const double tt = b.time_tolerance_pct / 100.0, ht = b.heap_tolerance_pct / 100.0;
+    printf("\n");
+    bool ok = check("cmds/s", cur.cmds_per_s, b.cmds_per_s * (1.0 - tt), false);
+    ok &= check("allocs/cmd", cur.allocs_per_cmd, b.allocs_per_cmd * (1.0 + ht), true);
+    ok &= check("peak heap/cmd", cur.peak_heap_per_cmd, b.peak_heap_per_cmd * (1.0 + ht), true);
+    if (!ok) return 1;
+  }
+  return 0;
+}
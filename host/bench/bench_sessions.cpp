@@ -0,0 +1,110 @@
+// Host-Benchmark: Konsolen-Sessions (session.cpp) mit Pseudo-Transporten.
+//   console  – monitor=off, keine Abos       → darf kein Event sehen
+//   fast     – Zeilensenke, sub bench.a.*    → genau die a-Events
+//   slow     – Ring 1 KiB, sub bench.*, wird nie gelesen → verwirft bei sich
+//   limited  – Ring, sub bench.a.*, rate=100/s
+// Emittiert N Events abwechselnd auf bench.a.x / bench.b.y und prüft Isolation,
+// Fan-out und dass die volle Session weder Emitter noch andere Sessions bremst.
+// Exit 1 bei Abweichung.
+
+#include <Arduino.h>
+#include "core/bus.hpp"
+#include "core/session.hpp"
+#include "core/api_parser.hpp"
+
+#include <chrono>
+#include <cstring>
+
+static size_t s_console_evt = 0, s_console_lines = 0;
+static size_t s_fast_evt = 0, s_fast_b = 0;
+static String s_fast_last;
+
+static void console_sink(const String& l) {
+  ++s_console_lines;
+  if (l.startsWith("evt ")) ++s_console_evt;
+}
+
+static void fast_sink(const String& l) {
+  if (l.startsWith("evt bench.a.")) ++s_fast_evt;
+  else if (l.startsWith("evt ")) ++s_fast_b;
+  else s_fast_last = l;
+}
+
+static void cmd(uint8_t sid, const char* l) { api::handleLine(sid, l, strlen(l)); }
+
+static double emit_ns(size_t n, const bus::Payload& p) {
+  const bus::topic_t a = bus::intern("bench.a.x", 9), b = bus::intern("bench.b.y", 9);
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < n; ++i) bus::emit_sticky((i & 1) ? b : a, p);
+  auto dt = std::chrono::steady_clock::now() - t0;
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / (double)n;
+}
+
+static int fails = 0;
+static void expect(bool ok, const char* what) {
+  if (!ok) { printf("FAIL %s\n", what); ++fails; }
+}
+
+int main() {
+  static const size_t N = 200000;
+  const bus::Payload p = bus::Payload().set(bus::k::value, 42);
+
+  bus::init(nullptr);
+  api::init(console_sink);
+  cmd(session::CONSOLE, "set session.monitor value=off");
+
+  // Referenz: nur die Konsole, keine Abos
+  const double base = emit_ns(N, p);
+  expect(s_console_evt == 0, "console ohne Abo sieht Events");
+
+  const uint8_t fast    = api::open_session("fast", fast_sink);
+  const uint8_t slow    = api::open_session("slow", nullptr, 1024);
+  const uint8_t limited = api::open_session("limited", nullptr, 4096);
+  expect(fast != session::NONE && slow != session::NONE && limited != session::NONE, "open");
+  expect(api::open_session("extra", nullptr) == session::NONE, "Slot-Limit");
+
+  cmd(fast, "sub bench.a.*");
+  expect(s_fast_evt == 1 && s_fast_b == 0, "Replay nur an die abonnierende Session");
+  cmd(slow, "sub bench.*");
+  cmd(limited, "sub bench.a.*");
+  cmd(limited, "set session.rate value=100");
+  expect(s_console_evt == 0, "Replay fremder Sessions an der Konsole");
+
+  // Fremde Abo-IDs sind tabu
+  cmd(fast, "unsub 999999");
+  expect(s_fast_last.startsWith("err code=E_UNKNOWN"), "unsub fremde ID");
+
+  s_fast_evt = 0;
+  const double fan = emit_ns(N, p);
+
+  session::Info fi, si, li;
+  session::info(fast, fi); session::info(slow, si); session::info(limited, li);
+  expect(s_fast_evt == N / 2 && s_fast_b == 0, "fast: genau die a-Events");
+  expect(si.events == N + 2 && si.dropped_full > 0 && si.depth <= si.cap, "slow: Ring voll, Rest verworfen");
+  expect(li.dropped_rate > 0 && li.events < N / 2, "limited: Rate-Limit greift");
+  expect(s_console_evt == 0, "console: keine Events");
+
+  // Ring lesen: Replay (2 Stickies), dann die Antwort
+  char buf[256]; size_t n = 0;
+  expect(session::read_line(slow, buf, sizeof(buf), &n) && n > 10 && !memcmp(buf, "evt bench.", 10), "slow: Replay im Ring");
+  session::read_line(slow, buf, sizeof(buf), &n);
+  expect(session::read_line(slow, buf, sizeof(buf), &n) && n > 6 && !memcmp(buf, "ok sub", 6), "slow: Antwort im Ring");
+
+  // Session schließen → Abos weg, keine Zustellung mehr
+  api::close_session(slow);
+  expect(!session::valid(slow), "close");
+  const double closed = emit_ns(N, p);
+  session::info(fast, fi);
+  expect(s_fast_evt == N && fi.events == N + 1, "fast nach close");
+
+  printf("%-28s %10.1f ns/emit\n", "console only (no subs)", base);
+  printf("%-28s %10.1f ns/emit\n", "fast+slow+limited", fan);
+  printf("%-28s %10.1f ns/emit\n", "fast+limited (slow closed)", closed);
+  printf("fast: events=%u lines=%u\n", (unsigned)fi.events, (unsigned)fi.lines);
+  printf("slow: events=%u dropped_full=%u high_water=%u cap=%u\n",
+         (unsigned)si.events, (unsigned)si.dropped_full, (unsigned)si.high_water, (unsigned)si.cap);
+  printf("limited: events=%u dropped_rate=%u\n", (unsigned)li.events, (unsigned)li.dropped_rate);
+  printf("console: lines=%u evt=%u\n", (unsigned)s_console_lines, (unsigned)s_console_evt);
+  printf(fails ? "FAIL (%d)\n" : "PASS\n", fails);
+  return fails ? 1 : 0;
+}
@@ -0,0 +1,66 @@
+// Host-Benchmark: Sticky-Store von bus::emit_sticky / bus::get_sticky.
+// Füllt den Store mit N Topics und misst danach Update- und Lookup-Kosten
+// über zufällige, bereits vorhandene Topics. Erwartung: ns/op bleibt flach.
+// Insert läuft über den Namen (Interning wie bei INI/Konsole), Update/Lookup
+// über die Topic-ID (interner Pfad); "lookup str" zum Vergleich per Name.
+// Internierte Namen bleiben über alle Größen stehen: die größte Stufe ist auf
+// den freien Rest von TOPIC_MAX begrenzt (registrierte Topics zählen mit).
+
+#include <Arduino.h>
+#include "core/bus.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+static double ns_per_op(std::chrono::steady_clock::time_point t0, size_t ops) {
+  auto dt = std::chrono::steady_clock::now() - t0;
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count() / (double)ops;
+}
+
+int main() {
+  static const size_t SIZES[] = { 16, 64, 256, 1024, 4096, 16384 };
+  static const size_t OPS = 200000;
+  const size_t room = bus::TOPIC_MAX - bus::topic_count();
+
+  printf("%8s %14s %14s %14s %14s\n", "stickies", "insert ns/op", "update ns/op", "lookup ns/op", "lookup str");
+  for (size_t n : SIZES) {
+    if (n > room) n = room;
+    std::vector<String> topics;
+    topics.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      topics.push_back(String("bench.section") + String((unsigned)(i % 97)) + ".key" + String((unsigned)i));
+
+    std::mt19937 rng(42);
+    std::vector<uint32_t> pick(OPS);
+    for (auto& p : pick) p = rng() % n;
+
+    const bus::Payload kv = bus::Payload().set(bus::k::value, 65);
+    bus::init(nullptr);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) bus::emit_sticky(topics[i], kv);
+    double ins = ns_per_op(t0, n);
+
+    std::vector<bus::topic_t> ids(n);
+    for (size_t i = 0; i < n; ++i) ids[i] = bus::find_topic(topics[i].c_str(), topics[i].length());
+
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPS; ++i) bus::emit_sticky(ids[pick[i]], kv);
+    double upd = ns_per_op(t0, OPS);
+
+    bus::Payload out; size_t hit = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPS; ++i) hit += bus::get_sticky(ids[pick[i]], out) ? 1 : 0;
+    double get = ns_per_op(t0, OPS);
+
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPS; ++i) hit += bus::get_sticky(topics[pick[i]], out) ? 1 : 0;
+    double get_str = ns_per_op(t0, OPS);
+
+    if (hit != 2 * OPS || bus::sticky_count() != n) { printf("FAIL n=%zu hit=%zu\n", n, hit); return 1; }
+    printf("%8zu %14.1f %14.1f %14.1f %14.1f\n", n, ins, upd, get, get_str);
+    if (n == room) break;
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Standalone-Treiber für fuzz_parser ohne libFuzzer (GCC, kein -fsanitize=fuzzer).
+// Spielt den Korpus ab und mutiert ihn danach deterministisch (xorshift, fester
+// Seed) → gleicher Lauf auf jedem Rechner, Abbruch über abort()/Sanitizer.
+//   fuzz_parser [-runs=N] [-seed=S] [-max_len=N] <datei|verzeichnis>…
+// Mutationen: Byte kippen/einfügen/löschen, Wörterbuch-Token einfügen,
+// Stück aus einem anderen Korpus-Eintrag einspleißen, Pfad-Byte wechseln.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv);
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+using Input = std::vector<uint8_t>;
+
+static const char* const DICT[] = {
+  "get ", "set ", "do ", "info ", "sub ", "unsub ", "emit ", "ping", "help ", "batch ",
+  "begin", "end", "abort", " id=", " value=", " fields=", " since=", " quiet=1",
+  "ui.brightness", "power.*", "trace.*", "api.quiet", "console.rx.idle_flush_ms",
+  "config.save", "config.reload", "display.cal", "console mode=bin", "mode=text", "console announce", "session.monitor", "session.rate",
+  "session", "config.schema", "boot", " prev=1", "backlight.gamma", "console.policy.evt", "*", ".", "=", "\"", "\\\"", "\\", ";", " ", "\n",
+  "0x", "4294967296", "-1", "on", "off", "deadbeef:", "0:",
+};
+static const size_t NDICT = sizeof(DICT) / sizeof(DICT[0]);
+
+static uint64_t s_rng = 0x9E3779B97F4A7C15ull;
+static uint32_t rnd() {
+  s_rng ^= s_rng << 13; s_rng ^= s_rng >> 7; s_rng ^= s_rng << 17;
+  return (uint32_t)(s_rng >> 16);
+}
+static size_t below(size_t n) { return n ? rnd() % n : 0; }
+
+static bool load(const stdfs::path& p, std::vector<Input>& out) {
+  std::ifstream f(p, std::ios::binary);
+  if (!f) return false;
+  out.emplace_back(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+  return true;
+}
+
+static void mutate(Input& in, const std::vector<Input>& corpus, size_t max_len) {
+  const int steps = 1 + (int)below(4);
+  for (int s = 0; s < steps; ++s) {
+    switch (below(6)) {
+      case 0:
+        if (in.size() > 1) in[1 + below(in.size() - 1)] ^= (uint8_t)(1u << below(8));
+        break;
+      case 1:
+        in.insert(in.begin() + 1 + below(in.size()), (uint8_t)rnd());
+        break;
+      case 2:
+        if (in.size() > 1) {
+          const size_t a = 1 + below(in.size() - 1);
+          const size_t n = 1 + below(in.size() - a < 8 ? in.size() - a : 8);
+          in.erase(in.begin() + a, in.begin() + a + n);
+        }
+        break;
+      case 3: {
+        const char* d = DICT[below(NDICT)];
+        in.insert(in.begin() + 1 + below(in.size()), d, d + strlen(d));
+        break;
+      }
+      case 4: {
+        const Input& o = corpus[below(corpus.size())];
+        if (o.size() > 1) {
+          const size_t a = 1 + below(o.size() - 1);
+          const size_t n = 1 + below(o.size() - a);
+          in.insert(in.begin() + 1 + below(in.size()), o.begin() + a, o.begin() + a + n);
+        }
+        break;
+      }
+      default:
+        in[0] ^= 1;
+        break;
+    }
+  }
+  if (in.size() > max_len) in.resize(max_len);
+}
+
+int main(int argc, char** argv) {
+  unsigned long runs = 20000, max_len = 512;
+  std::vector<Input> corpus;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if (!strncmp(a, "-runs=", 6))         runs = strtoul(a + 6, nullptr, 10);
+    else if (!strncmp(a, "-seed=", 6))   s_rng = strtoull(a + 6, nullptr, 10) << 1 | 1;
+    else if (!strncmp(a, "-max_len=", 9)) max_len = strtoul(a + 9, nullptr, 10);
+    else if (stdfs::is_directory(a)) {
+      std::vector<stdfs::path> files;
+      for (const auto& e : stdfs::directory_iterator(a)) if (e.is_regular_file()) files.push_back(e.path());
+      std::sort(files.begin(), files.end());        // Reihenfolge fest → reproduzierbar
+      for (const auto& p : files) load(p, corpus);
+    } else if (!load(a, corpus)) {
+      fprintf(stderr, "fuzz_parser: cannot read %s\n", a);
+      return 2;
+    }
+  }
+  if (max_len < 2) max_len = 2;
+  if (corpus.empty()) corpus.push_back({ 0, 'p', 'i', 'n', 'g' });
+
+  LLVMFuzzerInitialize(&argc, &argv);
+  for (const Input& in : corpus) LLVMFuzzerTestOneInput(in.data(), in.size());
+
+  size_t bytes = 0;
+  for (unsigned long r = 0; r < runs; ++r) {
+    Input in = corpus[below(corpus.size())];
+    if (in.empty()) in.push_back(0);
+    mutate(in, corpus, max_len);
+    bytes += in.size();
+    LLVMFuzzerTestOneInput(in.data(), in.size());
+  }
+  printf("fuzz_parser: corpus=%zu runs=%lu bytes=%zu ok\n", corpus.size(), runs, bytes);
+  return 0;
+}
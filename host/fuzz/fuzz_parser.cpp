@@ -0,0 +1,128 @@
+// Host-Fuzz-Target: Konsolen-Parser (api_tokenizer, api_routes, api::handleLine)
+// plus Zeilen-Assembler der Konsole (console::rx_feed/read_line).
+// libFuzzer-Einstieg (LLVMFuzzerTestOneInput); ohne Clang/libFuzzer baut host/
+// den Treiber fuzz_driver.cpp dazu (Korpus abspielen + deterministische Mutation).
+//
+// Umgebung:
+//   Sink     – zählt Antwortzeilen und prüft deren Form ("ok …", "err …", "evt …", "help …", "session …", "config.schema …", "boot …")
+//   Config   – LittleFS-Wurzel in einem Temp-Verzeichnis mit Minimal-dev.ini,
+//              do config.save schreibt dorthin, nie nach data/
+//   Services – bewusst nicht gestartet: kein Deep-Sleep/Restart (exit) aus dem Fuzzer
+//
+// Eingabe: Byte 0 wählt den Pfad (Bit 0: 0 = Zeilen direkt an handleLine,
+// 1 = Bytes in Stücken durch den RX-Assembler), Rest sind Konsolenbytes.
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "host_shim.h"
+#include "core/bus.hpp"
+#include "core/console.hpp"
+#include "core/api_parser.hpp"
+#include "services/service_config.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace stdfs = std::filesystem;
+
+static const uint32_t RESET_EVERY = 1024;     // Bus/Abos/Topics regelmäßig neu aufsetzen
+static const size_t   RX_CHUNK    = 64;       // ≤ Ring/2: Assembler blockiert nie
+
+static uint32_t s_inputs = 0;
+static size_t   s_lines  = 0;
+
+// Topic-Namen bleiben absichtlich für immer interniert (bus::intern); beim
+// Prozessende zerstört die statische Tabelle nur den Vektor → kein Leck-Bericht.
+extern "C" const char* __asan_default_options() { return "detect_leaks=0"; }
+
+static void fail(const char* what, const String& line) {
+  fprintf(stderr, "fuzz_parser: %s: \"%s\"\n", what, line.c_str());
+  abort();
+}
+
+// Jede Antwort ist eine Zeile mit bekanntem Präfix; Zeilenumbrüche würden das
+// Konsolenprotokoll brechen (Host-Tools lesen zeilenweise).
+static void sink(const String& line) {
+  ++s_lines;
+  const char* s = line.c_str();
+  if (strncmp(s, "ok", 2) != 0 && strncmp(s, "err ", 4) != 0 && strncmp(s, "evt ", 4) != 0 &&
+      strncmp(s, "help ", 5) != 0 && strncmp(s, "session ", 8) != 0 &&
+      strncmp(s, "config.schema ", 14) != 0 && strncmp(s, "boot ", 5) != 0) {
+    fail("unexpected response", line);
+  }
+  if (strchr(s, '\n') || strchr(s, '\r')) fail("newline in response", line);
+}
+
+static void bus_out(const String& line) { sink(line); }
+
+static void setup_env() {
+  bus::init(bus_out);
+  config::init();
+  api::init(sink);
+}
+
+static stdfs::path s_root;
+
+static void fs_root() {
+  s_root = stdfs::temp_directory_path() / ("twatch_fuzz_" + std::to_string(getpid()));
+  const stdfs::path& root = s_root;
+  stdfs::remove_all(root);
+  atexit([] { std::error_code ec; stdfs::remove_all(s_root, ec); });
+  stdfs::create_directories(root / "config");
+  std::ofstream(root / "config" / "dev.ini")
+    << "[ui]\nbrightness = 50\n[backlight]\ngamma = 2.2\n[console.rx]\nidle_flush_ms = 0\n";
+  host::fs_set_root(root.string());
+  LittleFS.begin(false);
+}
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+  fs_root();
+  Serial.host_mute(true);
+  setup_env();
+  return 0;
+}
+
+static void drain_rx() {
+  char line[CONSOLE_LINE_MAX];
+  size_t n = 0;
+  bool overlong = false;
+  while (console::read_line(line, sizeof(line), &n, &overlong)) {
+    if (!overlong) api::handleLine(line, n);
+  }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  if (!size) return 0;
+  const bool via_rx = data[0] & 1;
+  const char* s = (const char*)data + 1;
+  const size_t n = size - 1;
+
+  if (via_rx) {
+    for (size_t a = 0; a < n; a += RX_CHUNK) {
+      console::rx_feed(s + a, n - a < RX_CHUNK ? n - a : RX_CHUNK);
+      drain_rx();
+    }
+    console::rx_feed("\n", 1);                 // angefangene Zeile abschließen
+    drain_rx();
+  } else {
+    size_t a = 0;
+    for (size_t i = 0; i <= n; ++i) {
+      if (i < n && s[i] != '\n') continue;
+      api::handleLine(s + a, i - a);
+      a = i + 1;
+    }
+  }
+
+  // Zustand zwischen Eingaben zurücksetzen (offener Batch, quiet, Ausgabemodus, Session, Konsolen-Abos)
+  api::handleLine("batch abort", 11);
+  api::handleLine("console mode=text", 17);
+  api::handleLine("set api.quiet value=off", 23);
+  api::handleLine("set session.monitor value=on", 28);
+  api::handleLine("set session.rate value=0", 24);
+  api::handleLine("unsub *", 7);
+  if (++s_inputs % RESET_EVERY == 0) setup_env();
+  return 0;
+}
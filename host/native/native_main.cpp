@@ -0,0 +1,38 @@
+// Host: Firmware-Hauptschleife (setup/loop aus src/main.cpp) gegen den Shim.
+// stdin → Serial-RX, Ausgabe über den echten Konsolenpfad auf stdout.
+//   ./twatch_native [fs-root]        (fs-root: Kopie von data/, wird beschrieben)
+//   printf 'ping\ninfo bus\n' | ./twatch_native /tmp/fs
+
+#include <Arduino.h>
+#include "host_shim.h"
+#include "core/console.hpp"
+
+#include <poll.h>
+#include <unistd.h>
+
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+  if (argc > 1) host::fs_set_root(argv[1]);
+  setup();
+
+  bool eof = false;
+  unsigned long eof_at = 0;
+  for (;;) {
+    if (!eof) {
+      pollfd pfd{ STDIN_FILENO, POLLIN, 0 };
+      if (poll(&pfd, 1, 0) > 0) {
+        char buf[256];
+        const ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+        if (n > 0) Serial.host_feed(buf, (size_t)n);
+        else { eof = true; eof_at = millis(); }
+      }
+    }
+    loop();
+    // Nach EOF noch kurz weiterlaufen (Idle-Flush, Deferred-Queue), dann Ausgabe leeren
+    if (eof && millis() - eof_at > 500) break;
+  }
+  console::flush(1000);
+  return 0;
+}
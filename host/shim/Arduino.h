@@ -0,0 +1,192 @@
+// Host-Shim: minimales Arduino-API für Builds/Benchmarks auf dem Entwickler-PC.
+// Nur das, was src/ tatsächlich benutzt (String, Zeit, GPIO, LEDC, Serial, ESP).
+// Kein Ersatz für das echte Framework – Semantik so nah wie nötig am ESP32-Core.
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <string>
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+// ---------------------------------------------------------------------------
+// String (Arduino WString-kompatibel, intern std::string)
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const char* s, size_t n) : _s(s ? s : "", s ? n : 0) {}
+  String(const String& o) = default;
+  String(String&& o) noexcept = default;
+  explicit String(char c) : _s(1, c) {}
+  String(int v, unsigned char base = 10)           { from_signed(v, base); }
+  String(long v, unsigned char base = 10)          { from_signed(v, base); }
+  String(long long v, unsigned char base = 10)     { from_signed(v, base); }
+  String(unsigned char v, unsigned char base = 10) { from_unsigned(v, base); }
+  String(unsigned v, unsigned char base = 10)      { from_unsigned(v, base); }
+  String(unsigned long v, unsigned char base = 10) { from_unsigned(v, base); }
+  String(unsigned long long v, unsigned char base = 10) { from_unsigned(v, base); }
+  String(float v, unsigned char decimals = 2)  { from_double(v, decimals); }
+  String(double v, unsigned char decimals = 2) { from_double(v, decimals); }
+
+  String& operator=(const String& o) = default;
+  String& operator=(String&& o) noexcept = default;
+  String& operator=(const char* s) { _s = s ? s : ""; return *this; }
+
+  unsigned int length() const { return (unsigned)_s.size(); }
+  const char*  c_str()  const { return _s.c_str(); }
+  bool reserve(unsigned int n) { _s.reserve(n); return true; }
+
+  char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char& operator[](unsigned int i) { return _s[i]; }
+
+  // concat / +=
+  bool concat(const String& o) { _s += o._s; return true; }
+  bool concat(const char* s)   { if (s) _s += s; return true; }
+  bool concat(const char* s, size_t n) { if (s) _s.append(s, n); return true; }
+  bool concat(char c)          { _s += c; return true; }
+  template <typename T> bool concat(T v) { return concat(String(v)); }
+  template <typename T> String& operator+=(const T& v) { concat(v); return *this; }
+
+  // Vergleiche
+  bool equals(const String& o) const { return _s == o._s; }
+  bool equals(const char* s) const { return _s == (s ? s : ""); }
+  bool operator==(const String& o) const { return equals(o); }
+  bool operator==(const char* s) const { return equals(s); }
+  bool operator!=(const String& o) const { return !equals(o); }
+  bool operator!=(const char* s) const { return !equals(s); }
+  bool operator<(const String& o) const { return _s < o._s; }
+  bool equalsIgnoreCase(const String& o) const {
+    if (_s.size() != o._s.size()) return false;
+    for (size_t i = 0; i < _s.size(); ++i)
+      if (tolower((unsigned char)_s[i]) != tolower((unsigned char)o._s[i])) return false;
+    return true;
+  }
+
+  bool startsWith(const String& p) const { return _s.compare(0, p._s.size(), p._s) == 0 && _s.size() >= p._s.size(); }
+  bool startsWith(const String& p, unsigned int off) const {
+    return off <= _s.size() && _s.compare(off, p._s.size(), p._s) == 0 && _s.size() - off >= p._s.size();
+  }
+  bool endsWith(const String& p) const {
+    return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+  }
+
+  // Suche
+  int indexOf(char c, unsigned int from = 0) const { return pos(_s.find(c, from)); }
+  int indexOf(const String& s, unsigned int from = 0) const { return pos(_s.find(s._s, from)); }
+  int indexOf(const char* s, unsigned int from = 0) const { return pos(_s.find(s ? s : "", from)); }
+  int lastIndexOf(char c) const { return pos(_s.rfind(c)); }
+
+  String substring(unsigned int from) const { return from >= _s.size() ? String() : String(_s.c_str() + from); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) { unsigned t = from; from = to; to = t; }
+    if (from >= _s.size()) return String();
+    if (to > _s.size()) to = (unsigned)_s.size();
+    return String(_s.c_str() + from, to - from);
+  }
+
+  // Modifikation
+  void trim() {
+    size_t b = 0, e = _s.size();
+    while (b < e && isspace((unsigned char)_s[b])) ++b;
+    while (e > b && isspace((unsigned char)_s[e - 1])) --e;
+    _s = _s.substr(b, e - b);
+  }
+  void toLowerCase() { for (auto& c : _s) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (auto& c : _s) c = (char)toupper((unsigned char)c); }
+  void remove(unsigned int idx) { if (idx < _s.size()) _s.erase(idx); }
+  void remove(unsigned int idx, unsigned int n) { if (idx < _s.size()) _s.erase(idx, n); }
+  void replace(const String& a, const String& b) {
+    if (a._s.empty()) return;
+    size_t p = 0;
+    while ((p = _s.find(a._s, p)) != std::string::npos) { _s.replace(p, a._s.size(), b._s); p += b._s.size(); }
+  }
+
+  // Konvertierung
+  long  toInt()   const { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return (float)strtod(_s.c_str(), nullptr); }
+
+private:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void from_unsigned(unsigned long long v, unsigned char base) {
+    char buf[72]; char* p = buf + sizeof(buf) - 1; *p = 0;
+    if (base < 2) base = 10;
+    do { unsigned d = (unsigned)(v % base); *--p = (char)(d < 10 ? '0' + d : 'a' + d - 10); v /= base; } while (v);
+    _s = p;
+  }
+  void from_signed(long long v, unsigned char base) {
+    if (base == 10 && v < 0) { from_unsigned((unsigned long long)(-(v + 1)) + 1, 10); _s.insert(0, 1, '-'); }
+    else if (base == 10) from_unsigned((unsigned long long)v, 10);
+    else from_unsigned((unsigned long long)(unsigned long)v, base);
+  }
+  void from_double(double v, unsigned char decimals) {
+    char buf[48]; snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v); _s = buf;
+  }
+
+  std::string _s;
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b)   { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b)   { String r(a); r += b; return r; }
+inline String operator+(const String& a, char c)          { String r(a); r += c; return r; }
+template <typename T> inline String operator+(const String& a, T v) { String r(a); r += String(v); return r; }
+inline bool operator==(const char* a, const String& b) { return b == a; }
+
+// ---------------------------------------------------------------------------
+// Zeit
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// ---------------------------------------------------------------------------
+// GPIO / Interrupts (Pegel im Shim setzbar, siehe host_shim.h)
+#define LOW     0x0
+#define HIGH    0x1
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+// LEDC (PWM) – Aufrufe werden aufgezeichnet
+uint32_t ledcSetup(uint8_t chan, uint32_t freq, uint8_t bits);
+void     ledcAttachPin(uint8_t pin, uint8_t chan);
+void     ledcWrite(uint8_t chan, uint32_t duty);
+
+// ---------------------------------------------------------------------------
+// ESP-Systemfunktionen
+class EspClass {
+public:
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  void     restart();
+};
+extern EspClass ESP;
+uint32_t esp_random();   // IDF: Hardware-RNG (esp_system.h)
+
+// Wie beim ESP32-Core: Arduino.h zieht IDF-/FreeRTOS-Basisheader mit
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "Print.h"
+#include "HardwareSerial.h"
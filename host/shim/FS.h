@@ -0,0 +1,53 @@
+// Host-Shim: FS/File über ein Host-Verzeichnis
+#pragma once
+#include "Arduino.h"
+#include <memory>
+
+namespace fs {
+
+struct FileImpl;
+
+class File : public Stream {
+public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> p) : _p(std::move(p)) {}
+
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int    available() override;
+  int    read() override;
+  int    peek() override;
+  size_t read(uint8_t* buf, size_t n);
+  void   flush() override;
+  bool   seek(uint32_t pos);
+  size_t position() const;
+  size_t size() const;
+  void   close();
+  operator bool() const;
+
+  bool        isDirectory() const;
+  const char* path() const;
+  const char* name() const;
+  File        openNextFile();
+  time_t      getLastWrite();
+
+private:
+  std::shared_ptr<FileImpl> _p;
+};
+
+class FS {
+public:
+  File open(const char* path, const char* mode = "r", bool create = false);
+  File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+  bool exists(const char* path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path);
+  bool rename(const char* from, const char* to);
+  bool mkdir(const char* path);
+  bool rmdir(const char* path);
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
@@ -0,0 +1,41 @@
+// Host-Shim: Serial → stdout (TX) / programmierbarer RX-Puffer
+#pragma once
+#include "Print.h"
+#include <functional>
+#include <mutex>
+#include <string>
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long /*baud*/) {}
+  void end() {}
+  operator bool() const { return true; }
+
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  // RX ist thread-sicher (RX-Task liest, Host-Thread speist ein)
+  int    available() override { std::lock_guard<std::mutex> lk(_mu); return (int)(_rx.size() - _rx_pos); }
+  int    read() override { std::lock_guard<std::mutex> lk(_mu); return _rx_pos < _rx.size() ? (uint8_t)_rx[_rx_pos++] : -1; }
+  int    peek() override { std::lock_guard<std::mutex> lk(_mu); return _rx_pos < _rx.size() ? (uint8_t)_rx[_rx_pos] : -1; }
+  int    availableForWrite() { return 4096; }
+  void   setTxTimeoutMs(uint32_t) {}
+  void   onReceive(std::function<void()> cb, bool /*onlyOnTimeout*/ = false) { _on_rx = cb; }
+
+  // Shim-only: Eingabe einspeisen / Ausgabe umleiten
+  void   host_feed(const char* s, size_t n) {
+    { std::lock_guard<std::mutex> lk(_mu); _rx.append(s, n); }
+    if (_on_rx) _on_rx();
+  }
+  void   host_capture(std::string* sink) { _cap = sink; }
+  void   host_mute(bool on) { _mute = on; }
+
+private:
+  std::mutex   _mu;
+  std::function<void()> _on_rx;
+  std::string  _rx;
+  size_t       _rx_pos = 0;
+  std::string* _cap = nullptr;
+  bool         _mute = false;
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,18 @@
+// Host-Shim: LittleFS → Verzeichnis $TWATCH_FS_ROOT (Default: ./littlefs)
+#pragma once
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+             uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+  void end() {}
+  size_t totalBytes() { return 0x5F0000; }
+  size_t usedBytes()  { return 0; }
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
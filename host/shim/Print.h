@@ -0,0 +1,56 @@
+// Host-Shim: Print/Stream (Arduino-kompatible Teilmenge)
+#pragma once
+#include "Arduino.h"
+#include <stdarg.h>
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t* buf, size_t n) = 0;
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(const char* s)   { return write(s); }
+  size_t print(char c)          { return write((uint8_t)c); }
+  template <typename T> size_t print(T v) { return print(String(v)); }
+  size_t print(unsigned v, int base) { return print(String(v, (unsigned char)base)); }
+
+  size_t println() { return write("\n"); }
+  template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char tmp[256];
+    va_list ap; va_start(ap, fmt);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n < 0) return 0;
+    if ((size_t)n >= sizeof(tmp)) n = sizeof(tmp) - 1;
+    return write((const uint8_t*)tmp, (size_t)n);
+  }
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+
+  String readStringUntil(char term) {
+    String s;
+    for (int c; (c = read()) >= 0 && c != term;) s += (char)c;
+    return s;
+  }
+  String readString() {
+    String s;
+    for (int c; (c = read()) >= 0;) s += (char)c;
+    return s;
+  }
+  size_t readBytes(uint8_t* buf, size_t n) {
+    size_t i = 0;
+    for (int c; i < n && (c = read()) >= 0;) buf[i++] = (uint8_t)c;
+    return i;
+  }
+  size_t readBytes(char* buf, size_t n) { return readBytes((uint8_t*)buf, n); }
+};
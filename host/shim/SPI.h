@@ -0,0 +1,31 @@
+// Host-Shim: SPI – zeichnet Transaktionen auf (host_shim.h)
+#pragma once
+#include "Arduino.h"
+
+#define FSPI 0
+#define HSPI 1
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+class SPISettings {
+public:
+  SPISettings(uint32_t hz = 1000000, uint8_t order = MSBFIRST, uint8_t mode = SPI_MODE0)
+  : hz(hz), order(order), mode(mode) {}
+  uint32_t hz; uint8_t order; uint8_t mode;
+};
+
+class SPIClass {
+public:
+  explicit SPIClass(uint8_t bus = FSPI) : _bus(bus) {}
+  void    begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1);
+  void    end();
+  void    beginTransaction(const SPISettings& s);
+  void    endTransaction();
+  uint8_t transfer(uint8_t b);
+  void    transfer(void* buf, uint32_t n);
+  void    writeBytes(const uint8_t* buf, uint32_t n);
+private:
+  uint8_t _bus;
+};
+
+extern SPIClass SPI;
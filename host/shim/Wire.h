@@ -0,0 +1,30 @@
+// Host-Shim: I2C – zeichnet Zugriffe auf, Geräte-Register per host_i2c_* (host_shim.h)
+#pragma once
+#include "Arduino.h"
+
+class TwoWire : public Stream {
+public:
+  explicit TwoWire(uint8_t bus = 0) : _bus(bus) {}
+  bool    begin(int sda = -1, int scl = -1, uint32_t freq = 0);
+  bool    setClock(uint32_t hz);
+  void    beginTransmission(uint8_t addr);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(int addr, int n, int sendStop = 1);
+
+  size_t  write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int     available() override;
+  int     read() override;
+
+private:
+  uint8_t  _bus;
+  uint8_t  _addr = 0;
+  uint8_t  _tx[32];
+  size_t   _tx_n = 0;
+  uint8_t  _rx[32];
+  size_t   _rx_n = 0, _rx_pos = 0;
+  uint8_t  _reg = 0;   // Registerzeiger (zuletzt geschriebenes erstes Byte)
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
@@ -0,0 +1,81 @@
+// Host-Shim: Zeitbasis, GPIO, LEDC, ESP, Serial
+
+#include "Arduino.h"
+#include "host_shim.h"
+#include <chrono>
+#include <thread>
+#include <map>
+#include <random>
+
+static const auto s_t0 = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::steady_clock::now() - s_t0).count();
+}
+
+unsigned long micros() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now() - s_t0).count();
+}
+
+void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+// ----- GPIO -----
+struct Pin { int level = HIGH; void (*isr)(void) = nullptr; int mode = 0; };
+static std::map<uint8_t, Pin> s_pins;
+
+void pinMode(uint8_t pin, uint8_t mode) { s_pins[pin].mode = mode; }
+void digitalWrite(uint8_t pin, uint8_t val) { s_pins[pin].level = val ? HIGH : LOW; }
+int  digitalRead(uint8_t pin) { return s_pins[pin].level; }
+void attachInterrupt(uint8_t pin, void (*isr)(void), int /*mode*/) { s_pins[pin].isr = isr; }
+void detachInterrupt(uint8_t pin) { s_pins[pin].isr = nullptr; }
+
+namespace host {
+void gpio_set_input(uint8_t pin, int level) {
+  Pin& p = s_pins[pin];
+  const bool edge = p.level != level;
+  p.level = level;
+  if (edge && p.isr) p.isr();
+}
+} // namespace host
+
+// ----- LEDC -----
+uint32_t ledcSetup(uint8_t, uint32_t freq, uint8_t bits) {
+  auto& l = host::periph();
+  ++l.ledc_setups; l.ledc_last_hz = freq; l.ledc_last_bits = bits;
+  return freq;
+}
+void ledcAttachPin(uint8_t, uint8_t) {}
+void ledcWrite(uint8_t, uint32_t duty) {
+  auto& l = host::periph();
+  ++l.ledc_writes; l.ledc_last_duty = duty;
+}
+
+// ----- ESP -----
+EspClass ESP;
+uint32_t esp_random() {
+  static std::mt19937 rng{ std::random_device{}() };
+  return (uint32_t)rng();
+}
+uint32_t EspClass::getFreeHeap()    { return 256 * 1024; }
+uint32_t EspClass::getMinFreeHeap() { return 200 * 1024; }
+void     EspClass::restart()        { exit(0); }
+
+// ----- Serial -----
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n) {
+  if (_cap) _cap->append((const char*)buf, n);
+  else if (!_mute) fwrite(buf, 1, n, stdout);
+  return n;
+}
+
+// ----- Heap-Zähler -----
+namespace host {
+static uint64_t s_alloc_count = 0, s_alloc_bytes = 0;
+void     heap_note_alloc(size_t n) { ++s_alloc_count; s_alloc_bytes += n; }
+uint64_t heap_alloc_count() { return s_alloc_count; }
+uint64_t heap_alloc_bytes() { return s_alloc_bytes; }
+} // namespace host
@@ -0,0 +1,27 @@
+// Host-Shim: GPIO-Treiber (ESP-IDF-Teilmenge)
+#pragma once
+#include "esp_err.h"
+
+typedef enum {
+  GPIO_NUM_NC = -1,
+  GPIO_NUM_9 = 9, GPIO_NUM_14 = 14, GPIO_NUM_16 = 16, GPIO_NUM_17 = 17, GPIO_NUM_21 = 21,
+  GPIO_NUM_MAX = 49,
+} gpio_num_t;
+
+typedef enum {
+  GPIO_INTR_DISABLE = 0, GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE, GPIO_INTR_ANYEDGE,
+  GPIO_INTR_LOW_LEVEL, GPIO_INTR_HIGH_LEVEL,
+} gpio_int_type_t;
+
+typedef enum { GPIO_MODE_INPUT = 1, GPIO_MODE_OUTPUT = 2 } gpio_mode_t;
+typedef enum { GPIO_PULLUP_ONLY, GPIO_PULLDOWN_ONLY, GPIO_PULLUP_PULLDOWN, GPIO_FLOATING } gpio_pull_mode_t;
+typedef void (*gpio_isr_t)(void*);
+
+int       gpio_get_level(gpio_num_t pin);
+esp_err_t gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t t);
+esp_err_t gpio_install_isr_service(int flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t isr, void* arg);
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t t);
+esp_err_t gpio_wakeup_disable(gpio_num_t pin);
+esp_err_t gpio_set_direction(gpio_num_t pin, gpio_mode_t m);
+esp_err_t gpio_set_pull_mode(gpio_num_t pin, gpio_pull_mode_t m);
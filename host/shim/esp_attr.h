@@ -0,0 +1,11 @@
+// Host-Shim: Attribute (IRAM/DRAM sind auf dem Host leer)
+#pragma once
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+#ifndef DRAM_ATTR
+#define DRAM_ATTR
+#endif
+#ifndef RTC_NOINIT_ATTR
+#define RTC_NOINIT_ATTR
+#endif
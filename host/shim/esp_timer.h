@@ -0,0 +1,4 @@
+// Host-Shim: esp_timer (µs seit Prozessstart, monoton)
+#pragma once
+#include <stdint.h>
+int64_t esp_timer_get_time();
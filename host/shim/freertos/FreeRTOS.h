@@ -0,0 +1,23 @@
+// Host-Shim: FreeRTOS-Teilmenge (Tasks = std::thread, Critical = Spinlock)
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portTICK_PERIOD_MS 1
+
+struct portMUX_TYPE { std::atomic<int> owner{0}; };
+#define portMUX_INITIALIZER_UNLOCKED {}
+void vPortEnterCritical(portMUX_TYPE* m);
+void vPortExitCritical(portMUX_TYPE* m);
+#define portENTER_CRITICAL(m)     vPortEnterCritical(m)
+#define portEXIT_CRITICAL(m)      vPortExitCritical(m)
+#define portENTER_CRITICAL_ISR(m) vPortEnterCritical(m)
+#define portEXIT_CRITICAL_ISR(m)  vPortExitCritical(m)
@@ -0,0 +1,15 @@
+// Host-Shim: Tasks als detached std::thread, Task-Notify über condition_variable
+#pragma once
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t   xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack,
+                                     void* arg, UBaseType_t prio, TaskHandle_t* out, BaseType_t core);
+void         vTaskDelay(TickType_t ticks);
+void         vTaskDelete(TaskHandle_t t);
+TickType_t   xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t   xTaskNotifyGive(TaskHandle_t t);
+uint32_t     ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
@@ -0,0 +1,113 @@
+// Host-Shim: LittleFS über ein Host-Verzeichnis (std::filesystem + stdio)
+
+#include "LittleFS.h"
+#include "host_shim.h"
+#include <filesystem>
+#include <algorithm>
+
+namespace stdfs = std::filesystem;
+
+fs::LittleFSFS LittleFS;
+
+namespace host {
+static std::string s_root;
+void fs_set_root(const std::string& dir) { s_root = dir; }
+std::string fs_root() {
+  if (s_root.empty()) {
+    const char* env = getenv("TWATCH_FS_ROOT");
+    s_root = env && *env ? env : "littlefs";
+  }
+  return s_root;
+}
+} // namespace host
+
+static std::string host_path(const char* p) {
+  std::string r = host::fs_root();
+  if (!p || *p != '/') r += '/';
+  return r + (p ? p : "");
+}
+
+namespace fs {
+
+struct FileImpl {
+  FILE*       fp = nullptr;
+  std::string path;                      // LittleFS-Pfad ("/config/dev.ini")
+  std::string name;
+  bool        dir = false;
+  std::vector<std::string> entries;      // bei Verzeichnissen
+  size_t      next = 0;
+  ~FileImpl() { if (fp) fclose(fp); }
+};
+
+size_t File::write(const uint8_t* buf, size_t n) { return (_p && _p->fp) ? fwrite(buf, 1, n, _p->fp) : 0; }
+int File::available() {
+  if (!_p || !_p->fp) return 0;
+  long pos = ftell(_p->fp); fseek(_p->fp, 0, SEEK_END);
+  long end = ftell(_p->fp); fseek(_p->fp, pos, SEEK_SET);
+  return (int)(end - pos);
+}
+int File::read() { if (!_p || !_p->fp) return -1; int c = fgetc(_p->fp); return c == EOF ? -1 : c; }
+int File::peek() { if (!_p || !_p->fp) return -1; int c = fgetc(_p->fp); if (c != EOF) ungetc(c, _p->fp); return c == EOF ? -1 : c; }
+size_t File::read(uint8_t* buf, size_t n) { return (_p && _p->fp) ? fread(buf, 1, n, _p->fp) : 0; }
+void File::flush() { if (_p && _p->fp) fflush(_p->fp); }
+bool File::seek(uint32_t pos) { return _p && _p->fp && fseek(_p->fp, (long)pos, SEEK_SET) == 0; }
+size_t File::position() const { return (_p && _p->fp) ? (size_t)ftell(_p->fp) : 0; }
+size_t File::size() const {
+  if (!_p || !_p->fp) return 0;
+  long pos = ftell(_p->fp); fseek(_p->fp, 0, SEEK_END);
+  long end = ftell(_p->fp); fseek(_p->fp, pos, SEEK_SET);
+  return (size_t)end;
+}
+void File::close() { _p.reset(); }
+File::operator bool() const { return _p && (_p->fp || _p->dir); }
+bool File::isDirectory() const { return _p && _p->dir; }
+const char* File::path() const { return _p ? _p->path.c_str() : ""; }
+const char* File::name() const { return _p ? _p->name.c_str() : ""; }
+
+File File::openNextFile() {
+  if (!_p || !_p->dir || _p->next >= _p->entries.size()) return File();
+  std::string child = _p->path == "/" ? "/" + _p->entries[_p->next++] : _p->path + "/" + _p->entries[_p->next++];
+  return LittleFS.open(child.c_str(), "r");
+}
+
+time_t File::getLastWrite() {
+  if (!_p) return 0;
+  std::error_code ec;
+  auto t = stdfs::last_write_time(host_path(_p->path.c_str()), ec);
+  if (ec) return 0;
+  return (time_t)std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
+File FS::open(const char* path, const char* mode, bool) {
+  const std::string hp = host_path(path);
+  auto impl = std::make_shared<FileImpl>();
+  impl->path = path ? path : "/";
+  impl->name = stdfs::path(impl->path).filename().string();
+  std::error_code ec;
+  if (stdfs::is_directory(hp, ec)) {
+    impl->dir = true;
+    for (auto& e : stdfs::directory_iterator(hp, ec)) impl->entries.push_back(e.path().filename().string());
+    std::sort(impl->entries.begin(), impl->entries.end());
+    return File(impl);
+  }
+  const char* m = (!mode || mode[0] == 'r') ? "rb" : (mode[0] == 'a' ? "ab+" : "wb+");
+  impl->fp = fopen(hp.c_str(), m);
+  if (!impl->fp) return File();
+  return File(impl);
+}
+
+bool FS::exists(const char* path) { std::error_code ec; return stdfs::exists(host_path(path), ec); }
+bool FS::remove(const char* path) { std::error_code ec; return stdfs::remove(host_path(path), ec); }
+bool FS::rename(const char* from, const char* to) {
+  std::error_code ec; stdfs::rename(host_path(from), host_path(to), ec); return !ec;
+}
+bool FS::mkdir(const char* path) { std::error_code ec; return stdfs::create_directory(host_path(path), ec); }
+bool FS::rmdir(const char* path) { std::error_code ec; return stdfs::remove(host_path(path), ec); }
+
+bool LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+  std::error_code ec;
+  stdfs::create_directories(host::fs_root(), ec);
+  return stdfs::is_directory(host::fs_root(), ec);
+}
+
+} // namespace fs
@@ -0,0 +1,42 @@
+// Host-Shim: Test-/Benchmark-Hooks (nur Host, nie im Firmware-Code benutzen)
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace host {
+
+// Dateisystem: Wurzelverzeichnis für LittleFS (Default $TWATCH_FS_ROOT oder ./littlefs)
+void        fs_set_root(const std::string& dir);
+std::string fs_root();
+
+// GPIO: Eingangspegel setzen; Flanke löst registrierte ISRs aus
+void gpio_set_input(uint8_t pin, int level);
+
+// Aufzeichnungen der Peripherie-Fakes
+struct PeriphLog {
+  uint64_t spi_transactions = 0;
+  uint64_t spi_bytes        = 0;
+  uint64_t i2c_writes       = 0;
+  uint64_t i2c_reads        = 0;
+  uint32_t ledc_setups      = 0;
+  uint32_t ledc_writes      = 0;
+  uint32_t ledc_last_duty   = 0;
+  uint32_t ledc_last_hz     = 0;
+  uint8_t  ledc_last_bits   = 0;
+};
+PeriphLog& periph();
+void       periph_reset();
+
+// I2C-Geräte: 256 Register je 7-Bit-Adresse; nicht angelegte Adressen NACKen
+void    i2c_add_device(uint8_t addr);
+void    i2c_set_reg(uint8_t addr, uint8_t reg, uint8_t val);
+uint8_t i2c_get_reg(uint8_t addr, uint8_t reg);
+
+// Heap-Statistik (Benchmarks ersetzen operator new und melden hier)
+void     heap_note_alloc(size_t n);
+uint64_t heap_alloc_count();
+uint64_t heap_alloc_bytes();
+
+} // namespace host
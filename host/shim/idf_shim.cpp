@@ -0,0 +1,88 @@
+// Host-Shim: ESP-IDF-Teilmenge (GPIO, Sleep, Timer, FreeRTOS)
+
+#include "Arduino.h"
+#include "esp_timer.h"
+#include "esp_sleep.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+int64_t esp_timer_get_time() { return (int64_t)micros(); }
+
+// ----- GPIO -----
+int       gpio_get_level(gpio_num_t pin) { return digitalRead((uint8_t)pin); }
+esp_err_t gpio_set_intr_type(gpio_num_t, gpio_int_type_t) { return ESP_OK; }
+esp_err_t gpio_install_isr_service(int) { return ESP_OK; }
+esp_err_t gpio_isr_handler_add(gpio_num_t, gpio_isr_t, void*) { return ESP_OK; }
+esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return ESP_OK; }
+esp_err_t gpio_wakeup_disable(gpio_num_t) { return ESP_OK; }
+esp_err_t gpio_set_direction(gpio_num_t, gpio_mode_t) { return ESP_OK; }
+esp_err_t gpio_set_pull_mode(gpio_num_t, gpio_pull_mode_t) { return ESP_OK; }
+
+// ----- Sleep -----
+static bool s_timer_armed = false;
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t) { s_timer_armed = true; return ESP_OK; }
+esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
+esp_err_t esp_light_sleep_start() { return ESP_OK; }
+void      esp_deep_sleep_start() { exit(0); }
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+  return s_timer_armed ? ESP_SLEEP_WAKEUP_TIMER : ESP_SLEEP_WAKEUP_GPIO;
+}
+
+// ----- FreeRTOS -----
+void vPortEnterCritical(portMUX_TYPE* m) {
+  int expect = 0;
+  while (!m->owner.compare_exchange_weak(expect, 1)) { expect = 0; std::this_thread::yield(); }
+}
+void vPortExitCritical(portMUX_TYPE* m) { m->owner.store(0); }
+
+// Jeder Task (auch der Haupt-Thread) hat einen Kontext mit Notify-Zähler
+struct HostTask {
+  TaskFunction_t          fn  = nullptr;
+  void*                   arg = nullptr;
+  std::mutex              mu;
+  std::condition_variable cv;
+  uint32_t                notify = 0;
+};
+static thread_local HostTask* s_self = nullptr;
+
+static HostTask* self_task() {
+  if (!s_self) s_self = new HostTask();   // Haupt-Thread / fremde Threads (nie freigegeben)
+  return s_self;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* out, BaseType_t) {
+  HostTask* t = new HostTask();
+  t->fn = fn; t->arg = arg;
+  if (out) *out = t;
+  std::thread([t] { s_self = t; t->fn(t->arg); }).detach();
+  return pdPASS;
+}
+void       vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+void       vTaskDelete(TaskHandle_t) {}
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return self_task(); }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t h) {
+  HostTask* t = (HostTask*)h;
+  if (!t) return pdFALSE;
+  { std::lock_guard<std::mutex> lk(t->mu); ++t->notify; }
+  t->cv.notify_one();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+  HostTask* t = self_task();
+  std::unique_lock<std::mutex> lk(t->mu);
+  if (ticks == portMAX_DELAY) t->cv.wait(lk, [t] { return t->notify != 0; });
+  else t->cv.wait_for(lk, std::chrono::milliseconds(ticks), [t] { return t->notify != 0; });
+  const uint32_t v = t->notify;
+  if (v) t->notify = clear ? 0 : v - 1;
+  return v;
+}
@@ -0,0 +1,74 @@
+// Host-Shim: SPI- und I2C-Fakes (zeichnen auf, I2C mit Registerdatei)
+
+#include "SPI.h"
+#include "Wire.h"
+#include "host_shim.h"
+#include <map>
+
+namespace host {
+static PeriphLog s_log;
+PeriphLog& periph() { return s_log; }
+void periph_reset() { s_log = PeriphLog(); }
+
+static std::map<uint8_t, std::vector<uint8_t>> s_i2c;
+void i2c_add_device(uint8_t addr) { s_i2c[addr].assign(256, 0); }
+void i2c_set_reg(uint8_t addr, uint8_t reg, uint8_t val) {
+  auto it = s_i2c.find(addr); if (it != s_i2c.end()) it->second[reg] = val;
+}
+uint8_t i2c_get_reg(uint8_t addr, uint8_t reg) {
+  auto it = s_i2c.find(addr); return it != s_i2c.end() ? it->second[reg] : 0;
+}
+static std::vector<uint8_t>* i2c_dev(uint8_t addr) {
+  auto it = s_i2c.find(addr); return it != s_i2c.end() ? &it->second : nullptr;
+}
+} // namespace host
+
+// ----- SPI -----
+SPIClass SPI(FSPI);
+
+void    SPIClass::begin(int8_t, int8_t, int8_t, int8_t) {}
+void    SPIClass::end() {}
+void    SPIClass::beginTransaction(const SPISettings&) { ++host::periph().spi_transactions; }
+void    SPIClass::endTransaction() {}
+uint8_t SPIClass::transfer(uint8_t) { ++host::periph().spi_bytes; return 0; }
+void    SPIClass::transfer(void*, uint32_t n) { host::periph().spi_bytes += n; }
+void    SPIClass::writeBytes(const uint8_t*, uint32_t n) { host::periph().spi_bytes += n; }
+
+// ----- I2C -----
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int, int, uint32_t) { return true; }
+bool TwoWire::setClock(uint32_t) { return true; }
+
+void TwoWire::beginTransmission(uint8_t addr) { _addr = addr; _tx_n = 0; }
+
+size_t TwoWire::write(const uint8_t* buf, size_t n) {
+  size_t i = 0;
+  for (; i < n && _tx_n < sizeof(_tx); ++i) _tx[_tx_n++] = buf[i];
+  return i;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  auto* dev = host::i2c_dev(_addr);
+  if (!dev) return 2; // NACK auf Adresse
+  ++host::periph().i2c_writes;
+  if (_tx_n) {
+    _reg = _tx[0];
+    for (size_t i = 1; i < _tx_n; ++i) (*dev)[(uint8_t)(_reg + i - 1)] = _tx[i];
+  }
+  _tx_n = 0;
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(int addr, int n, int) {
+  auto* dev = host::i2c_dev((uint8_t)addr);
+  _rx_n = _rx_pos = 0;
+  if (!dev) return 0;
+  ++host::periph().i2c_reads;
+  for (int i = 0; i < n && _rx_n < sizeof(_rx); ++i) _rx[_rx_n++] = (*dev)[(uint8_t)(_reg + i)];
+  return (uint8_t)_rx_n;
+}
+
+int TwoWire::available() { return (int)(_rx_n - _rx_pos); }
+int TwoWire::read() { return _rx_pos < _rx_n ? _rx[_rx_pos++] : -1; }
@@ -0,0 +1,146 @@
+// Host-Tool: Konsolen-Mitschnitt (`console mode=bin`) zurück in Textzeilen.
+//   twatch_decode [--stats] [datei]        ohne Datei: stdin (z. B. cat /dev/ttyACM0 | …)
+// Frames werden per CRC geprüft; Bytes außerhalb gültiger Frames gehen
+// unverändert durch (Textausgabe vor `console mode=bin`, Boot-Log).
+// Event-Frames erscheinen als "evt <topic> k=v …" wie im Textmodus; Topic- und
+// Key-Namen aus den 'T'/'K'-Ansagen, sonst aus der eigenen Registry (BUS_TOPICS,
+// BUS_KEYS) – ein Mitschnitt ab Stream-Mitte bleibt für bekannte Topics lesbar
+// (vollständig nach `console announce`). Gekürzter Freitext endet auf " ~truncated".
+
+#include <Arduino.h>
+#include "core/bus.hpp"
+#include "core/console_frame.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace console::frame;
+
+struct Decoder {
+  std::map<uint32_t, std::string> topics;   // angesagte Topic-Namen
+  uint8_t  keymap[256];                     // Geräte-Key → lokaler Key
+  size_t   frames = 0, evt_frames = 0, evt_bytes = 0, crc_errors = 0, text_bytes = 0, truncated = 0;
+
+  Decoder() { for (int i = 0; i < 256; ++i) keymap[i] = (uint8_t)i; }
+
+  std::string topic(uint32_t id) const {
+    auto it = topics.find(id);
+    if (it != topics.end()) return it->second;
+    size_t n = 0;
+    const char* s = bus::topic_name((bus::topic_t)id, &n);
+    if (n == 1 && s[0] == '?') { char b[16]; snprintf(b, sizeof(b), "0x%08x", (unsigned)id); return b; }
+    return std::string(s, n);
+  }
+
+  void evt(const uint8_t* b, size_t n, bool text) {
+    std::string line = "evt " + topic(get_u32(b));
+    bus::Payload p;
+    bool cut = false;
+    if (text) {
+      if (n < 5) return;
+      cut = b[4] & XF_TRUNC;
+      p = bus::Payload::text(String(std::string((const char*)b + 5, n - 5).c_str()));
+    } else {
+      for (size_t i = 4; i < n;) {
+        uint32_t hdr;
+        const size_t h = get_varint(b + i, n - i, hdr);
+        if (!h) return;
+        i += h;
+        const uint8_t key = keymap[(hdr >> 2) & 0xFF];
+        switch (hdr & 3) {
+          case F_INT: {
+            uint32_t v; const size_t m = get_varint(b + i, n - i, v);
+            if (!m) return;
+            p.set(key, (int)unzigzag(v)); i += m; break;
+          }
+          case F_FLOAT: {
+            if (i + 4 > n) return;
+            uint32_t u = get_u32(b + i); float f; memcpy(&f, &u, 4);
+            p.set(key, f); i += 4; break;
+          }
+          case F_STR: {
+            if (i + 1 > n || i + 1 + b[i] > n) return;
+            p.set(key, String(std::string((const char*)b + i + 1, b[i]).c_str())); i += 1 + b[i]; break;
+          }
+          default: return;
+        }
+      }
+    }
+    char kv[BODY_MAX + 64];
+    if (p.render(kv, sizeof(kv))) { line += ' '; line += kv; }
+    if (cut) { line += " ~truncated"; ++truncated; }
+    puts(line.c_str());
+  }
+
+  void frame(const uint8_t* b, size_t n, size_t total) {
+    ++frames;
+    switch (b[0]) {
+      case F_EVT:
+      case F_EVT_TEXT:
+        if (n < 5) return;
+        ++evt_frames; evt_bytes += total;
+        evt(b + 1, n - 1, b[0] == F_EVT_TEXT);
+        break;
+      case F_LINE:
+        if (n >= 2) printf("%.*s\n", (int)(n - 2), (const char*)b + 2);
+        break;
+      case F_TOPIC:
+        if (n >= 5) topics[get_u32(b + 1)] = std::string((const char*)b + 5, n - 5);
+        break;
+      case F_KEY:
+        if (n >= 2) keymap[b[1]] = bus::key_id((const char*)b + 2, n - 2);
+        break;
+    }
+  }
+
+  // Puffer ab pos auswerten; Rückgabe: verbrauchte Bytes (Rest wartet auf mehr Daten)
+  size_t feed(const uint8_t* s, size_t n, bool eof) {
+    size_t i = 0;
+    while (i < n) {
+      if (s[i] != SYNC) { putchar(s[i]); ++text_bytes; ++i; continue; }
+      uint32_t len;
+      const size_t lw = get_varint(s + i + 1, n - i - 1, len);
+      if (!lw && !eof && n - i < 6) break;
+      const size_t total = 1 + lw + len + 2;
+      if (!lw || !len || len > LEN_MAX) { ++crc_errors; ++i; continue; }
+      if (i + total > n) { if (eof) { ++crc_errors; ++i; continue; } break; }
+      const uint16_t want = (uint16_t)(s[i + total - 2] | s[i + total - 1] << 8);
+      if (crc16(s + i + 1, lw + len) != want) { ++crc_errors; ++i; continue; }   // resync am nächsten SYNC
+      frame(s + i + 1 + lw, len, total);
+      i += total;
+    }
+    return i;
+  }
+};
+
+int main(int argc, char** argv) {
+  bool stats = false;
+  const char* path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--stats")) stats = true;
+    else path = argv[i];
+  }
+  FILE* in = path ? fopen(path, "rb") : stdin;
+  if (!in) { fprintf(stderr, "twatch_decode: cannot open %s\n", path); return 2; }
+
+  Decoder d;
+  std::vector<uint8_t> buf;
+  uint8_t chunk[4096];
+  size_t rd;
+  while ((rd = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+    buf.insert(buf.end(), chunk, chunk + rd);
+    buf.erase(buf.begin(), buf.begin() + d.feed(buf.data(), buf.size(), false));
+    fflush(stdout);
+  }
+  d.feed(buf.data(), buf.size(), true);
+  if (path) fclose(in);
+
+  if (stats) {
+    fprintf(stderr, "frames=%zu evt_frames=%zu evt_bytes=%zu text_bytes=%zu crc_errors=%zu truncated=%zu\n",
+            d.frames, d.evt_frames, d.evt_bytes, d.text_bytes, d.crc_errors, d.truncated);
+  }
+  return 0;
+}
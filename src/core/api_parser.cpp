@@ -2,290 +2,1029 @@
 // A2: Universal-API Parser – mit Set-Unterstützung für power.*, i2c0.*, backlight.*, ui.brightness
 
 #include "api_parser.hpp"
+#include "api_tokenizer.hpp"
+#include "api_routes.hpp"
+#include "boot.hpp"
 #include "bus.hpp"
+#include "trace.hpp"
+#include "console.hpp"
+#include "session.hpp"
 #include "../services/service_config.hpp"
 
+#include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 #include <vector>
 #include <algorithm>
 
 namespace api {
 
+// ---------------------------------------------------------------------------
+// Request-Kontext: gilt für den gerade laufenden Befehl (id=, quiet)
+struct Req {
+  uint32_t id;
+  bool     has_id;
+  bool     mute_ok;     // quiet: erfolgreiche Antworten schreibender Verben unterdrücken
+};
+static Req      s_req = {};
+static uint32_t s_cmds = 0, s_errs = 0;   // laufende Zähler (Batch-Bilanz)
+
 // ---------------------------------------------------------------------------
 // Output helpers
-static sink_fn OUT = nullptr;
-static inline void ok(const String& s)  { if (OUT) OUT(s); }
-static inline void errc(const char* code, const String& msg) {
-  if (OUT) OUT(String("err code=") + code + " msg=\"" + msg + "\"");
+// Antworten gehen an die Session, deren Zeile gerade läuft (handleLine(sid, …))
+static uint8_t s_cur = session::CONSOLE;
+
+static inline void out(const String& s) { session::write(s_cur, s); }
+
+// Zählt Fehler; false → Zeile fällt im quiet-Modus weg
+static bool pass(const char* s, size_t n) {
+  if (n >= 3 && memcmp(s, "err", 3) == 0) { ++s_errs; return true; }
+  return !(s_req.mute_ok && n >= 2 && memcmp(s, "ok", 2) == 0 && (n == 2 || s[2] == ' '));
 }
 
-// ---------------------------------------------------------------------------
-// KV helpers
-static String kv_find(const String& args, const char* key) {
-  String needle = String(key) + "=";
-  int i = args.indexOf(needle);
-  if (i < 0) return "";
-  int start = i + needle.length();
-  int end = args.indexOf(' ', start);
-  if (end < 0) end = args.length();
-  return args.substring(start, end);
+static inline void ok(const String& s) {
+  if (!pass(s.c_str(), s.length())) return;
+  if (s_req.has_id) out(s + " id=" + String(s_req.id));
+  else              out(s);
 }
 
+// Antwort in einen Stack-Puffer formatieren (+ id=) → genau ein String am Sink
+static constexpr size_t OKF_MAX = 320;   // Antwortzeile auf dem Stack, Rest abgeschnitten
+
+static void vokf(const char* fmt, va_list ap) {
+  char buf[OKF_MAX];
+  int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+  if (n < 0) return;
+  if ((size_t)n >= sizeof(buf)) n = sizeof(buf) - 1;
+  if (!pass(buf, (size_t)n)) return;
+  if (s_req.has_id) snprintf(buf + n, sizeof(buf) - n, " id=%u", (unsigned)s_req.id);
+  out(String(buf));
+}
+
+static void okf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+static void okf(const char* fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  vokf(fmt, ap);
+  va_end(ap);
+}
+
+static inline void errc(const char* code, const char* msg) {
+  okf("err code=%s msg=\"%s\"", code, msg);
+}
+
+namespace k = bus::k;
+using bus::Payload;
+
 // ---------------------------------------------------------------------------
 // Internal state / caches
 static unsigned s_epoch_now = 0;
+static Tokens   s_tok;                // eine Zeile zur Zeit (Konsole)
+
+// Konsolen-Abos (ohne Handler) führt session.cpp je Session → sicheres "unsub *"
 
-// Track IDs der **Konsolen-Subscriptions** (ohne Handler) → sicheres "unsub *"
-static std::vector<uint32_t> s_console_sub_ids;
+// Konsolen-Abos, die Trace-Topics treffen können (Trace-Records sind keine Stickies)
+struct TraceSub { uint32_t id; uint8_t sid; String pattern; };
+static std::vector<TraceSub> s_trace_subs;
+static trace::Cursor s_trace_live;    // Live-Ausgabe an s_trace_subs
+static trace::Cursor s_trace_drain;   // `info trace` (konsumierend)
+static constexpr size_t TRACE_POLL_MAX = 16;   // Records pro poll()
 
 // Sticky-Cache für ui.brightness
 static int s_ui_brightness_cached = -1;
 
-// Emit-Guard: nur wirklich gefährliche Topics sperren (Owner/State/Interna)
-static bool is_forbidden_emit(const String& topic) {
-  if (topic.startsWith("trace.") || topic.startsWith("drv.")) return true;
-  if (topic.startsWith("sys.") || topic.startsWith("pmu."))   return true;
-  if (topic == "power.mode_changed" || topic == "power.last_call") return true;
-  return false;
+// quiet-Modus (set api.quiet value=on) je Session: nur Fehler und Abfragen antworten, kein Prompt
+static bool s_quiet[session::MAX] = {};
+
+// batch begin … batch end: Zeilen sammeln, bei end in einem Durchlauf ausführen
+static constexpr size_t BATCH_CAP = 2048;
+struct Batch {
+  bool     open;
+  uint8_t  owner;      // Session, deren Zeilen gesammelt werden
+  bool     quiet;
+  bool     overflow;
+  bool     has_id;
+  uint32_t id;
+  uint16_t len;
+  uint16_t lines;
+  char     buf[BATCH_CAP];   // Zeilen, '\n'-getrennt
+};
+static Batch s_batch = {};
+
+// ---------------------------------------------------------------------------
+// Span-Helfer (ohne Heap)
+static bool span_u32(const Span& v, uint32_t& out) {
+  if (!v.n || v.n > 10) return false;
+  uint64_t x = 0;
+  for (uint16_t i = 0; i < v.n; ++i) {
+    if (v.p[i] < '0' || v.p[i] > '9') return false;
+    x = x * 10 + (uint64_t)(v.p[i] - '0');
+  }
+  if (x > 0xFFFFFFFFull) return false;
+  out = (uint32_t)x;
+  return true;
 }
 
-// Set-Whitelist (zusätzlich zu ui.brightness)
-static bool is_allowed_set_topic(const String& topic) {
-  // harte Sperren zuerst
-  if (topic == "power.intent" || topic == "power.mode_changed" || topic == "power.last_call")
-    return false;
-  if (topic.startsWith("trace.") || topic.startsWith("drv.") || topic.startsWith("sys.") || topic.startsWith("pmu."))
-    return false;
+// Wie Payload::get_int: dezimal oder 0x…, sonst def
+static int span_int(const Span& v, int def) {
+  char tmp[16];
+  if (!v.n || v.n >= sizeof(tmp)) return def;
+  memcpy(tmp, v.p, v.n); tmp[v.n] = 0;
+  char* end = nullptr;
+  const bool hex = v.n > 2 && tmp[0] == '0' && (tmp[1] == 'x' || tmp[1] == 'X');
+  const long x = strtol(tmp, &end, hex ? 16 : 10);
+  return end == tmp ? def : (int)x;
+}
 
-  if (topic == "ui.brightness") return true; // Spezialfall (Owner: UI/Display)
+static bool span_bool(const Span& v, bool def) {
+  if (!v.n) return def;
+  return v.eq("1") || v.eq("on") || v.eq("true") || v.eq("yes");
+}
+
+// k=v-Paare direkt als typisierte Payload; freie Wörter oder unbekannte Keys → Freitext
+static Payload payload_of(const Tokens& t) {
+  Payload p;
+  if (t.npos) return Payload::parse(t.args.p, t.args.n);
+  for (uint8_t i = 0; i < t.nkv; ++i) {
+    const uint8_t key = bus::key_id(t.kv[i].key.p, t.kv[i].key.n);
+    if (key == k::NONE) return Payload::parse(t.args.p, t.args.n);
+    p.put(key, t.kv[i].val.p, t.kv[i].val.n);
+  }
+  return p;
+}
+
+static bool may_match_trace(const String& p) {
+  return p.startsWith("trace") || p.startsWith("*");
+}
 
-  // Whitelist-Präfixe
-  if (topic.startsWith("power."))     return true; // Policy, Ramp, Brownout, etc. (kein intent!)
-  if (topic.startsWith("i2c0."))      return true; // timeout_ms, retry
-  if (topic.startsWith("backlight.")) return true; // pwm_timer_hz, pwm_resolution_bits, gamma, min_pct
-  return false;
+// Trace-Records sind Events, keine Antworten → ohne id, nie stumm. Während eines
+// Befehls (info trace, sub trace.*-Replay) laufen sie auf der Konsole als resp.
+static void out_record(uint8_t sid, const trace::Record& r) {
+  char buf[256];
+  trace::render(r, buf, sizeof(buf));
+  session::write(sid, String(buf));
+}
+
+static void drop_trace_sub(uint32_t id) {
+  for (size_t i = 0; i < s_trace_subs.size(); ++i) {
+    if (s_trace_subs[i].id == id) { s_trace_subs.erase(s_trace_subs.begin() + i); return; }
+  }
 }
 
 // ---------------------------------------------------------------------------
 // Lifecycle
+static void build_routes();   // Tabelle steht hinter den Handlern
+
 void init(sink_fn out) {
-  OUT = out;
+  session::init();
+  session::open_console(out);
+  s_cur = session::CONSOLE;
+  memset(s_quiet, 0, sizeof(s_quiet));
+  s_trace_subs.clear();
+  s_batch.open = false;
+  build_routes();
+  s_trace_live.next = trace::written() + 1;
 
   // Internes Abo zum Cachen aktueller ui.brightness-Stickies
-  bus::subscribe("ui.brightness",
-    [](const String& /*topic*/, const String& kv) {
-      String v = kv_find(kv, "value");
-      if (v.length()) s_ui_brightness_cached = atoi(v.c_str());
+  bus::subscribe(bus::t::ui_brightness,
+    [](bus::topic_t /*topic*/, const Payload& p) {
+      if (p.has(k::value)) s_ui_brightness_cached = p.get_int(k::value);
     }
   );
 }
 
 // ---------------------------------------------------------------------------
 // Commands
-static void cmd_sub(const String& args) {
-  String p = args; p.trim();
-  if (p.length() == 0) { errc("E_SYNTAX", "bad command syntax"); return; }
-  uint32_t id = bus::subscribe(p);                 // console subscription (no handler)
-  s_console_sub_ids.push_back(id);                 // nur diese gehören dem Parser
-  ok("ok sub id=" + String(id) + " pattern=" + p);
-}
-
-static void cmd_unsub(const String& args) {
-  String a = args; a.trim();
-
-  // Sicheres "unsub *": ausschließlich Parser-eigene Console-Subs entfernen
-  if (a == "*") {
-    unsigned cnt = 0;
-    for (uint32_t id : s_console_sub_ids) {
-      if (bus::unsubscribe(id)) ++cnt;
+static void cmd_ping(const Tokens&, const Route&) { ok("ok pong"); }
+
+static void cmd_heap(const Tokens&, const Route&) {
+  okf("ok heap free=%u", (unsigned)ESP.getFreeHeap());
+}
+
+static void cmd_help(const Tokens& t, const Route&);
+
+// Sticky-Cursor für seq=: "<epoch hex>:<seq>" – nur innerhalb eines Boots vergleichbar
+static const char* seq_str(char (&buf)[20]) {
+  snprintf(buf, sizeof(buf), "%08x:%u", (unsigned)bus::sticky_epoch(), (unsigned)bus::sticky_seq());
+  return buf;
+}
+
+// sub <pattern> [since=<epoch>:<seq>]  – mit since nur Änderungen seit <seq> (Delta-Resync);
+// andere Epoche (Reboot) oder nur <seq> → volles Replay (replay=full)
+static void cmd_sub(const Tokens& t, const Route&) {
+  if (t.subj.empty()) { errc("E_SYNTAX", "bad command syntax"); return; }
+
+  Span sv;
+  const bool has_since = t.get("since", sv);
+  uint32_t epoch = 0, since = 0;
+  if (has_since) seq_of(sv, epoch, since);         // Schema hat seq bereits geprüft
+
+  const String p = t.subj.str();                   // Pattern bleibt im Abo gespeichert
+  bool delta = false;
+  size_t replayed = 0;
+  // Konsolen-Abo (ohne Handler) der laufenden Session; Replay geht nur an sie
+  const uint32_t id = session::subscribe(s_cur, p, has_since, epoch, since, &delta, &replayed);
+  if (!id) { errc("E_STATE", "no session"); return; }
+
+  // Trace-Replay: Ring-Inhalt bis zum Live-Cursor, danach übernimmt poll()
+  if (may_match_trace(p)) {
+    trace::Cursor c = trace::oldest();
+    trace::Record r;
+    while (c.next < s_trace_live.next && trace::read(c, r)) {
+      if (bus::matches(p, r.topic)) out_record(s_cur, r);
     }
-    s_console_sub_ids.clear();
-    ok("ok unsub console_all count=" + String(cnt));
+    s_trace_subs.push_back({ id, s_cur, p });
+  }
+  char seq[20];
+  if (has_since)
+    okf("ok sub id=%u pattern=%s seq=%s replay=%s n=%u", (unsigned)id, p.c_str(), seq_str(seq),
+        delta ? "delta" : "full", (unsigned)replayed);
+  else
+    okf("ok sub id=%u pattern=%s seq=%s", (unsigned)id, p.c_str(), seq_str(seq));
+}
+
+static void drop_trace_subs(uint8_t sid) {
+  for (size_t i = s_trace_subs.size(); i-- > 0;) {
+    if (s_trace_subs[i].sid == sid) s_trace_subs.erase(s_trace_subs.begin() + i);
+  }
+}
+
+static void cmd_unsub(const Tokens& t, const Route&) {
+  // Sicheres "unsub *": ausschließlich die Konsolen-Abos dieser Session entfernen
+  if (t.subj.eq("*")) {
+    const unsigned cnt = (unsigned)session::unsubscribe_all(s_cur);
+    drop_trace_subs(s_cur);
+    okf("ok unsub console_all count=%u", cnt);
     return;
   }
 
-  // Einzelnes ID-Unsubscribe
-  char* endp = nullptr;
-  uint32_t id = (uint32_t) strtoul(a.c_str(), &endp, 10);
-  if (endp == a.c_str()) { errc("E_SYNTAX", "bad command syntax"); return; }
+  // Einzelnes ID-Unsubscribe (nur eigene Abos; Service-Handler sind tabu)
+  uint32_t id = 0;
+  if (!span_u32(t.subj, id)) { errc("E_SYNTAX", "bad command syntax"); return; }
 
-  bool res = bus::unsubscribe(id);
-  if (res) {
-    auto it = std::find(s_console_sub_ids.begin(), s_console_sub_ids.end(), id);
-    if (it != s_console_sub_ids.end()) s_console_sub_ids.erase(it);
-    ok("ok unsub id=" + String(id));
+  if (session::unsubscribe(s_cur, id)) {
+    drop_trace_sub(id);
+    okf("ok unsub id=%u", (unsigned)id);
   } else {
     errc("E_UNKNOWN", "unknown subscription id");
   }
 }
 
-static void cmd_emit(const String& args) {
-  int sp = args.indexOf(' ');
-  if (sp <= 0) { errc("E_SYNTAX", "bad command syntax"); return; }
+static bool emit_checked(bus::topic_t id, const Span& v);   // bei set
 
-  String topic = args.substring(0, sp); topic.trim();
-  String kv    = args.substring(sp + 1); kv.trim();
-  if (!topic.length() || !kv.length()) { errc("E_SYNTAX", "bad command syntax"); return; }
+// Intent-Emit; geschützte Topics fängt die Tabelle (G_DENY) vorher ab
+static void cmd_emit(const Tokens& t, const Route&) {
+  if (t.subj.empty() || t.args.empty()) { errc("E_SYNTAX", "bad command syntax"); return; }
 
-  if (is_forbidden_emit(topic)) {
-    errc("E_FORBIDDEN", "emit to protected topic");
-    return;
+  const bus::topic_t id = bus::intern(t.subj.p, t.subj.n);
+  if (id == bus::topic_t::NONE) { errc("E_OVERFLOW", "topic table full"); return; }
+  if (!t.npos && t.nkv == 1 && t.kv[0].key.eq("value")) {   // Schema-Keys nur über value=
+    if (!emit_checked(id, t.kv[0].val)) return;
+  } else {
+    bus::emit_sticky(id, payload_of(t));
   }
-
-  bus::emit_sticky(topic, kv);
-  ok("ok emit " + topic);
+  okf("ok emit %.*s", (int)t.subj.n, t.subj.p);
 }
 
 // ---------------------------------------------------------------------------
-// Verbs
-static void do_get(const String& subj_in, const String& /*args*/) {
-  String subj = subj_in; subj.trim();
-
-  if (subj == "ui.brightness") {
-    int v = (s_ui_brightness_cached >= 0)
-              ? s_ui_brightness_cached
-              : (config::has_ui_brightness() ? config::get_ui_brightness() : 50);
-    ok("ok ui.brightness value=" + String(v));
-    return;
+// get
+static void get_ui_brightness(const Tokens&, const Route&) {
+  int v = (s_ui_brightness_cached >= 0) ? s_ui_brightness_cached : config::get_ui_brightness();
+  okf("ok ui.brightness value=%d", v);
+}
+
+static void get_time_now(const Tokens&, const Route&) {
+  okf("ok time.now epoch=%u", s_epoch_now);
+}
+
+// get <topic> [fields=a,b]     – ein Sticky direkt aus dem Store
+// get <pattern> [fields=a,b]   – z. B. power.*: eine Zeile mit allen Treffern,
+//   Namen relativ zum Präfix; Einzelwert "value" kompakt als <name>=<v>:
+//   ok power.* n=3 seq=812 mode_changed.mode=ready sleep.autowake_ms=5000 …
+static constexpr size_t GET_FIELDS_MAX = 8;
+static constexpr size_t SNAPSHOT_MAX   = 1536;   // Zeichen je Antwort, Rest → more=<n>
+
+struct Snap {
+  const uint8_t* only;
+  size_t         n_only;
+  size_t         strip;      // Präfixlänge, die in der Antwort entfällt
+  String*        out;
+  uint32_t       shown;
+  uint32_t       more;
+};
+
+// fields=a,b,c → Key-IDs (unbekannte Namen werden nicht interniert und treffen nie)
+static size_t parse_fields(const Tokens& t, uint8_t* keys) {
+  Span f;
+  if (!t.get("fields", f)) return 0;
+  size_t n = 0;
+  for (uint16_t a = 0; a < f.n && n < GET_FIELDS_MAX; ) {
+    uint16_t e = a;
+    while (e < f.n && f.p[e] != ',') ++e;
+    if (e > a) keys[n++] = bus::key_find(f.p + a, e - a);
+    a = e + 1;
+  }
+  return n;
+}
+
+static void snap_one(bus::topic_t topic, const Payload& p, uint32_t /*seq*/, void* ctx) {
+  Snap& sn = *(Snap*)ctx;
+  size_t tn = 0;
+  const char* t = bus::topic_name(topic, &tn);
+  const char* rel = t + (sn.strip <= tn ? sn.strip : 0);
+  const size_t rn = tn - (rel - t);
+
+  char kv[192];
+  const size_t kn = p.render(kv, sizeof(kv), sn.only, sn.n_only);
+  if (!kn && sn.only) return;                        // Projektion trifft nichts
+
+  if (sn.out->length() + rn + kn + 8 > SNAPSHOT_MAX) { ++sn.more; return; }
+  ++sn.shown;
+  if (!kn) { *sn.out += ' '; sn.out->concat(rel, rn); return; }
+
+  // k=v-Tokens kommen aus render() bereits gequotet; nur Freitext (Wörter ohne '=')
+  // wird hier zu einem .text="…" zusammengefasst
+  for (size_t a = 0; a < kn; ) {
+    size_t e = a;
+    for (bool q = false; e < kn && (q || kv[e] != ' '); ++e) {
+      if (q && kv[e] == '\\' && e + 1 < kn) ++e;
+      else if (kv[e] == '"') q = !q;
+    }
+    const char* eq = (const char*)memchr(kv + a, '=', e - a);
+    if (!eq) {                                       // Freitext bis zum nächsten k=v-Token
+      for (size_t f = e; f < kn; ) {
+        size_t g = f + 1;
+        while (g < kn && kv[g] != ' ' && kv[g] != '=') ++g;
+        if (g < kn && kv[g] == '=') break;
+        while (g < kn && kv[g] != ' ') ++g;
+        e = f = g;
+      }
+    }
+    const size_t kl = eq ? eq - (kv + a) : 0;
+    const char* v = eq ? eq + 1 : kv + a;
+    const size_t vn = (kv + e) - v;
+    const bool quote = !eq && (memchr(v, ' ', vn) || memchr(v, '"', vn));
+
+    *sn.out += ' '; sn.out->concat(rel, rn);
+    const bool single = a == 0 && e == kn && kl == 5 && memcmp(kv, "value", 5) == 0;
+    if (!single) {                                   // Einzelwert kompakt: <name>=v
+      *sn.out += '.';
+      if (kl) sn.out->concat(kv + a, kl);
+      else    *sn.out += "text";                     // Freitext ohne k=v
+    }
+    *sn.out += '=';
+    if (!quote) {
+      sn.out->concat(v, vn);
+    } else {
+      *sn.out += '"';
+      for (size_t i = 0; i < vn; ++i) { if (v[i] == '"' || v[i] == '\\') *sn.out += '\\'; *sn.out += v[i]; }
+      *sn.out += '"';
+    }
+    a = e + 1;
   }
+}
+
+static void get_topic(const Tokens& t, const Route&) {
+  uint8_t keys[GET_FIELDS_MAX];
+  const size_t nk = parse_fields(t, keys);
+  const uint8_t* only = t.has("fields") ? keys : nullptr;
 
-  if (subj == "time.now") {
-    ok("ok time.now epoch=" + String(s_epoch_now));
+  const char* star = (const char*)memchr(t.subj.p, '*', t.subj.n);
+  if (!star) {
+    Payload p;
+    if (!bus::get_sticky(t.subj.p, t.subj.n, p)) { errc("E_UNKNOWN", "unknown topic"); return; }
+    char kv[192];
+    const size_t kn = p.render(kv, sizeof(kv), only, nk);
+    okf("ok %.*s%s%s", (int)t.subj.n, t.subj.p, kn ? " " : "", kv);
     return;
   }
 
-  errc("E_UNKNOWN", "unknown subject");
+  // Präfix bis zum letzten '.' vor dem ersten '*' entfällt in den Namen
+  size_t strip = star - t.subj.p;
+  while (strip && t.subj.p[strip - 1] != '.') --strip;
+
+  String line;
+  line.reserve(256);
+  Snap sn = { only, nk, strip, &line, 0, 0 };
+  bus::for_each_sticky(t.subj.p, t.subj.n, snap_one, &sn);
+  char head[96], seq[20];
+  snprintf(head, sizeof(head), "ok %.*s n=%u seq=%s", (int)t.subj.n, t.subj.p, (unsigned)sn.shown, seq_str(seq));
+  String resp = head;
+  resp += line;
+  if (sn.more) resp += " more=" + String(sn.more);
+  ok(resp);
 }
 
-static void do_set(const String& subj_in, const String& args_in) {
-  String subj = subj_in; subj.trim();
-  String args = args_in; args.trim();
+// ---------------------------------------------------------------------------
+// set
+// ui.brightness (Sonderfall + Persistenz-Note)
+static void set_ui_brightness(const Tokens& t, const Route&) {
+  Span v; t.get("value", v);
+  const config::Row& r = config::row(config::K_ui_brightness);   // Konsole klemmt hier (wie bisher)
+  int val = span_int(v, 0);
+  if (val < (int)r.min) val = (int)r.min;
+  if (val > (int)r.max) val = (int)r.max;
 
-  // ui.brightness (Sonderfall + Persistenz-Note)
-  if (subj == "ui.brightness") {
-    String v = kv_find(args, "value");
-    if (!v.length()) { errc("E_SYNTAX", "missing value"); return; }
-    int val = atoi(v.c_str()); if (val < 0) val = 0; if (val > 100) val = 100;
+  bus::emit_sticky(bus::t::ui_brightness, Payload().set(k::value, val));
+  s_ui_brightness_cached = val;
+  config::note_ui_brightness(val);
 
-    bus::emit_sticky("ui.brightness", "value=" + String(val));
-    s_ui_brightness_cached = val;
-    config::note_ui_brightness(val);
+  okf("ok set ui.brightness value=%d", val);
+}
 
-    ok("ok set ui.brightness value=" + String(val));
-    return;
+// Schema-Key (config_schema.hpp): typisiert übernehmen, außerhalb des Bereichs → E_RANGE
+static bool emit_checked(bus::topic_t id, const Span& v) {
+  Payload p;
+  bool known = false;
+  if (config::accept(id, v.p, v.n, p, &known)) { bus::emit_sticky(id, p); return true; }
+  if (known) {
+    const config::Row& r = config::row(config::key_of(id));
+    char msg[64];
+    if (r.type == config::T_INT || r.type == config::T_FLOAT)
+      snprintf(msg, sizeof(msg), "%s %.10g..%.10g", config::type_name(r.type), r.min, r.max);
+    else if (r.type == config::T_ENUM)
+      snprintf(msg, sizeof(msg), "one of %s", r.opts);
+    else
+      snprintf(msg, sizeof(msg), "bad %s", config::type_name(r.type));
+    errc("E_RANGE", msg);
+    return false;
   }
+  bus::emit_sticky(id, Payload().put(k::value, v.p, v.n));
+  return true;
+}
+
+// Whitelist-Präfixe (power.*, i2c0.*, backlight.*, log.level.*, console.policy.*)
+static void set_topic(const Tokens& t, const Route&) {
+  Span v; t.get("value", v);
+  const bus::topic_t id = bus::intern(t.subj.p, t.subj.n);
+  if (id == bus::topic_t::NONE) { errc("E_OVERFLOW", "topic table full"); return; }
+  if (!emit_checked(id, v)) return;
+  config::note(id, v.p, v.n);                      // User-Key → Write-Behind
+  okf("ok set %.*s value=%.*s", (int)t.subj.n, t.subj.p, (int)v.n, v.p);
+}
 
-  // Whitelisted Topics: power.*, i2c0.*, backlight.*
-  if (is_allowed_set_topic(subj)) {
-    if (is_forbidden_emit(subj)) { errc("E_FORBIDDEN", "set to protected topic"); return; }
+// ---------------------------------------------------------------------------
+// do
+// Power: Parser erzeugt **nur Intents**, Owner ist der PowerService
+static void do_power(const Tokens& t, const Route&) {
+  char target[16];
+  const size_t n = t.subj.n - 6;                   // "power." abschneiden
+  memcpy(target, t.subj.p + 6, n); target[n] = 0;
+  bus::emit_sticky(bus::t::power_intent, Payload().set(k::target, target).set(k::origin, "api"));
+  okf("ok do power.%s", target);
+}
 
-    String v = kv_find(args, "value");
-    if (!v.length()) { errc("E_SYNTAX", "missing value"); return; }
+// (Optional) kleine Cal-Hooks bleiben, Ownership beim Display-Service
+static void do_display_cal(const Tokens& t, const Route&) {
+  Span op;
+  if (t.npos) op = t.pos[0];
+  else        t.get("op", op);
 
-    bus::emit_sticky(subj, "value=" + v);
-    ok("ok set " + subj + " value=" + v);
+  static const char* const OPS[] = { "start", "stop", "next" };
+  for (const char* o : OPS) {
+    if (!op.eq(o)) continue;
+    bus::emit_sticky(bus::t::ui_cal_cmd, Payload().set(k::op, o));
+    okf("ok do display.cal %s", o);
     return;
   }
 
-  errc("E_UNKNOWN", "unknown subject");
+  Span v;
+  if (t.get("rot", v)) {
+    int r = span_int(v, 0); if (r < 0) r = 0; if (r > 3) r = 3;
+    bus::emit_sticky(bus::t::ui_cal_rot, Payload().set(k::value, r));
+    okf("ok do display.cal rot=%d", r);
+    return;
+  }
+
+  if (t.get("gamma", v)) {
+    bus::emit_sticky(bus::t::ui_cal_gamma, Payload().put(k::value, v.p, v.n));
+    okf("ok do display.cal gamma=%.*s", (int)v.n, v.p);
+    return;
+  }
+
+  errc("E_SYNTAX", "usage: do display.cal start|stop|next|rot=<0..3>|gamma=<f>");
+}
+
+// Config: delegiert an ConfigService (Owner)
+static void do_config_save(const Tokens&, const Route&) {
+  size_t bw = 0; bool okw = config::save_now(&bw);
+  okf("%s config.save wrote=%u", okw ? "ok" : "err", (unsigned)bw);
+}
+
+static void do_config_reload(const Tokens&, const Route&) {
+  const config::ReloadStats& r = config::reload();
+  okf("ok config.reload changed=%u same=%u reverted=%u dropped=%u us=%u", (unsigned)r.changed,
+      (unsigned)r.same, (unsigned)r.reverted, (unsigned)r.dropped, (unsigned)r.us);
+}
+
+// ---------------------------------------------------------------------------
+// info
+static void info_bus_queue(const Tokens&, const Route&) {
+  bus::QueueStats q; bus::queue_stats(q);
+  okf("ok bus.queue depth=%u high_water=%u posted=%u dropped=%u drained=%u cap=%u",
+      (unsigned)q.depth, (unsigned)q.high_water, (unsigned)q.posted, (unsigned)q.dropped,
+      (unsigned)q.drained, (unsigned)bus::QUEUE_CAP);
 }
 
-static void do_do(const String& subj_in, const String& args_in) {
-  String subj = subj_in; subj.trim();
-  String args = args_in; args.trim();
+static void info_trace(const Tokens&, const Route&) {
+  uint32_t n = 0, lost = 0;
+  trace::Record r;
+  while (trace::read(s_trace_drain, r, &lost)) { out_record(s_cur, r); ++n; }
+  String lv;
+  for (uint8_t s = 0; s < trace::SUBSYS_COUNT; ++s) {
+    if (lv.length()) lv += ',';
+    lv += trace::subsys_name((trace::Subsys)s); lv += ':'; lv += trace::level_name(trace::level((trace::Subsys)s));
+  }
+  ok("ok trace n=" + String(n) + " lost=" + String(lost) + " written=" + String(trace::written())
+     + " cap=" + String(TRACE_RING_CAP) + " levels=" + lv);
+}
 
-  // Power: Parser erzeugt **nur Intents**, Owner ist der PowerService
-  if (subj == "power.ready")     { bus::emit_sticky("power.intent", "target=ready origin=api");      ok("ok do power.ready");      return; }
-  if (subj == "power.standby")   { bus::emit_sticky("power.intent", "target=standby origin=api");    ok("ok do power.standby");    return; }
-  if (subj == "power.lightsleep"){ bus::emit_sticky("power.intent", "target=lightsleep origin=api"); ok("ok do power.lightsleep"); return; }
-  if (subj == "power.deepsleep") { bus::emit_sticky("power.intent", "target=deepsleep origin=api");  ok("ok do power.deepsleep");  return; }
+static void info_console(const Tokens&, const Route&) {
+  console::Stats st; console::stats(st);
+  String s = "ok console depth=" + String(st.depth) + " high_water=" + String(st.high_water)
+           + " cap=" + String(CONSOLE_TX_CAP) + " tx_bytes=" + String(st.bytes_tx) + " writes=" + String(st.writes);
+  for (uint8_t c = 0; c < console::CLASS_COUNT; ++c) {
+    const char* cn = console::class_name((console::Class)c);
+    s += String(" ") + cn + ".policy=" + console::policy_name(console::policy((console::Class)c));
+    s += String(" ") + cn + ".lines=" + String(st.lines[c]);
+    s += String(" ") + cn + ".dropped=" + String(st.dropped[c]);
+    s += String(" ") + cn + ".coalesced=" + String(st.coalesced[c]);
+  }
+  s += String(" mode=") + console::mode_name(console::mode()) + " frames=" + String(st.frames);
+  console::RxStats rx; console::rx_stats(rx);
+  s += " rx.lines=" + String(rx.lines) + " rx.bytes=" + String(rx.bytes) + " rx.overlong=" + String(rx.overlong)
+     + " rx.idle_flushes=" + String(rx.idle_flushes) + " rx.stalls=" + String(rx.stalls)
+     + " rx.high_water=" + String(rx.high_water) + " rx.line_max=" + String(CONSOLE_LINE_MAX);
+  ok(s);
+}
 
-  // (Optional) kleine Cal-Hooks bleiben, Ownership beim Display-Service
-  if (subj == "display.cal") {
-    String op    = kv_find(args, "op");
-    String rot   = kv_find(args, "rot");
-    String gamma = kv_find(args, "gamma");
+// console mode=text|bin  – bin: Events/Antworten als Frames (console_frame.hpp).
+// Die Bestätigung kommt immer als Textzeile: vor dem Umschalten auf bin, nach
+// dem Zurückschalten auf text → der Host sieht genau, wo die Frames beginnen.
+static void cmd_console(const Tokens& t, const Route&) {
+  Span m; t.get("mode", m);
+  if (m.eq("bin")) {
+    ok("ok console mode=bin");
+    console::set_mode(console::MODE_BIN);
+  } else if (m.eq("text")) {
+    console::set_mode(console::MODE_TEXT);
+    ok("ok console mode=text");
+  } else {
+    errc("E_SYNTAX", "bad mode");
+  }
+}
 
-    if (args.startsWith("start") || op == "start") { bus::emit_sticky("ui.cal.cmd", "op=start"); ok("ok do display.cal start"); return; }
-    if (args.startsWith("stop")  || op == "stop")  { bus::emit_sticky("ui.cal.cmd", "op=stop");  ok("ok do display.cal stop");  return; }
-    if (args.startsWith("next")  || op == "next")  { bus::emit_sticky("ui.cal.cmd", "op=next");  ok("ok do display.cal next");  return; }
+// console announce – bin: Topic-/Key-Namen vor dem nächsten Event erneut senden
+// (Decoder, der neu oder mitten im Stream einsteigt)
+static void cmd_console_announce(const Tokens&, const Route&) {
+  console::announce();
+  okf("ok console announce mode=%s", console::mode_name(console::mode()));
+}
 
-    if (rot.length()) {
-      int r = atoi(rot.c_str()); if (r < 0) r = 0; if (r > 3) r = 3;
-      bus::emit_sticky("ui.cal.rot", "value=" + String(r));
-      ok("ok do display.cal rot=" + String(r));
-      return;
-    }
+static void info_bus(const Tokens&, const Route&) {
+  uint32_t emits = 0, calls = 0; bus::profile_totals(emits, calls);
+  char seq[20];
+  ok("ok bus profile=" + String(bus::profiling() ? "on" : "off") + " subs=" + String((unsigned)bus::sub_count())
+     + " stickies=" + String((unsigned)bus::sticky_count()) + " topics=" + String((unsigned)bus::topic_count())
+     + " topic_cap=" + String((unsigned)bus::TOPIC_MAX) + " topic_probed=" + String(bus::topic_probed())
+     + " topic_full=" + String(bus::topic_full()) + " seq=" + seq_str(seq) + " journal=" + String(bus::JOURNAL_CAP)
+     + " emits=" + String(emits) + " handler_calls=" + String(calls) + " hit_spills=" + String(bus::hit_spills()));
+}
+
+// Teuerste Handler + häufigste Topics; n=<1..16> (Default 5), reset=1 setzt danach zurück
+static void info_bus_top(const Tokens& t, const Route&) {
+  if (!bus::profiling()) { errc("E_UNSUPPORTED", "built without BUS_PROFILE"); return; }
+  Span v;
+  int n = t.get("n", v) ? span_int(v, 5) : 5; if (n < 1) n = 1; if (n > 16) n = 16;
+
+  bus::SubProfile sp[16];
+  const size_t ns = bus::profile_top_subs(sp, (size_t)n);
+  for (size_t i = 0; i < ns; ++i) {
+    String hist;
+    size_t last = 0;
+    for (size_t b = 0; b < bus::PROF_BUCKETS; ++b) if (sp[i].hist[b]) last = b;
+    for (size_t b = 0; b <= last; ++b) { if (b) hist += ','; hist += String(sp[i].hist[b]); }
+    ok("bus.top.sub id=" + String(sp[i].id) + " pattern=" + bus::sub_pattern(sp[i].id)
+       + " calls=" + String(sp[i].calls) + " total_us=" + String(sp[i].total_us)
+       + " avg_us=" + String(sp[i].total_us / sp[i].calls) + " max_us=" + String(sp[i].max_us)
+       + " hist_log2us=" + hist);
+  }
+  bus::TopicProfile tp[16];
+  const size_t nt = bus::profile_top_topics(tp, (size_t)n);
+  for (size_t i = 0; i < nt; ++i) {
+    ok("bus.top.topic topic=" + String(bus::topic_name(tp[i].id)) + " emits=" + String(tp[i].emits)
+       + " handler_us=" + String(tp[i].handler_us));
+  }
+  if (t.get("reset", v) && span_bool(v, false)) bus::profile_reset();
+  ok("ok bus.top subs=" + String((unsigned)ns) + " topics=" + String((unsigned)nt));
+}
+
+static void info_config(const Tokens&, const Route&) {
+  const config::LoadStats& ls = config::load_stats();
+  const config::PersistStats& ps = config::persist_stats();
+  char load[160];
+  snprintf(load, sizeof(load), " load=%s load_us=%u stickies=%u pending=%u writes=%u changes=%u coalesced=%u",
+           ls.cached ? "cache" : "ini", (unsigned)ls.us, (unsigned)ls.keys, (unsigned)config::pending(),
+           (unsigned)ps.writes, (unsigned)ps.changes, (unsigned)ps.coalesced);
+  String snap = config::snapshot();
+  ok("ok config dirty=" + String(config::is_dirty() ? "true" : "false")
+     + (config::is_lossy() ? " lossy=true" : "") + load
+     + (snap.length() ? " keys=" + snap : ""));
+}
 
-    if (gamma.length()) {
-      bus::emit_sticky("ui.cal.gamma", "value=" + gamma);
-      ok("ok do display.cal gamma=" + gamma);
-      return;
+// info config.schema [all=1] → Schema-Keys mit Default, Klemmung oder ungültigem
+// INI-Wert (all: jeder Key), danach Bilanz je Herkunft
+static void info_config_schema(const Tokens& t, const Route&) {
+  Span v;
+  const bool all = t.get("all", v) && span_bool(v, false);
+  unsigned cnt[config::S_SET + 1] = {};
+  char val[64], range[48];
+  for (uint8_t i = 0; i < config::KEY_COUNT; ++i) {
+    const config::Key key = (config::Key)i;
+    const config::Source src = config::source(key);
+    ++cnt[src];
+    if (!all && (src == config::S_INI || src == config::S_SET)) continue;
+    const config::Row& r = config::row(key);
+    switch (r.type) {
+      case config::T_INT:
+      case config::T_FLOAT: snprintf(range, sizeof(range), " min=%.10g max=%.10g", r.min, r.max); break;
+      case config::T_ENUM:  snprintf(range, sizeof(range), " opts=%s", r.opts); break;
+      default:              range[0] = 0; break;
     }
+    if (r.type == config::T_FLOAT)     snprintf(val, sizeof(val), "%g", (double)config::get_float(key));
+    else if (r.type == config::T_INT)  snprintf(val, sizeof(val), "%ld", (long)config::get_int(key));
+    else if (r.type == config::T_BOOL) snprintf(val, sizeof(val), "%s", config::get_bool(key) ? "on" : "off");
+    else                               snprintf(val, sizeof(val), "%s", config::get_str(key));
+    okf("config.schema key=%s type=%s value=%s default=%s%s owner=%s src=%s%s%s", r.name,
+        config::type_name(r.type), val, r.def, range, r.owner, config::source_name(src),
+        *config::raw(key) ? " raw=" : "", config::raw(key));
+  }
+  okf("ok config.schema keys=%u ini=%u set=%u defaults=%u clamped=%u invalid=%u", (unsigned)config::KEY_COUNT,
+      cnt[config::S_INI], cnt[config::S_SET], cnt[config::S_DEFAULT], cnt[config::S_CLAMPED], cnt[config::S_INVALID]);
+}
 
-    errc("E_SYNTAX", "usage: do display.cal start|stop|next|rot=<0..3>|gamma=<f>");
-    return;
+// info boot [prev=1] → eine Zeile je Boot-Phase (Startreihenfolge), dann Bilanz.
+// late=1: Phase endet nach [boot] safe_window_ms; slo: Start-Stickies bis STICKY_SLO_MS;
+// frame_ms: stage.display fertig (0 = noch offen)
+static void info_boot(const Tokens& t, const Route&) {
+  Span v;
+  const bool prev = t.get("prev", v) && span_bool(v, false);
+  const uint32_t window_us = boot::window_ms() * 1000u;
+  uint32_t total_us = 0, stickies_us = 0, frame_us = 0;
+  unsigned late = 0;
+  boot::Entry e;
+  const size_t n = boot::count(prev);
+  if (prev && !n) { errc("E_STATE", "no previous boot"); return; }
+  for (size_t i = 0; i < n && boot::entry(i, e, prev); ++i) {
+    const uint32_t end = e.start_us + e.dur_us;
+    const bool is_late = window_us && (e.open || end > window_us);
+    late += is_late;
+    if (end > total_us) total_us = end;
+    if (!strcmp(e.name, "stickies")) stickies_us = end;
+    if (!strcmp(e.name, "stage.display")) frame_us = end;
+    okf("boot phase=%s start_us=%u dur_us=%u late=%u%s", e.name, (unsigned)e.start_us, (unsigned)e.dur_us,
+        (unsigned)is_late, e.open ? " open=1" : "");
   }
+  const bool slo = stickies_us && stickies_us <= boot::STICKY_SLO_MS * 1000u;
+  char stages[24] = "";
+  if (!prev) snprintf(stages, sizeof(stages), " stages=%u/%u", (unsigned)boot::stages_ready(),
+                      (unsigned)boot::stages_total());
+  okf("ok boot %s phases=%u total_ms=%u ready_ms=%u frame_ms=%u window_ms=%u late=%u stickies_ms=%u slo=%s%s",
+      prev ? "prev" : "cur", (unsigned)n, (unsigned)(total_us / 1000), (unsigned)(boot::ready_us(prev) / 1000),
+      (unsigned)(frame_us / 1000), (unsigned)boot::window_ms(), late, (unsigned)(stickies_us / 1000),
+      slo ? "ok" : "miss", stages);
+}
 
-  // Config: delegiert an ConfigService (Owner)
-  if (subj == "config.save") {
-    size_t bw = 0; bool okw = config::save_now(&bw);
-    ok(String(okw ? "ok" : "err") + " config.save wrote=" + String((unsigned)bw));
-    return;
+static void info_api(const Tokens&, const Route&) {
+  RouteStats rs; route_stats(rs);
+  okf("ok api routes=%u slots=%u seed=%u perfect=%s line_max=%u",
+      (unsigned)rs.routes, (unsigned)rs.slots, (unsigned)rs.seed, rs.perfect ? "true" : "false",
+      (unsigned)(Tokens::LINE_MAX - 1));
+}
+
+// ---------------------------------------------------------------------------
+// quiet / batch
+static void run_line(const char* line, size_t n);
+
+static void set_api_quiet(const Tokens& t, const Route&) {
+  Span v; t.get("value", v);
+  s_quiet[s_cur] = span_bool(v, false);
+  s_req.mute_ok = false;                           // Bestätigung dieses Befehls immer
+  okf("ok set api.quiet value=%s", s_quiet[s_cur] ? "on" : "off");
+}
+
+// ---------------------------------------------------------------------------
+// Sessions: Einstellungen gelten für die Session, die den Befehl schickt
+static void set_session_monitor(const Tokens& t, const Route&) {
+  Span v; t.get("value", v);
+  const bool on = span_bool(v, false);
+  session::set_monitor(s_cur, on);
+  okf("ok set session.monitor value=%s", on ? "on" : "off");
+}
+
+static void set_session_rate(const Tokens& t, const Route&) {
+  Span v; t.get("value", v);
+  uint32_t r = 0;
+  span_u32(v, r);                                  // Schema hat u32 bereits geprüft
+  session::set_rate(s_cur, r);
+  okf("ok set session.rate value=%u", (unsigned)r);
+}
+
+// info session → eine Zeile je offener Session, dann Bilanz mit eigener ID
+static void info_session(const Tokens&, const Route&) {
+  unsigned n = 0;
+  session::Info si;
+  for (uint8_t sid = 0; sid < session::MAX; ++sid) {
+    if (!session::info(sid, si)) continue;
+    okf("session sid=%u name=%s monitor=%s subs=%u rate=%u lines=%u events=%u dropped_rate=%u "
+        "dropped_full=%u depth=%u high_water=%u cap=%u",
+        (unsigned)sid, si.name, si.monitor ? "on" : "off", (unsigned)si.subs, (unsigned)si.rate,
+        (unsigned)si.lines, (unsigned)si.events, (unsigned)si.dropped_rate, (unsigned)si.dropped_full,
+        (unsigned)si.depth, (unsigned)si.high_water, (unsigned)si.cap);
+    ++n;
   }
+  okf("ok session n=%u self=%u max=%u", n, (unsigned)s_cur, (unsigned)session::MAX);
+}
 
-  errc("E_UNKNOWN", "unknown subject");
+// batch begin [quiet=1] [id=N] – folgende Zeilen nur sammeln (ohne Antwort/Prompt)
+// Ein Batch zur Zeit (ein Puffer); eine andere Session bekommt E_STATE
+static void batch_begin(const Tokens& t, const Route&) {
+  if (s_batch.open) { errc("E_STATE", "batch already open"); return; }
+  Span v;
+  s_batch.open     = true;
+  s_batch.owner    = s_cur;
+  s_batch.quiet    = t.get("quiet", v) && span_bool(v, false);
+  s_batch.overflow = false;
+  s_batch.has_id   = s_req.has_id;
+  s_batch.id       = s_req.id;
+  s_batch.len      = 0;
+  s_batch.lines    = 0;
+  okf("ok batch begin cap=%u", (unsigned)BATCH_CAP);
 }
 
-static void do_info(const String& subj_in, const String& /*args_in*/) {
-  String subj = subj_in; subj.trim();
+static void batch_abort(const Tokens&, const Route&) {
+  if (!s_batch.open || s_batch.owner != s_cur) { errc("E_STATE", "no open batch"); return; }
+  s_batch.open = false;
+  okf("ok batch abort dropped=%u", (unsigned)s_batch.lines);
+}
 
-  if (subj == "heap" || subj == "sys.heap") {
-    ok("ok heap free=" + String((unsigned)ESP.getFreeHeap()));
-    return;
+// batch end – gesammelte Zeilen in einem Durchlauf, danach eine Bilanz (id von end, sonst begin)
+static void batch_end(const Tokens&, const Route&) {
+  if (!s_batch.open || s_batch.owner != s_cur) { errc("E_STATE", "no open batch"); return; }
+  const Req end_req = s_req;
+  s_batch.open = false;
+  if (s_batch.overflow) { errc("E_OVERFLOW", "batch too large"); return; }
+
+  const uint32_t cmds0 = s_cmds, errs0 = s_errs;
+  const bool quiet = s_quiet[s_cur];
+  s_quiet[s_cur] = quiet || s_batch.quiet;
+  for (uint16_t a = 0; a < s_batch.len; ) {
+    uint16_t e = a;
+    while (e < s_batch.len && s_batch.buf[e] != '\n') ++e;
+    run_line(s_batch.buf + a, e - a);
+    a = e + 1;
   }
+  s_quiet[s_cur] = quiet;
+
+  s_req = end_req.has_id ? end_req : Req{ s_batch.id, s_batch.has_id, false };
+  s_req.mute_ok = false;
+  okf("ok batch n=%u errors=%u", (unsigned)(s_cmds - cmds0), (unsigned)(s_errs - errs0));
+}
 
-  if (subj == "config") {
-    String snap = config::snapshot();
-    ok("ok config dirty=" + String(config::is_dirty() ? "true" : "false")
-       + (snap.length() ? " keys=" + snap : ""));
+static void batch_collect(const char* line, size_t n) {
+  while (n && (unsigned char)line[n - 1] <= ' ') --n;
+  if (!n) return;
+  if (s_batch.overflow || s_batch.len + n + 1 > BATCH_CAP) { s_batch.overflow = true; return; }
+  memcpy(s_batch.buf + s_batch.len, line, n);
+  s_batch.len += (uint16_t)n;
+  s_batch.buf[s_batch.len++] = '\n';
+  ++s_batch.lines;
+}
+
+// ---------------------------------------------------------------------------
+// Routing-Tabelle: verb, Match, Subject bzw. Präfix ("" = Verb-Default),
+// Schutzklasse, Handler, Argument-Schema (siehe api_routes.hpp).
+// Exakte Einträge schlagen Präfixe, längere Präfixe kürzere.
+#define API_ROUTES(X) \
+  X(PING,  EXACT,  "",                 OPEN, cmd_ping,          "") \
+  X(HEAP,  EXACT,  "",                 OPEN, cmd_heap,          "") \
+  X(HELP,  PREFIX, "",                 OPEN, cmd_help,          "") \
+  X(SUB,   PREFIX, "",                 OPEN, cmd_sub,           "[since:seq]") \
+  X(UNSUB, PREFIX, "",                 OPEN, cmd_unsub,         "") \
+  /* emit <topic> k=v… – alles außer Owner/State/Interna */ \
+  X(EMIT,  PREFIX, "",                 OPEN, cmd_emit,          "") \
+  X(EMIT,  PREFIX, "trace.",           DENY, nullptr,           "") \
+  X(EMIT,  PREFIX, "drv.",             DENY, nullptr,           "") \
+  X(EMIT,  PREFIX, "sys.",             DENY, nullptr,           "") \
+  X(EMIT,  PREFIX, "pmu.",             DENY, nullptr,           "") \
+  X(EMIT,  EXACT,  "power.mode_changed", DENY, nullptr,         "") \
+  X(EMIT,  EXACT,  "power.last_call",  DENY, nullptr,           "") \
+  /* get */ \
+  X(GET,   EXACT,  "ui.brightness",    OPEN, get_ui_brightness, "") \
+  X(GET,   EXACT,  "time.now",         OPEN, get_time_now,      "") \
+  X(GET,   PREFIX, "",                 OPEN, get_topic,         "[fields:str]") \
+  /* set: Whitelist-Präfixe, harte Sperren als DENY */ \
+  X(SET,   EXACT,  "ui.brightness",    OPEN, set_ui_brightness, "value:int") \
+  X(SET,   PREFIX, "power.",           OPEN, set_topic,         "value:str") \
+  X(SET,   PREFIX, "i2c0.",            OPEN, set_topic,         "value:str") \
+  X(SET,   PREFIX, "backlight.",       OPEN, set_topic,         "value:str") \
+  X(SET,   PREFIX, "log.level.",       OPEN, set_topic,         "value:str") \
+  X(SET,   PREFIX, "console.policy.",  OPEN, set_topic,         "value:str") \
+  X(SET,   PREFIX, "console.rx.",      OPEN, set_topic,         "value:int") \
+  X(SET,   EXACT,  "power.intent",     DENY, nullptr,           "") \
+  X(SET,   EXACT,  "power.mode_changed", DENY, nullptr,         "") \
+  X(SET,   EXACT,  "power.last_call",  DENY, nullptr,           "") \
+  X(SET,   PREFIX, "trace.",           DENY, nullptr,           "") \
+  X(SET,   PREFIX, "drv.",             DENY, nullptr,           "") \
+  X(SET,   PREFIX, "sys.",             DENY, nullptr,           "") \
+  X(SET,   PREFIX, "pmu.",             DENY, nullptr,           "") \
+  /* do */ \
+  X(DO,    EXACT,  "power.ready",      OPEN, do_power,          "") \
+  X(DO,    EXACT,  "power.standby",    OPEN, do_power,          "") \
+  X(DO,    EXACT,  "power.lightsleep", OPEN, do_power,          "") \
+  X(DO,    EXACT,  "power.deepsleep",  OPEN, do_power,          "") \
+  X(DO,    EXACT,  "display.cal",      OPEN, do_display_cal,    "start|stop|next [op:str] [rot:int] [gamma:f]") \
+  X(DO,    EXACT,  "config.save",      OPEN, do_config_save,    "") \
+  X(DO,    EXACT,  "config.reload",    OPEN, do_config_reload,  "") \
+  /* info */ \
+  X(INFO,  EXACT,  "heap",             OPEN, cmd_heap,          "") \
+  X(INFO,  EXACT,  "sys.heap",         OPEN, cmd_heap,          "") \
+  X(INFO,  EXACT,  "bus",              OPEN, info_bus,          "") \
+  X(INFO,  EXACT,  "bus.queue",        OPEN, info_bus_queue,    "") \
+  X(INFO,  EXACT,  "bus.top",          OPEN, info_bus_top,      "[n:int] [reset:bool]") \
+  X(INFO,  EXACT,  "trace",            OPEN, info_trace,        "") \
+  X(INFO,  EXACT,  "console",          OPEN, info_console,      "") \
+  X(INFO,  EXACT,  "config",           OPEN, info_config,       "") \
+  X(INFO,  EXACT,  "config.schema",    OPEN, info_config_schema, "[all:bool]") \
+  X(INFO,  EXACT,  "api",              OPEN, info_api,          "") \
+  X(INFO,  EXACT,  "boot",             OPEN, info_boot,         "[prev:bool]") \
+  X(INFO,  EXACT,  "session",          OPEN, info_session,      "") \
+  /* Konsole: Ausgabemodus, quiet-Modus, Batches */ \
+  X(CONSOLE, PREFIX, "",               OPEN, cmd_console,       "mode:str") \
+  X(CONSOLE, EXACT, "announce",        OPEN, cmd_console_announce, "") \
+  X(SET,   EXACT,  "api.quiet",        OPEN, set_api_quiet,     "value:bool") \
+  X(SET,   EXACT,  "session.monitor",  OPEN, set_session_monitor, "value:bool") \
+  X(SET,   EXACT,  "session.rate",     OPEN, set_session_rate,  "value:u32") \
+  X(BATCH, EXACT,  "begin",            OPEN, batch_begin,       "[quiet:bool]") \
+  X(BATCH, EXACT,  "end",              OPEN, batch_end,         "") \
+  X(BATCH, EXACT,  "abort",            OPEN, batch_abort,       "")
+
+static const Route ROUTES[] = {
+#define API_ROUTE_ROW(verb, match, subj, guard, fn, schema) { V_##verb, M_##match, G_##guard, subj, fn, schema },
+  API_ROUTES(API_ROUTE_ROW)
+#undef API_ROUTE_ROW
+};
+static constexpr size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+// Perfekter Index wird beim Bauen gesucht: zu viele Routen oder kein Seed → Build-Fehler
+static constexpr uint32_t ROUTE_KEYS[] = {
+#define API_ROUTE_KEY(verb, match, subj, guard, fn, schema) route_key(subj, V_##verb, M_##match),
+  API_ROUTES(API_ROUTE_KEY)
+#undef API_ROUTE_KEY
+};
+static_assert(ROUTE_COUNT <= ROUTE_MAX, "API_ROUTES: mehr Routen als ROUTE_MAX");
+static constexpr uint32_t ROUTE_SEED = route_seed(ROUTE_KEYS);
+static_assert(ROUTE_SEED != ROUTE_NO_SEED, "API_ROUTES: kein perfekter Seed – ROUTE_SLOT_BITS erhöhen");
+
+static void build_routes() { routes_build(ROUTES, ROUTE_COUNT, ROUTE_SEED); }
+
+// help               → Verben aus der Tabelle
+// help <verb>        → eine Zeile je Route: help <verb> <subject>[*] [schema|protected]
+static void cmd_help(const Tokens& t, const Route&) {
+  if (t.subj.empty()) {
+    char buf[96];
+    size_t n = snprintf(buf, sizeof(buf), "ok cmds=");
+    for (uint8_t v = 0; v < VERB_COUNT; ++v) {
+      n += snprintf(buf + n, sizeof(buf) - n, "%s%s", v ? "," : "", verb_name((Verb)v));
+    }
+    ok(String(buf));
     return;
   }
 
-  errc("E_UNKNOWN", "unknown subject");
+  Verb v;
+  if (!verb_of(t.subj, v)) { errc("E_UNKNOWN", "unknown verb"); return; }
+  unsigned n = 0;
+  for (const Route& r : ROUTES) {
+    if (r.verb != v) continue;
+    const char* star = r.match == M_PREFIX ? "*" : "";
+    if (r.guard == G_DENY) okf("help %s %s%s protected", verb_name(v), r.subj, star);
+    else okf("help %s %s%s%s%s", verb_name(v), r.subj, star, *r.schema ? " " : "", r.schema);
+    ++n;
+  }
+  okf("ok help verb=%s n=%u", verb_name(v), n);
 }
 
 // ---------------------------------------------------------------------------
 // Router
-void handleLine(const String& raw) {
-  String line = raw; line.trim();
-  if (!line.length()) return;
+// Ein Befehl: zerlegen, id= abtrennen, Route suchen, Schema prüfen, ausführen
+static void run_one(const char* line, size_t n) {
+  Tokens& t = s_tok;
+  s_req = {};
+  switch (tokenize(line, n, t)) {
+    case TOK_OK:       break;
+    case TOK_EMPTY:    return;
+    case TOK_TOO_LONG: ++s_cmds; errc("E_SYNTAX", "line too long"); return;
+    case TOK_QUOTE:    ++s_cmds; errc("E_SYNTAX", "unbalanced quote"); return;
+    case TOK_TOO_MANY: ++s_cmds; errc("E_SYNTAX", "too many arguments"); return;
+    case TOK_CTRL:     ++s_cmds; errc("E_SYNTAX", "bad character"); return;
+  }
+  ++s_cmds;
 
-  if (line == "ping") { ok("ok pong"); return; }
-  if (line == "help") { ok("ok cmds=ping,heap,sub,unsub,emit,get,set,do,info"); return; }
-  if (line == "heap") { ok("ok heap free=" + String((unsigned)ESP.getFreeHeap())); return; }
+  Span idv;
+  if (t.take("id", idv)) {
+    if (!span_u32(idv, s_req.id)) { errc("E_SYNTAX", "bad id"); return; }
+    s_req.has_id = true;
+  }
+
+  Verb v;
+  if (!verb_of(t.verb, v)) { errc("E_UNKNOWN", "unknown verb"); return; }
+  s_req.mute_ok = s_quiet[s_cur] && (v == V_SET || v == V_DO || v == V_EMIT || v == V_UNSUB);
+
+  const Route* r = route_find(v, t.subj);
+  if (!r) { errc("E_UNKNOWN", "unknown subject"); return; }
+  if (r->guard == G_DENY) {
+    errc("E_FORBIDDEN", v == V_SET ? "set to protected topic" : "emit to protected topic");
+    return;
+  }
 
-  int sp = line.indexOf(' ');
-  String verb = (sp < 0) ? line : line.substring(0, sp);
-  String rest = (sp < 0) ? ""   : line.substring(sp + 1);
+  char msg[48];
+  if (!schema_check(r->schema, t, msg, sizeof(msg))) { errc("E_SYNTAX", msg); return; }
+  r->fn(t, *r);
+}
+
+// Eine Zeile: "a; b; c" → Befehle nacheinander (';' in Quotes zählt nicht), danach Bilanz
+static void run_line(const char* line, size_t n) {
+  size_t a = 0, parts = 0;
+  bool q = false;
+  const uint32_t cmds0 = s_cmds, errs0 = s_errs;
+  for (size_t i = 0; i <= n; ++i) {
+    if (i < n) {
+      if (line[i] == '\\' && q) { ++i; continue; }
+      if (line[i] == '"') q = !q;
+      if (line[i] != ';' || q) continue;
+    }
+    if (i == n && !parts) { run_one(line, n); break; }   // Normalfall: kein ';'
+    run_one(line + a, i - a);
+    ++parts;
+    a = i + 1;
+  }
+  s_req = {};
+  if (parts) okf("ok batch n=%u errors=%u", (unsigned)(s_cmds - cmds0), (unsigned)(s_errs - errs0));
+}
 
-  String subj, args;
-  if (rest.length()) {
-    int sp2 = rest.indexOf(' ');
-    subj = (sp2 < 0) ? rest : rest.substring(0, sp2);
-    args = (sp2 < 0) ? ""   : rest.substring(sp2 + 1);
+void handleLine(uint8_t sid, const char* line, size_t n) {
+  if (!session::valid(sid)) return;
+  console::Reply reply;                            // Ausgabe des Befehls = Antwort (auch evt trace.…)
+  s_cur = sid;
+  if (s_batch.open && s_batch.owner == sid) {
+    // Nur "batch …" wird sofort ausgeführt, alles andere gesammelt
+    Tokens& t = s_tok;
+    if (tokenize(line, n, t) != TOK_OK || !t.verb.eq("batch")) { batch_collect(line, n); return; }
   }
+  run_line(line, n);
+  s_cur = session::CONSOLE;
+}
+
+void handleLine(const char* line, size_t n) { handleLine(session::CONSOLE, line, n); }
+void handleLine(const String& line) { handleLine(session::CONSOLE, line.c_str(), line.length()); }
+
+uint8_t open_session(const char* name, sink_fn out, size_t ring) {
+  return out ? session::open(name, out) : session::open_ring(name, ring ? ring : session::RING_DEFAULT);
+}
+
+void close_session(uint8_t sid) {
+  if (sid == session::CONSOLE || !session::valid(sid)) return;
+  drop_trace_subs(sid);
+  if (s_batch.open && s_batch.owner == sid) s_batch.open = false;
+  s_quiet[sid] = false;
+  session::close(sid);
+}
 
-  if (verb == "sub")   { cmd_sub(rest);   return; }
-  if (verb == "unsub") { cmd_unsub(rest); return; }
-  if (verb == "emit")  { cmd_emit(rest);  return; } // Intent-Emit (mit Guard)
+bool prompt_wanted(uint8_t sid) {
+  return sid < session::MAX && !s_quiet[sid] && !(s_batch.open && s_batch.owner == sid);
+}
 
-  if (verb == "get")  { do_get(subj, args);  return; }
-  if (verb == "set")  { do_set(subj, args);  return; }
-  if (verb == "do")   { do_do(subj, args);   return; }
-  if (verb == "info") { do_info(subj, args); return; }
+static_assert(session::MAX <= 8, "Session-Bitmaske in poll()");
 
-  errc("E_UNKNOWN", "unknown verb");
+void poll() {
+  if (s_trace_subs.empty()) { s_trace_live.next = trace::written() + 1; return; }
+  uint32_t lost = 0;
+  trace::Record r;
+  for (size_t i = 0; i < TRACE_POLL_MAX && trace::read(s_trace_live, r, &lost); ++i) {
+    uint8_t sent = 0;                              // je Session höchstens einmal
+    for (const TraceSub& s : s_trace_subs) {
+      if ((sent >> s.sid & 1) || !bus::matches(s.pattern, r.topic)) continue;
+      sent |= (uint8_t)(1u << s.sid);
+      out_record(s.sid, r);
+    }
+  }
+  if (!lost) return;
+  uint8_t sent = 0;
+  for (const TraceSub& s : s_trace_subs) {
+    if (sent >> s.sid & 1) continue;
+    sent |= (uint8_t)(1u << s.sid);
+    session::write(s.sid, "evt trace.lost n=" + String(lost));
+  }
 }
 
 } // namespace api
@@ -12,7 +12,31 @@ using sink_fn = void (*)(const String& line);
 // Parser initialisieren
 void init(sink_fn out);
 
-// Eine komplette Eingabezeile verarbeiten (ohne CR/LF)
+// Eine komplette Eingabezeile verarbeiten (ohne CR/LF). Zerlegung ohne Heap
+// (api_tokenizer); max. CONSOLE_LINE_MAX Zeichen je Befehl (= RX-Grenze), sonst err E_SYNTAX.
+//   id=<u32>            an jedem Befehl; alle Antwortzeilen tragen dann " id=<u32>" als letztes Feld
+//   a; b; c             mehrere Befehle, danach "ok batch n=.. errors=.."
+//   batch begin [quiet=1] … batch end   Block sammeln, bei end in einem Durchlauf
+//   set api.quiet value=on              ok-Antworten von set/do/emit/unsub unterdrücken
+void handleLine(const char* line, size_t n);
 void handleLine(const String& line);
 
+// Zeile einer weiteren Session (session.hpp): Antworten, Abos, quiet und Batch
+// gehören dieser Session; die Varianten oben sind die USB-Konsole (CONSOLE).
+//   set session.monitor value=on|off    alle Events statt nur der abonnierten
+//   set session.rate value=<n/s>        Event-Limit (0 = aus), Antworten nie
+//   info session                        Sessions mit Abos, Zeilen, Drops
+void handleLine(uint8_t sid, const char* line, size_t n);
+
+// Session öffnen: out = eigene Zeilensenke, sonst Ring (read via session::read_line).
+// Rückgabe session::NONE, wenn alle Slots belegt sind. close entfernt auch Abos.
+uint8_t open_session(const char* name, sink_fn out, size_t ring = 0);
+void    close_session(uint8_t sid);
+
+// false während eines offenen Batches oder im quiet-Modus (main spart den Prompt)
+bool prompt_wanted(uint8_t sid = 0);
+
+// Aus loop(): neue Trace-Records an Konsolen-Abos (sub trace.*) ausgeben
+void poll();
+
 } // namespace api
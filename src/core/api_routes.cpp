@@ -0,0 +1,218 @@
+// src/core/api_routes.cpp
+#include "api_routes.hpp"
+#include "topics.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+namespace api {
+
+static constexpr size_t   SLOTS      = ROUTE_SLOTS;
+static constexpr uint8_t  EMPTY      = 0xFF;
+static constexpr size_t   MAX_DOTS   = 8;                 // Präfix-Stufen je Subject
+
+static const char* const VERB_NAMES[VERB_COUNT] = {
+#define API_VERB_NAME(id, name) name,
+  API_VERBS(API_VERB_NAME)
+#undef API_VERB_NAME
+};
+static constexpr uint32_t VERB_HASH[VERB_COUNT] = {
+#define API_VERB_HASH(id, name) bus::fnv1a(name, bus::cstr_len(name)),
+  API_VERBS(API_VERB_HASH)
+#undef API_VERB_HASH
+};
+
+static const Route* s_table = nullptr;
+static size_t       s_n     = 0;
+static uint8_t      s_slot[SLOTS];
+static uint32_t     s_seed  = 0;
+static bool         s_perfect = false;
+
+// ---------------------------------------------------------------------------
+// Verben
+bool verb_of(const Span& s, Verb& out) {
+  const uint32_t h = bus::fnv1a(s.p, s.n);
+  for (uint8_t v = 0; v < VERB_COUNT; ++v) {
+    if (VERB_HASH[v] == h && s.eq(VERB_NAMES[v])) { out = (Verb)v; return true; }
+  }
+  return false;
+}
+
+const char* verb_name(Verb v) { return v < VERB_COUNT ? VERB_NAMES[v] : "?"; }
+
+bool seq_of(const Span& v, uint32_t& epoch, uint32_t& seq) {
+  const char* colon = (const char*)memchr(v.p, ':', v.n);
+  const char* s = colon ? colon + 1 : v.p;
+  const size_t sn = v.n - (s - v.p);
+  uint64_t x = 0;
+  uint32_t e = 0;
+  if (colon) {
+    const size_t en = colon - v.p;
+    if (!en || en > 8) return false;
+    for (size_t i = 0; i < en; ++i) {
+      const char c = v.p[i];
+      const int d = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                  : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+      if (d < 0) return false;
+      e = e << 4 | (uint32_t)d;
+    }
+  }
+  if (!sn || sn > 10) return false;
+  for (size_t i = 0; i < sn; ++i) {
+    if (s[i] < '0' || s[i] > '9') return false;
+    x = x * 10 + (uint64_t)(s[i] - '0');
+  }
+  if (x > 0xFFFFFFFFull) return false;
+  epoch = e;
+  seq   = (uint32_t)x;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Index
+static inline uint32_t route_key(const Route& r) {
+  return route_key(bus::fnv1a(r.subj, strlen(r.subj)), r.verb, r.match);
+}
+
+// true, wenn alle Einträge ohne Kollision auf ihrem Heimat-Slot landen
+static bool place(uint32_t seed, bool probe) {
+  memset(s_slot, EMPTY, sizeof(s_slot));
+  bool perfect = true;
+  for (size_t i = 0; i < s_n; ++i) {
+    size_t h = route_home(route_key(s_table[i]), seed);
+    if (s_slot[h] != EMPTY) {
+      if (!probe) return false;
+      perfect = false;
+      while (s_slot[h] != EMPTY) h = (h + 1) & (SLOTS - 1);
+    }
+    s_slot[h] = (uint8_t)i;
+  }
+  return perfect;
+}
+
+bool routes_build(const Route* table, size_t n, uint32_t seed) {
+  if (n > ROUTE_MAX) { s_table = nullptr; s_n = 0; return false; }   // nie kürzen: lieber gar kein Routing
+  s_table = table;
+  s_n     = n;
+  s_seed  = seed;
+  s_perfect = seed != ROUTE_NO_SEED && place(seed, false);
+  if (!s_perfect) { s_seed = 0; place(0, true); }   // Fallback: lineares Sondieren
+  return s_perfect;
+}
+
+static const Route* lookup(uint32_t subj_h, uint8_t verb, uint8_t match, const char* s, size_t n) {
+  size_t h = route_home(route_key(subj_h, verb, match), s_seed);
+  for (size_t probe = 0; probe < SLOTS; ++probe, h = (h + 1) & (SLOTS - 1)) {
+    const uint8_t i = s_slot[h];
+    if (i == EMPTY) return nullptr;
+    const Route& r = s_table[i];
+    if (r.verb == verb && r.match == match && strlen(r.subj) == n && memcmp(r.subj, s, n) == 0) return &r;
+    if (s_perfect) return nullptr;
+  }
+  return nullptr;
+}
+
+const Route* route_find(Verb v, const Span& subj) {
+  if (!s_table) return nullptr;
+
+  // Ein Durchlauf: FNV-Zwischenstände an jedem '.' sind die Präfix-Hashes
+  uint32_t pre_h[MAX_DOTS];
+  uint16_t pre_n[MAX_DOTS];
+  size_t   np = 0;
+  uint32_t h = 2166136261u;
+  for (uint16_t i = 0; i < subj.n; ++i) {
+    h ^= (uint8_t)subj.p[i]; h *= 16777619u;
+    if (subj.p[i] == '.' && np < MAX_DOTS) { pre_h[np] = h; pre_n[np] = i + 1; ++np; }
+  }
+
+  if (const Route* r = lookup(h, v, M_EXACT, subj.p, subj.n)) return r;
+  while (np--) {
+    if (const Route* r = lookup(pre_h[np], v, M_PREFIX, subj.p, pre_n[np])) return r;
+  }
+  return lookup(2166136261u, v, M_PREFIX, "", 0);
+}
+
+void route_stats(RouteStats& out) {
+  out.routes  = (uint16_t)s_n;
+  out.slots   = (uint16_t)SLOTS;
+  out.seed    = s_seed;
+  out.perfect = s_perfect;
+}
+
+// ---------------------------------------------------------------------------
+// Schema
+static bool type_ok(const char* ty, size_t tn, const Span& v) {
+  auto is = [&](const char* lit) { return strlen(lit) == tn && memcmp(ty, lit, tn) == 0; };
+  char tmp[24];
+  if (is("str") || is("pattern")) return v.n > 0;
+  if (is("seq")) { uint32_t e, s; return seq_of(v, e, s); }
+  if (is("bool")) return v.eq("0") || v.eq("1") || v.eq("on") || v.eq("off") ||
+                         v.eq("true") || v.eq("false") || v.eq("yes") || v.eq("no");
+  if (!v.n || v.n >= sizeof(tmp)) return false;
+  memcpy(tmp, v.p, v.n); tmp[v.n] = 0;
+  char* end = nullptr;
+  if (is("u32")) {
+    if (tmp[0] < '0' || tmp[0] > '9') return false;
+    strtoul(tmp, &end, 10);
+    return *end == 0 && v.n <= 10;
+  }
+  if (is("int")) {
+    const bool hex = v.n > 2 && tmp[0] == '0' && (tmp[1] == 'x' || tmp[1] == 'X');
+    strtol(tmp, &end, hex ? 16 : 10);
+    return end != tmp && *end == 0;
+  }
+  if (is("f")) { strtof(tmp, &end); return end != tmp && *end == 0; }
+  return true;                      // unbekannter Typ: nur Hilfe-Text
+}
+
+bool schema_check(const char* schema, const Tokens& t, char* msg, size_t cap) {
+  const char* s = schema ? schema : "";
+  bool alt_seen = false, alt_ok = false;
+  while (*s) {
+    while (*s == ' ') ++s;
+    if (!*s) break;
+    const char* a = s;
+    while (*s && *s != ' ') ++s;
+    size_t n = s - a;
+
+    const bool opt = *a == '[';
+    if (opt) { ++a; n = n >= 2 ? n - 2 : 0; }
+
+    const char* colon = (const char*)memchr(a, ':', n);
+    if (!colon) {                                   // a|b|c → freies Wort
+      alt_seen = true;
+      if (t.npos) {
+        const char* w = a;
+        const char* e = a + n;
+        while (w < e && !alt_ok) {
+          const char* bar = (const char*)memchr(w, '|', e - w);
+          const size_t wn = (bar ? bar : e) - w;
+          alt_ok = wn == t.pos[0].n && memcmp(w, t.pos[0].p, wn) == 0;
+          w = bar ? bar + 1 : e;
+        }
+      }
+      continue;
+    }
+
+    const size_t kn = colon - a;
+    const KV* kv = nullptr;
+    for (uint8_t i = 0; i < t.nkv && !kv; ++i) {
+      if (t.kv[i].key.n == kn && memcmp(t.kv[i].key.p, a, kn) == 0) kv = &t.kv[i];
+    }
+    if (!kv) {
+      if (opt) continue;
+      snprintf(msg, cap, "missing %.*s", (int)kn, a);
+      return false;
+    }
+    if (!type_ok(colon + 1, n - kn - 1, kv->val)) {
+      snprintf(msg, cap, "bad %.*s", (int)kn, a);
+      return false;
+    }
+  }
+  if (alt_seen && t.npos && !alt_ok) {
+    snprintf(msg, cap, "bad argument %.*s", (int)t.pos[0].n, t.pos[0].p);
+    return false;
+  }
+  return true;
+}
+
+} // namespace api
@@ -0,0 +1,110 @@
+// src/core/api_routes.hpp
+// Routing-Tabelle der Konsole: jede Zeile (verb, subject|prefix, handler,
+// Argument-Schema, Schutzklasse) steht einmal in API_ROUTES (api_parser.cpp).
+// Den Seed, bei dem jeder Eintrag auf seinem Heimat-Slot liegt (perfekter Hash),
+// sucht der Compiler (route_seed, static_assert in api_parser.cpp); build() legt
+// damit den Index an → find() ist ein Hash-Durchlauf über das Subject plus je
+// ein Slot-Vergleich für
+//   exakt → längster Präfix (an '.') → Verb-Default (Präfix "").
+// Neue Endpunkte machen bestehende Befehle nicht langsamer.
+//
+// Schema (nur Hilfe + Pflicht/Typ-Prüfung), Leerzeichen-getrennt:
+//   key:type      Pflicht          [key:type]  optional
+//   a|b|c         freies Wort (optional, eine der Alternativen)
+//   Typen: int, u32, bool, str, f, pattern, seq (<epoch hex>:<u32>)
+
+#pragma once
+#include <Arduino.h>
+#include "api_tokenizer.hpp"
+#include "topics.hpp"
+
+namespace api {
+
+#define API_VERBS(X) \
+  X(GET, "get") X(SET, "set") X(DO, "do") X(INFO, "info") \
+  X(SUB, "sub") X(UNSUB, "unsub") X(EMIT, "emit") \
+  X(PING, "ping") X(HELP, "help") X(HEAP, "heap") X(BATCH, "batch") \
+  X(CONSOLE, "console")
+
+enum Verb : uint8_t {
+#define API_VERB_ENUM(id, name) V_##id,
+  API_VERBS(API_VERB_ENUM)
+#undef API_VERB_ENUM
+  VERB_COUNT
+};
+
+enum Match : uint8_t { M_EXACT = 0, M_PREFIX };   // Präfix endet auf '.' oder ist "" (Default)
+enum Guard : uint8_t { G_OPEN = 0, G_DENY };      // G_DENY: geschütztes Topic, kein Handler
+
+struct Route;
+using route_fn = void (*)(const Tokens& t, const Route& r);
+
+struct Route {
+  uint8_t     verb;
+  uint8_t     match;
+  uint8_t     guard;
+  const char* subj;
+  route_fn    fn;
+  const char* schema;
+};
+
+struct RouteStats {
+  uint16_t routes;
+  uint16_t slots;
+  uint32_t seed;
+  bool     perfect;   // alle Einträge auf dem Heimat-Slot
+};
+
+// ---------------------------------------------------------------------------
+// Index: 1024 Slots (1 Byte je Slot). Bei 55 Routen trifft etwa jeder vierte
+// Seed perfekt; ROUTE_SEED_TRIES reicht so bis weit über 100 Routen.
+static constexpr size_t   ROUTE_SLOT_BITS  = 10;
+static constexpr size_t   ROUTE_SLOTS      = 1u << ROUTE_SLOT_BITS;
+static constexpr size_t   ROUTE_MAX        = ROUTE_SLOTS / 8;   // Füllgrad ≤ 1/8, Index uint8_t
+static constexpr uint32_t ROUTE_SEED_TRIES = 4096;
+static constexpr uint32_t ROUTE_NO_SEED    = 0xFFFFFFFFu;
+static_assert(ROUTE_MAX < 0xFF && ROUTE_MAX <= ROUTE_SLOTS / 2, "Slot-Index ist uint8_t (0xFF = leer)");
+
+constexpr uint32_t route_key(uint32_t subj_h, uint8_t verb, uint8_t match) {
+  return (subj_h ^ ((uint32_t)verb << 1 | match)) * 16777619u;
+}
+constexpr uint32_t route_key(const char* subj, uint8_t verb, uint8_t match) {
+  return route_key(bus::fnv1a(subj, bus::cstr_len(subj)), verb, match);
+}
+constexpr size_t route_home(uint32_t key, uint32_t seed) {
+  return (size_t)(((key ^ seed) * 0x9E3779B1u) >> (32 - ROUTE_SLOT_BITS));
+}
+
+// Erster Seed ohne Slot-Kollision, sonst ROUTE_NO_SEED (Compile-Zeit)
+template <size_t N>
+constexpr uint32_t route_seed(const uint32_t (&keys)[N]) {
+  uint32_t used[ROUTE_SLOTS] = {};   // = seed + 1 → kein Löschen je Versuch
+  for (uint32_t seed = 0; seed < ROUTE_SEED_TRIES; ++seed) {
+    bool ok = true;
+    for (size_t i = 0; i < N && ok; ++i) {
+      const size_t h = route_home(keys[i], seed);
+      if (used[h] == seed + 1) ok = false;
+      used[h] = seed + 1;
+    }
+    if (ok) return seed;
+  }
+  return ROUTE_NO_SEED;
+}
+
+bool        verb_of(const Span& s, Verb& out);
+const char* verb_name(Verb v);
+
+// Sticky-Cursor aus seq=: "<epoch hex>:<seq>"; nur "<seq>" → epoch = 0 (unbekannt)
+bool seq_of(const Span& v, uint32_t& epoch, uint32_t& seq);
+
+// Index aus der (statischen) Tabelle mit dem Compile-Zeit-Seed aufbauen; einmal
+// in api::init(). false = Seed passt nicht zur Tabelle → lineares Sondieren
+// (korrekt, aber perfect=false in info api).
+bool         routes_build(const Route* table, size_t n, uint32_t seed);
+const Route* route_find(Verb v, const Span& subj);
+void         route_stats(RouteStats& out);
+
+// Argumente gegen das Schema prüfen; false → err (Text in msg, max. cap Zeichen)
+bool schema_check(const char* schema, const Tokens& t, char* msg, size_t cap);
+
+} // namespace api
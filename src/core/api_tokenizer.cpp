@@ -0,0 +1,132 @@
+// src/core/api_tokenizer.cpp
+#include "api_tokenizer.hpp"
+#include <string.h>
+
+namespace api {
+
+const KV* Tokens::find(const char* key) const {
+  for (uint8_t i = 0; i < nkv; ++i) if (kv[i].key.eq(key)) return &kv[i];
+  return nullptr;
+}
+
+bool Tokens::get(const char* key, Span& out) const {
+  const KV* e = find(key);
+  if (!e) return false;
+  out = e->val;
+  return true;
+}
+
+// Steht das Paar am Zeilenende (üblich für id=), endet args davor → Freitext-Payloads
+// sehen es nicht mehr.
+bool Tokens::take(const char* key, Span& out) {
+  for (uint8_t i = 0; i < nkv; ++i) {
+    if (!kv[i].key.eq(key)) continue;
+    out = kv[i].val;
+    const char* end = args.p + args.n;
+    if (!kv[i].quoted && out.p + out.n == end) {
+      uint16_t n = (uint16_t)(kv[i].key.p - args.p);
+      while (n && args.p[n - 1] == ' ') --n;
+      args.n = n;
+    }
+    memmove(&kv[i], &kv[i + 1], (nkv - i - 1) * sizeof(KV));
+    --nkv;
+    return true;
+  }
+  return false;
+}
+
+static inline Span span(const char* p, size_t n) {
+  Span s; s.p = p; s.n = (uint16_t)n;
+  return s;
+}
+
+// "…" ab s[i] (auf dem öffnenden Quote). Ohne Escapes zeigt der Span in buf,
+// sonst in esc (aufgelöst). i steht danach hinter dem schließenden Quote.
+static bool scan_quoted(const char* s, size_t n, size_t& i, char* esc, size_t& esc_n, Span& out) {
+  const size_t a = ++i;
+  bool escaped = false;
+  while (i < n && s[i] != '"') {
+    if (s[i] == '\\' && i + 1 < n) { escaped = true; ++i; }
+    ++i;
+  }
+  if (i >= n) return false;                          // kein schließendes Quote
+  const size_t e = i++;
+  if (i < n && s[i] != ' ') return false;            // "abc"xyz
+  if (!escaped) { out = span(s + a, e - a); return true; }
+
+  char* d = esc + esc_n;
+  size_t m = 0;
+  for (size_t j = a; j < e; ++j) {
+    if (s[j] == '\\' && j + 1 < e) ++j;
+    d[m++] = s[j];
+  }
+  esc_n += m;
+  out = span(d, m);
+  return true;
+}
+
+TokErr tokenize(const char* line, size_t n, Tokens& out) {
+  out.verb = out.subj = out.args = Span();
+  out.nkv = out.npos = 0;
+
+  // Trim (wie String::trim: Whitespace und CR/LF)
+  while (n && (unsigned char)line[0] <= ' ') { ++line; --n; }
+  while (n && (unsigned char)line[n - 1] <= ' ') --n;
+  if (!n) return TOK_EMPTY;
+  if (n >= Tokens::LINE_MAX) return TOK_TOO_LONG;
+
+  char* s = out.buf;
+  for (size_t j = 0; j < n; ++j) {
+    const unsigned char c = (unsigned char)line[j];
+    if (c < ' ' || c == 0x7F) {
+      if (c != '\t') return TOK_CTRL;
+      s[j] = ' ';
+    } else {
+      s[j] = (char)c;
+    }
+  }
+  s[n] = 0;
+  size_t esc_n = 0;
+
+  size_t i = 0;
+  auto skip_ws = [&] { while (i < n && s[i] == ' ') ++i; };
+  auto word    = [&] { const size_t a = i; while (i < n && s[i] != ' ') ++i; return span(s + a, i - a); };
+
+  out.verb = word();
+  skip_ws();
+  if (i >= n) return TOK_OK;
+  // Subject nur, wenn das Wort kein key=value ist ("ping id=7")
+  const char* eq = (const char*)memchr(s + i, '=', n - i);
+  const char* sp = (const char*)memchr(s + i, ' ', n - i);
+  if (!eq || (sp && sp < eq)) {
+    out.subj = word();
+    skip_ws();
+  }
+  if (i < n) out.args = span(s + i, n - i);
+
+  while (i < n) {
+    const size_t a = i;
+    while (i < n && s[i] != ' ' && s[i] != '=') ++i;
+
+    if (i < n && s[i] == '=' && i > a) {             // key=value
+      if (out.nkv >= Tokens::MAX_KV) return TOK_TOO_MANY;
+      KV& e = out.kv[out.nkv];
+      e.key = span(s + a, i - a);
+      ++i;
+      e.quoted = i < n && s[i] == '"';
+      if (e.quoted) { if (!scan_quoted(s, n, i, out.esc, esc_n, e.val)) return TOK_QUOTE; }
+      else          e.val = word();
+      ++out.nkv;
+    } else {                                         // freies Wort
+      i = a;
+      if (out.npos >= Tokens::MAX_POS) return TOK_TOO_MANY;
+      if (s[i] == '"') { if (!scan_quoted(s, n, i, out.esc, esc_n, out.pos[out.npos])) return TOK_QUOTE; }
+      else             out.pos[out.npos] = word();
+      ++out.npos;
+    }
+    skip_ws();
+  }
+  return TOK_OK;
+}
+
+} // namespace api
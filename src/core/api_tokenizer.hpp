@@ -0,0 +1,58 @@
+// src/core/api_tokenizer.hpp
+// Zerlegt eine Konsolenzeile in einem Durchlauf, ohne Heap:
+//   <verb> [<subject>] [word | key=value | key="quoted value"]*
+// Die Zeile wird in einen festen Puffer kopiert; alle Tokens sind Spans darauf.
+// Quotes: "…" mit \" und \\ als Escape; nur Werte mit Escapes werden aufgelöst
+// in einen zweiten Puffer kopiert, args bleibt Rohtext. Keys werden exakt
+// verglichen → "value" trifft nicht "xvalue=".
+
+#pragma once
+#include <Arduino.h>
+#include "console.hpp"
+
+namespace api {
+
+struct Span {
+  const char* p = "";
+  uint16_t    n = 0;
+
+  bool   empty() const { return n == 0; }
+  bool   eq(const char* lit) const { return strlen(lit) == n && memcmp(p, lit, n) == 0; }
+  bool   starts_with(const char* lit) const { const size_t m = strlen(lit); return m <= n && memcmp(p, lit, m) == 0; }
+  String str() const { return String(p, n); }
+};
+
+struct KV {
+  Span key;
+  Span val;
+  bool quoted;
+};
+
+struct Tokens {
+  static constexpr size_t LINE_MAX = CONSOLE_LINE_MAX + 1;   // jede RX-Zeile + '\0'
+  static constexpr size_t MAX_KV   = 12;
+  static constexpr size_t MAX_POS  = 6;    // freie Wörter nach dem Subject
+
+  char    buf[LINE_MAX];
+  char    esc[LINE_MAX];      // aufgelöste Quote-Werte
+  Span    verb;
+  Span    subj;
+  Span    args;               // Rohtext nach dem Subject (getrimmt)
+  KV      kv[MAX_KV];
+  uint8_t nkv = 0;
+  Span    pos[MAX_POS];
+  uint8_t npos = 0;
+
+  const KV* find(const char* key) const;
+  bool      get(const char* key, Span& out) const;
+  bool      has(const char* key) const { return find(key) != nullptr; }
+  bool      take(const char* key, Span& out);   // entfernen (z. B. id=), args ggf. kürzen
+};
+
+enum TokErr : uint8_t { TOK_OK = 0, TOK_EMPTY, TOK_TOO_LONG, TOK_QUOTE, TOK_TOO_MANY, TOK_CTRL };
+
+// Zeilen ab LINE_MAX Zeichen → TOK_TOO_LONG, unbalancierte Quotes → TOK_QUOTE,
+// Steuerzeichen (außer Tab = Leerzeichen) → TOK_CTRL: Antworten bleiben einzeilig.
+TokErr tokenize(const char* line, size_t n, Tokens& out);
+
+} // namespace api
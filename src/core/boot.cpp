@@ -0,0 +1,209 @@
+// src/core/boot.cpp
+// Boot-Timeline, siehe boot.hpp.
+//
+// Datei /logs/boot.last (ein write, tmp + rename):
+//   u32 magic "TWB1" | u32 ready_us | u16 n | n × { char name[16], u32 start_us, u32 end_us }
+#include "boot.hpp"
+#include <FS.h>
+#include <LittleFS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <string.h>
+
+namespace boot {
+
+static const char* const NAMES[PHASE_COUNT] = {
+#define BOOT_PHASE_NAME(id, name) name,
+  BOOT_PHASES(BOOT_PHASE_NAME)
+#undef BOOT_PHASE_NAME
+};
+
+static constexpr uint32_t MAGIC = 0x31425754;   // "TWB1"
+static const char TMP[] = "/logs/boot.tmp";
+
+struct Rec {
+  char     name[NAME_MAX];
+  uint32_t start_us;
+  uint32_t end_us;
+};
+
+static uint32_t s_start[PHASE_COUNT];
+static uint32_t s_end[PHASE_COUNT];
+static uint8_t  s_order[PHASE_COUNT];     // Startreihenfolge
+static uint8_t  s_n = 0;
+static uint32_t s_ready_us = 0;
+static uint32_t s_window_ms = 0;
+
+static Rec      s_prev[PHASE_COUNT];
+static uint8_t  s_prev_n = 0;
+static uint32_t s_prev_ready_us = 0;
+static bool     s_prev_loaded = false;
+
+// Stages: work-Zeiten schreibt nur der Task, vor dem Bit in s_worked (release)
+static const Stage*         s_stages = nullptr;
+static uint8_t              s_stage_n = 0;
+static uint32_t             s_work_start[STAGE_MAX];
+static uint32_t             s_work_end[STAGE_MAX];   // Ende = work() zurück, nicht der poll()-Zeitpunkt
+static std::atomic<uint8_t> s_worked{0};
+static uint8_t              s_done = 0;      // nur loop-Task
+
+void begin(Phase p) {
+  if (p >= PHASE_COUNT) return;
+  if (!s_start[p] && !s_end[p]) s_order[s_n++] = p;   // erste Messung einer Phase zählt
+  s_start[p] = micros();
+  if (!s_start[p]) s_start[p] = 1;
+  s_end[p] = 0;
+}
+
+void end(Phase p) {
+  if (p >= PHASE_COUNT || !s_start[p]) return;
+  s_end[p] = micros();
+  if (s_end[p] <= s_start[p]) s_end[p] = s_start[p] + 1;
+}
+
+void set_window_ms(uint32_t ms) { s_window_ms = ms; }
+uint32_t window_ms() { return s_window_ms; }
+
+static void load_prev() {
+  s_prev_n = 0;
+  s_prev_ready_us = 0;
+  if (!LittleFS.exists(PATH)) return;
+  File f = LittleFS.open(PATH, "r");
+  if (!f) return;
+  uint8_t head[10];
+  if (f.read(head, sizeof(head)) == sizeof(head)) {
+    uint32_t magic; uint16_t n;
+    memcpy(&magic, head, 4);
+    memcpy(&s_prev_ready_us, head + 4, 4);
+    memcpy(&n, head + 8, 2);
+    if (magic == MAGIC && n <= PHASE_COUNT && f.read((uint8_t*)s_prev, n * sizeof(Rec)) == n * sizeof(Rec)) {
+      for (uint16_t i = 0; i < n; ++i) s_prev[i].name[NAME_MAX - 1] = 0;
+      s_prev_n = (uint8_t)n;
+    } else {
+      s_prev_ready_us = 0;
+    }
+  }
+  f.close();
+}
+
+static void store() {
+  uint8_t buf[10 + PHASE_COUNT * sizeof(Rec)];
+  const uint16_t n = s_n;
+  memcpy(buf, &MAGIC, 4);
+  memcpy(buf + 4, &s_ready_us, 4);
+  memcpy(buf + 8, &n, 2);
+  for (uint8_t i = 0; i < s_n; ++i) {
+    Rec r = {};
+    const uint8_t p = s_order[i];
+    strncpy(r.name, NAMES[p], NAME_MAX - 1);
+    r.start_us = s_start[p];
+    r.end_us   = s_end[p];
+    memcpy(buf + 10 + i * sizeof(Rec), &r, sizeof(r));
+  }
+  const size_t len = 10 + n * sizeof(Rec);
+
+  LittleFS.mkdir("/logs");
+  File f = LittleFS.open(TMP, "w");
+  if (!f) return;
+  const size_t w = f.write(buf, len);
+  f.close();
+  if (w != len || !LittleFS.rename(TMP, PATH)) LittleFS.remove(TMP);
+}
+
+void ready() {
+  if (!s_ready_us) s_ready_us = micros();
+  if (!s_prev_loaded) { load_prev(); s_prev_loaded = true; }
+  store();
+}
+
+// ---------------------------------------------------------------------------
+// Stages
+static void run_work(uint8_t i) {
+  s_work_start[i] = micros();
+  if (s_stages[i].work) s_stages[i].work();
+  s_work_end[i] = micros();
+  s_worked.fetch_or((uint8_t)(1u << i), std::memory_order_release);
+}
+
+static void stage_task(void*) {
+  for (uint8_t i = 0; i < s_stage_n; ++i) run_work(i);   // Tabelle ist topologisch sortiert
+  vTaskDelete(nullptr);
+}
+
+void stages_begin(const Stage* st, size_t n) {
+  if (s_stages || !st) return;
+  s_stages  = st;
+  s_stage_n = (uint8_t)(n < STAGE_MAX ? n : STAGE_MAX);
+  if (xTaskCreatePinnedToCore(stage_task, "boot_stg", 4096, nullptr, 1, nullptr, 1) != pdPASS) {
+    for (uint8_t i = 0; i < s_stage_n; ++i) run_work(i);   // Fallback: synchron, done folgt in poll()
+  }
+}
+
+static void finish(uint8_t i) {
+  const Stage& st = s_stages[i];
+  if (st.done) st.done();
+  const Phase p = st.phase;
+  if (p < PHASE_COUNT && !s_start[p] && !s_end[p]) {
+    s_order[s_n++] = p;
+    s_start[p] = s_work_start[i] ? s_work_start[i] : 1;
+    s_end[p]   = s_work_end[i];
+    if (s_end[p] <= s_start[p]) s_end[p] = s_start[p] + 1;
+  }
+  s_done |= (uint8_t)(1u << i);
+  bus::emit_sticky(st.ready, bus::Payload().set(bus::k::state, "ready").set(bus::k::ms, (int)millis()));
+}
+
+bool poll() {
+  if (!s_stages) return false;
+  const uint8_t all = (uint8_t)((1u << s_stage_n) - 1);
+  if (s_done == all) return false;
+  const uint8_t worked = s_worked.load(std::memory_order_acquire);
+  bool any = false;
+  for (uint8_t i = 0; i < s_stage_n; ++i) {
+    const uint8_t bit = (uint8_t)(1u << i);
+    if ((s_done & bit) || !(worked & bit)) continue;
+    if ((s_stages[i].deps & s_done) != s_stages[i].deps) continue;   // deps erst verdrahten
+    finish(i);
+    any = true;
+  }
+  if (s_done == all) {
+    bus::emit_sticky(bus::t::boot_ready,
+                     bus::Payload().set(bus::k::ms, (int)millis()).set(bus::k::n, (int)s_stage_n));
+    if (s_ready_us) store();   // Timeline mit Stages
+  }
+  return any;
+}
+
+size_t stages_ready() {
+  size_t n = 0;
+  for (uint8_t i = 0; i < s_stage_n; ++i) n += (s_done >> i) & 1u;
+  return n;
+}
+size_t stages_total() { return s_stage_n; }
+
+size_t count(bool prev) { return prev ? s_prev_n : s_n; }
+
+bool entry(size_t i, Entry& out, bool prev) {
+  if (prev) {
+    if (i >= s_prev_n) return false;
+    const Rec& r = s_prev[i];
+    out.name     = r.name;
+    out.start_us = r.start_us;
+    out.open     = !r.end_us;
+    out.dur_us   = r.end_us ? r.end_us - r.start_us : 0;
+    return true;
+  }
+  if (i >= s_n) return false;
+  const uint8_t p = s_order[i];
+  out.name     = NAMES[p];
+  out.start_us = s_start[p];
+  out.open     = !s_end[p];
+  out.dur_us   = s_end[p] ? s_end[p] - s_start[p] : 0;
+  return true;
+}
+
+uint32_t ready_us(bool prev) { return prev ? s_prev_ready_us : s_ready_us; }
+uint32_t end_us(Phase p) { return p < PHASE_COUNT ? s_end[p] : 0; }
+
+} // namespace boot
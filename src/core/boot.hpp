@@ -0,0 +1,105 @@
+// src/core/boot.hpp
+// Boot-Timeline: jede Phase von setup() und jede Service-Init trägt Start/Ende
+// (micros() seit Reset) ein. boot::ready() markiert den ersten Prompt und
+// schreibt die Timeline nach /logs/boot.last – vorher wird die dort liegende
+// Timeline des vorigen Boots geladen (info boot prev=on).
+//
+// Gestufter Boot: setup() bringt nur Konsole, Bus, Config und die Start-Stickies
+// hoch. Schwere Inits (PMU, Panel, Touch, Telemetrie) laufen als Stages auf einem
+// Hintergrund-Task – in Tabellenreihenfolge, jede erst wenn ihre deps fertig sind.
+// Stage::work läuft auf dem Task (Hardware/Trace, kein Bus), Stage::done danach
+// im loop() über boot::poll() (Bus-Verdrahtung) und emittiert die Readiness-
+// Sticky (state=ready ms=<seit Reset>). Nach der letzten Stage folgt boot.ready,
+// die Timeline wird dann noch einmal geschrieben.
+//
+// Bewertung (info boot): Phasen, die nach [boot] safe_window_ms enden, sind
+// "late"; stickies_ms = Ende der Start-Stickies (SLO ≤ STICKY_SLO_MS),
+// frame_ms = Ende von stage.display.
+// Das Budget setzt main.cpp nach config::init (boot::set_window_ms), der Kern
+// kennt die Config nicht.
+
+#pragma once
+#include <Arduino.h>
+#include "bus.hpp"
+
+// X(id, "name") – Reihenfolge = typischer Ablauf, gemessen wird, was wirklich läuft
+#define BOOT_PHASES(X) \
+  X(serial,       "serial")        /* Serial.begin */ \
+  X(console,      "console")       /* TX-Task (wartet selbst auf USB-CDC) */ \
+  X(fs_mount,     "fs.mount") \
+  X(bus,          "bus") \
+  X(console_cfg,  "console.cfg") \
+  X(trace,        "trace") \
+  X(config,       "config") \
+  X(stickies,     "stickies")      /* Start-Stickies (power.mode_changed, time.ready, ui.brightness) */ \
+  X(svc_power,    "svc.power")     /* Log, Resume-Replay, Modus – PMU kommt als Stage */ \
+  X(api,          "api") \
+  X(console_rx,   "console.rx") \
+  /* Stages: Start/Ende = work auf dem Task (done im loop() zählt nicht mit) */ \
+  X(st_pmu,       "stage.pmu") \
+  X(st_touch,     "stage.touch") \
+  X(st_telemetry, "stage.telemetry") \
+  X(st_display,   "stage.display")   /* Ende = erster Frame möglich */ \
+  X(fs_list,      "fs.list")         /* Stage: listDir/dumpFirstLines (Diagnose) */
+
+namespace boot {
+
+enum Phase : uint8_t {
+#define BOOT_PHASE_ENUM(id, name) P_##id,
+  BOOT_PHASES(BOOT_PHASE_ENUM)
+#undef BOOT_PHASE_ENUM
+  PHASE_COUNT
+};
+
+static constexpr uint32_t STICKY_SLO_MS = 200;
+static constexpr size_t   NAME_MAX      = 16;
+static constexpr const char* PATH       = "/logs/boot.last";
+
+void begin(Phase p);
+void end(Phase p);
+
+// { boot::Scope s(boot::P_config); config::init(); }
+struct Scope {
+  Phase p;
+  explicit Scope(Phase ph) : p(ph) { begin(p); }
+  ~Scope() { end(p); }
+};
+
+void set_window_ms(uint32_t ms);   // [boot] safe_window_ms
+uint32_t window_ms();
+
+// Erster Prompt erreicht: Zeitpunkt festhalten, vorige Timeline laden, aktuelle schreiben
+void ready();
+
+struct Entry {
+  const char* name;
+  uint32_t    start_us;
+  uint32_t    dur_us;     // 0 bei offener Phase
+  bool        open;       // begin ohne end
+};
+
+// prev = false: aktueller Boot (in Startreihenfolge), true: vorheriger aus PATH
+size_t   count(bool prev = false);
+bool     entry(size_t i, Entry& out, bool prev = false);
+uint32_t ready_us(bool prev = false);       // 0 = (noch) nicht erreicht
+uint32_t end_us(Phase p);                   // 0 = nicht gelaufen
+
+// ---------------------------------------------------------------------------
+// Stages
+static constexpr size_t STAGE_MAX = 8;
+
+struct Stage {
+  Phase         phase;       // Timeline-Eintrag (Name = Phasenname)
+  uint8_t       deps;        // Bitmaske früherer Stage-Indizes, die vorher fertig sein müssen
+  void        (*work)();     // Hintergrund-Task: darf blockieren, kein Bus
+  void        (*done)();     // loop-Task: Bus-Verdrahtung (nullptr = nichts)
+  bus::topic_t  ready;       // Readiness-Sticky
+};
+
+// Tabelle muss den Boot überleben (static const). Ohne Task-Start läuft alles synchron.
+void   stages_begin(const Stage* st, size_t n);
+bool   poll();               // loop(): fertige Stages abschließen; true = etwas abgeschlossen
+size_t stages_ready();       // abgeschlossen (done + Sticky)
+size_t stages_total();
+
+} // namespace boot
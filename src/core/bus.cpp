@@ -1,94 +1,549 @@
 // src/core/bus.cpp
 #include "bus.hpp"
+#include <string.h>
 #include <vector>
+#if BUS_PROFILE
+#include <esp_timer.h>
+#include <algorithm>
+#endif
 
 namespace bus {
 
 struct Sub {
   uint32_t id;
   String   pattern;
-  evt_handler_t handler; // null => Konsolen-Abo (nur SINK-Replay)
+  evt_handler_t handler; // null => Konsolen-Abo (Replay an SINK, live als Tag)
+  uint8_t  tag  = 0;     // Konsolen-Abo: Bit in der Maske an EVT_SINK
+  uint8_t  kind = 0;     // SubKind (Trie-Ablage)
+  uint16_t node = 0;     // Trie-Knoten bei K_EXACT/K_PREFIX/K_SUFFIX
+#if BUS_PROFILE
+  uint16_t prof = 0;     // Slot in sub_prof
+#endif
 };
 
+// Sticky-Store: Slots sind stabil (Index ändert sich nie, Einfüge-Reihenfolge
+// bleibt für das Replay erhalten). Gefunden wird per Hash-Index mit Open
+// Addressing (lineares Probing) → emit/lookup O(1), unabhängig von der Anzahl.
+// Schlüssel ist die Topic-ID (eindeutig pro Name, siehe topics.cpp).
+struct Sticky {
+  topic_t  id;
+  Payload  val;
+  uint32_t seq = 0;          // Sequenz der letzten Änderung
+#if BUS_PROFILE
+  uint32_t emits      = 0;   // Profiling je Topic lebt im Sticky-Slot (O(1), kein Extra-Index)
+  uint32_t handler_us = 0;
+#endif
+};
+
+static constexpr uint16_t IDX_EMPTY    = 0xFFFF;  // max. 65534 Stickies
+static constexpr size_t   IDX_MIN_CAP  = 64;      // Zweierpotenz
+
+void queue_reset(); // bus_queue.cpp
+
 static sink_fn SINK = nullptr;
+static evt_sink_t EVT_SINK = nullptr;      // Sessions (session.cpp)
 static std::vector<Sub> subs;
-static std::vector<std::pair<String,String>> stickies;
+static std::vector<Sticky>   stickies;      // Slots
+static std::vector<uint16_t> sticky_index;  // Hash → Slot, IDX_EMPTY = frei
 static uint32_t NEXT_ID = 1;
 
-// sehr einfache Pattern-Match-Logik: '*' als Prefix-/Suffix-Wildcard.
-static bool match(const String& pattern, const String& topic) {
-  int star = pattern.indexOf('*');
-  if (star < 0) return pattern == topic;
-  String pre = pattern.substring(0, star);
-  String post = pattern.substring(star + 1);
-  if (!pre.length() && !post.length()) return true; // "*"
-  if (pre.length() && !topic.startsWith(pre)) return false;
-  if (post.length() && !topic.endsWith(post)) return false;
-  if (pre.length() && post.length()) {
-    if (topic.length() < pre.length() + post.length()) return false;
+// Änderungs-Journal: Ring aus (seq, Topic). Ein Eintrag ist nur noch gültig,
+// solange sticky.seq == entry.seq (sonst gibt es einen neueren Eintrag).
+struct JournalEntry {
+  uint32_t seq;
+  topic_t  id;
+};
+static_assert((JOURNAL_CAP & (JOURNAL_CAP - 1)) == 0, "JOURNAL_CAP muss Zweierpotenz sein");
+static JournalEntry journal[JOURNAL_CAP];
+static uint32_t STICKY_SEQ = 0;
+static uint32_t STICKY_EPOCH = 0;   // je init neu, siehe sticky_epoch()
+
+static void index_insert(uint32_t hash, uint16_t slot) {
+  const size_t mask = sticky_index.size() - 1;
+  size_t i = hash & mask;
+  while (sticky_index[i] != IDX_EMPTY) i = (i + 1) & mask;
+  sticky_index[i] = slot;
+}
+
+// Index verdoppeln, sobald Füllgrad > 3/4 (Slots bleiben unberührt)
+static void index_reserve(size_t count) {
+  size_t cap = sticky_index.size();
+  if (cap && count * 4 <= cap * 3) return;
+  if (!cap) cap = IDX_MIN_CAP;
+  while (count * 4 > cap * 3) cap <<= 1;
+  sticky_index.assign(cap, IDX_EMPTY);
+  for (size_t s = 0; s < stickies.size(); ++s) index_insert((uint32_t)stickies[s].id, (uint16_t)s);
+}
+
+static Sticky* sticky_find(topic_t id) {
+  if (sticky_index.empty()) return nullptr;
+  const size_t mask = sticky_index.size() - 1;
+  for (size_t i = (uint32_t)id & mask; sticky_index[i] != IDX_EMPTY; i = (i + 1) & mask) {
+    Sticky& s = stickies[sticky_index[i]];
+    if (s.id == id) return &s;
+  }
+  return nullptr;
+}
+
+// Nächste Sequenz an den Slot, Eintrag ins Änderungs-Journal
+static void journal_note(Sticky* s) {
+  s->seq = ++STICKY_SEQ;
+  journal[s->seq & (JOURNAL_CAP - 1)] = { s->seq, s->id };
+}
+
+// Rückgabe: Slot (nur bis zum nächsten Einfügen gültig), nullptr wenn voll
+static Sticky* sticky_upsert(topic_t id, const Payload& p) {
+  if (Sticky* s = sticky_find(id)) { s->val = p; journal_note(s); return s; }
+  if (stickies.size() >= IDX_EMPTY) return nullptr; // voll – Live-Emit läuft trotzdem
+  index_reserve(stickies.size() + 1);
+  stickies.push_back({id, p});
+  index_insert((uint32_t)id, (uint16_t)(stickies.size() - 1));
+  journal_note(&stickies.back());
+  return &stickies.back();
+}
+
+// Pattern-Match ohne Allokation: '*' als Prefix-/Suffix-Wildcard ("pre*post").
+// Wird nur noch für Replay und Sonderformen genutzt, Dispatch läuft über den Trie.
+static bool match(const char* pat, size_t pn, const char* t, size_t tn) {
+  const char* star = (const char*)memchr(pat, '*', pn);
+  if (!star) return pn == tn && memcmp(pat, t, tn) == 0;
+  const size_t pre = star - pat, post = pn - pre - 1;
+  if (tn < pre + post) return false;
+  return memcmp(t, pat, pre) == 0 && memcmp(t + tn - post, star + 1, post) == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Subscription-Trie (Topic-Segmente, '.'-getrennt), beim Subscribe kompiliert:
+//   "a.b.c"  exakt       → Vorwärts-Knoten a/b/c, Liste exact
+//   "a.b.*"  Prefix      → Vorwärts-Knoten a/b,   Liste rest (alles darunter)
+//   "*"      alles       → Vorwärts-Wurzel,       Liste rest
+//   "*.b.c"  Suffix      → Rückwärts-Knoten c/b,  Liste rest (alles davor)
+//   sonst    (z. B. "pow*", "a.*.c") → generische Liste, Match ohne Allokation
+// Ein Emit läuft einmal vorwärts und einmal rückwärts über die Segmente und
+// berührt nur Knoten auf dem Pfad → Kosten ~ Segmente + Treffer, nicht ~ Abos.
+static constexpr uint16_t NODE_NONE = 0xFFFF;
+static constexpr uint16_t ROOT_FWD  = 0;
+static constexpr uint16_t ROOT_REV  = 1;
+static constexpr size_t   MAX_HITS  = 32;    // Handler pro Emit im Stack-Puffer, darüber Heap (gezählt)
+
+// Konsolen-Abos liegen mit im Trie (handler null, tag gesetzt): ein Emit
+// sammelt Handler und Tags in einem Durchlauf.
+enum SubKind : uint8_t { K_EXACT, K_PREFIX, K_SUFFIX, K_GENERIC };
+
+struct Hook {
+  uint32_t      id;
+  evt_handler_t handler;
+  uint8_t       tag;
+#if BUS_PROFILE
+  uint16_t      prof;     // Slot in sub_prof
+#endif
+};
+
+#if BUS_PROFILE
+// Profil je Handler-Abo; freie Slots haben id 0 und werden wiederverwendet
+static std::vector<SubProfile> sub_prof;
+static uint32_t PROF_EMITS = 0, PROF_CALLS = 0;
+
+static uint16_t prof_alloc(uint32_t id) {
+  SubProfile fresh{};
+  fresh.id = id;
+  for (size_t i = 0; i < sub_prof.size(); ++i) {
+    if (!sub_prof[i].id) { sub_prof[i] = fresh; return (uint16_t)i; }
+  }
+  sub_prof.push_back(fresh);
+  return (uint16_t)(sub_prof.size() - 1);
+}
+
+static inline uint8_t prof_bucket(uint32_t us) {
+  uint8_t b = 0;
+  while (us && b < PROF_BUCKETS - 1) { us >>= 1; ++b; }
+  return b;
+}
+#endif
+
+static inline Hook hook_of(const Sub& s) {
+#if BUS_PROFILE
+  return Hook{ s.id, s.handler, s.tag, s.prof };
+#else
+  return Hook{ s.id, s.handler, s.tag };
+#endif
+}
+
+// Kanten (Eltern + Segment → Kind) liegen in einem eigenen Hash-Index,
+// damit auch tausende Geschwister-Segmente in O(1) gefunden werden.
+struct Node {
+  String   seg;
+  uint32_t hash   = 0;          // fnv1a(seg) ^ Eltern-Mix
+  uint16_t parent = NODE_NONE;
+  std::vector<Hook> exact;
+  std::vector<Hook> rest;
+};
+
+struct Generic {
+  Hook   hook;
+  String pattern;
+};
+
+static std::vector<Node>    nodes;
+static std::vector<uint16_t> edge_index;   // Hash → Knoten, NODE_NONE = frei
+static std::vector<Generic> generic;
+static uint32_t UNSUB_EPOCH = 0;   // erkennt Unsubscribe während eines Dispatch
+static uint32_t HIT_SPILLS = 0;    // Emits mit mehr als MAX_HITS Handlern (info bus)
+
+static void trie_reset() {
+  nodes.clear();
+  nodes.resize(2); // ROOT_FWD, ROOT_REV
+  edge_index.clear();
+  generic.clear();
+}
+
+static inline uint32_t edge_hash(uint16_t parent, const char* seg, size_t len) {
+  return fnv1a(seg, len) ^ ((uint32_t)parent * 0x9E3779B1u);
+}
+
+static void edge_insert(uint16_t node) {
+  const size_t mask = edge_index.size() - 1;
+  size_t i = nodes[node].hash & mask;
+  while (edge_index[i] != NODE_NONE) i = (i + 1) & mask;
+  edge_index[i] = node;
+}
+
+static uint16_t child_of(uint16_t n, const char* seg, size_t len, bool create) {
+  const uint32_t h = edge_hash(n, seg, len);
+  if (!edge_index.empty()) {
+    const size_t mask = edge_index.size() - 1;
+    for (size_t i = h & mask; edge_index[i] != NODE_NONE; i = (i + 1) & mask) {
+      const Node& c = nodes[edge_index[i]];
+      if (c.hash == h && c.parent == n && c.seg.length() == len && memcmp(c.seg.c_str(), seg, len) == 0)
+        return edge_index[i];
+    }
+  }
+  if (!create || nodes.size() >= NODE_NONE - 1) return NODE_NONE;
+
+  Node nn;
+  nn.seg    = String(seg, len);
+  nn.hash   = h;
+  nn.parent = n;
+  nodes.push_back(nn);
+  const uint16_t id = (uint16_t)(nodes.size() - 1);
+
+  // Index wie beim Sticky-Store: Füllgrad ≤ 3/4, sonst verdoppeln + neu einsortieren
+  size_t cap = edge_index.size();
+  if (!cap || nodes.size() * 4 > cap * 3) {
+    cap = cap ? cap : IDX_MIN_CAP;
+    while (nodes.size() * 4 > cap * 3) cap <<= 1;
+    edge_index.assign(cap, NODE_NONE);
+    for (uint16_t k = 2; k < nodes.size(); ++k) edge_insert(k);
+  } else {
+    edge_insert(id);
+  }
+  return id;
+}
+
+// Segmentpfad anlegen: vorwärts (a → b → c) oder rückwärts (c → b → a)
+static uint16_t path_node(uint16_t root, const char* p, size_t n, bool reverse) {
+  uint16_t node = root;
+  if (!reverse) {
+    size_t a = 0;
+    for (size_t i = 0; i <= n && node != NODE_NONE; ++i) {
+      if (i < n && p[i] != '.') continue;
+      node = child_of(node, p + a, i - a, true);
+      a = i + 1;
+    }
+  } else {
+    size_t e = n;
+    for (size_t k = n + 1; k-- > 0 && node != NODE_NONE;) {
+      if (k && p[k - 1] != '.') continue;
+      node = child_of(node, p + k, e - k, true);
+      e = k ? k - 1 : 0;
+    }
+  }
+  return node;
+}
+
+static SubKind compile_sub(Sub& s) {
+  const char* p = s.pattern.c_str();
+  const size_t n = s.pattern.length();
+  const Hook hook = hook_of(s);
+  const char* star = (const char*)memchr(p, '*', n);
+  const size_t pre = star ? (size_t)(star - p) : n;
+  const bool single = star && !memchr(star + 1, '*', n - pre - 1);
+
+  s.node = NODE_NONE;
+  if (!star) {
+    s.node = path_node(ROOT_FWD, p, n, false);
+    if (s.node != NODE_NONE) { nodes[s.node].exact.push_back(hook); return K_EXACT; }
+  } else if (single && pre == n - 1 && (pre == 0 || p[pre - 1] == '.')) {
+    s.node = pre ? path_node(ROOT_FWD, p, pre - 1, false) : ROOT_FWD;
+    if (s.node != NODE_NONE) { nodes[s.node].rest.push_back(hook); return K_PREFIX; }
+  } else if (single && pre == 0 && n > 2 && p[1] == '.') {
+    s.node = path_node(ROOT_REV, p + 2, n - 2, true);
+    if (s.node != NODE_NONE) { nodes[s.node].rest.push_back(hook); return K_SUFFIX; }
+  }
+  generic.push_back({ hook, s.pattern });
+  return K_GENERIC;
+}
+
+static void remove_hook(std::vector<Hook>& v, uint32_t id) {
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (v[i].id == id) { v.erase(v.begin() + i); return; }
+  }
+}
+
+static void uncompile_sub(const Sub& s) {
+  switch (s.kind) {
+    case K_EXACT:  remove_hook(nodes[s.node].exact, s.id); break;
+    case K_PREFIX:
+    case K_SUFFIX: remove_hook(nodes[s.node].rest,  s.id); break;
+    case K_GENERIC:
+      for (size_t i = 0; i < generic.size(); ++i) {
+        if (generic[i].hook.id == s.id) { generic.erase(generic.begin() + i); break; }
+      }
+      break;
+    default: break;
   }
-  return true;
 }
 
-static void sink_evt(const String& topic, const String& kv) {
+// Treffer eines Emits: Stack-Puffer, bei mehr als MAX_HITS Umzug in einen Vector
+// (kein Handler geht verloren; selten, daher nur gezählt)
+struct Hits {
+  Hook              buf[MAX_HITS];
+  std::vector<Hook> spill;
+  Hook*             h = buf;
+  size_t            n = 0;
+  Hits() = default;
+  Hits(const Hits&) = delete;
+  void push(const Hook& k) {
+    if (n < MAX_HITS) { buf[n++] = k; return; }
+    if (spill.empty()) { spill.assign(buf, buf + n); ++HIT_SPILLS; }
+    spill.push_back(k);
+    h = spill.data();
+    ++n;
+  }
+  void add(const std::vector<Hook>& v) { for (const Hook& k : v) push(k); }
+};
+
+// Alle Handler zu einem Topic einsammeln (ohne Allokation)
+static void collect(const char* t, size_t tn, Hits& out) {
+  if (nodes.empty()) return;
+  // vorwärts: rest greift, solange noch ein Segment folgt; exact am Ende
+  uint16_t node = ROOT_FWD;
+  out.add(nodes[node].rest);
+  size_t a = 0;
+  for (size_t i = 0; i <= tn && node != NODE_NONE; ++i) {
+    if (i < tn && t[i] != '.') continue;
+    node = child_of(node, t + a, i - a, false);
+    if (node == NODE_NONE) break;
+    out.add(i < tn ? nodes[node].rest : nodes[node].exact);
+    a = i + 1;
+  }
+  // rückwärts: Suffix-Abos, solange noch ein Segment davor liegt
+  node = ROOT_REV;
+  size_t e = tn;
+  for (size_t k = tn + 1; k-- > 0 && node != NODE_NONE;) {
+    if (k && t[k - 1] != '.') continue;
+    if (!k) break;                       // erstes Segment: nichts mehr davor
+    node = child_of(node, t + k, e - k, false);
+    if (node == NODE_NONE) break;
+    out.add(nodes[node].rest);
+    e = k - 1;
+  }
+  for (const Generic& g : generic) {
+    if (match(g.pattern.c_str(), g.pattern.length(), t, tn)) out.push(g.hook);
+  }
+  // Abo-Reihenfolge beibehalten (IDs steigen monoton)
+  for (size_t i = 1; i < out.n; ++i) {
+    Hook k = out.h[i]; size_t j = i;
+    while (j && out.h[j - 1].id > k.id) { out.h[j] = out.h[j - 1]; --j; }
+    out.h[j] = k;
+  }
+}
+
+static bool sub_alive(uint32_t id) {
+  for (const auto& s : subs) if (s.id == id) return true;
+  return false;
+}
+
+// Textform entsteht nur hier – und nur, wenn überhaupt eine Senke hängt
+static void sink_evt(topic_t topic, const Payload& p, uint32_t tags) {
+  if (EVT_SINK) { EVT_SINK(topic, p, tags); return; }
   if (!SINK) return;
-  String line = "evt " + topic;
-  if (kv.length()) { line += " "; line += kv; }
+  char kv[192];
+  const size_t n = p.render(kv, sizeof(kv));
+  String line = "evt ";
+  line += topic_name(topic);
+  if (n) { line += " "; line += kv; }
   SINK(line);
 }
 
+void set_evt_sink(evt_sink_t fn) { EVT_SINK = fn; }
+
 void init(sink_fn out) {
   SINK = out;
   subs.clear();
+  trie_reset();
   stickies.clear();
+  sticky_index.clear();
   NEXT_ID = 1;
+  STICKY_SEQ = 0;
+  do { STICKY_EPOCH = esp_random(); } while (!STICKY_EPOCH);
+  queue_reset();
+#if BUS_PROFILE
+  sub_prof.clear();
+  PROF_EMITS = PROF_CALLS = 0;
+#endif
 }
 
-void emit_sticky(const String& topic, const String& kv) {
-  bool updated = false;
-  for (auto &p : stickies) {
-    if (p.first == topic) { p.second = kv; updated = true; break; }
-  }
-  if (!updated) stickies.push_back({topic, kv});
-  sink_evt(topic, kv);
-  for (const auto &s : subs) {
-    if (!s.handler) continue;
-    if (match(s.pattern, topic)) {
-      s.handler(topic, kv);
+void emit_sticky(topic_t topic, const String& kv) {
+  emit_sticky(topic, Payload::parse(kv));
+}
+
+bool emit_sticky(const String& topic, const String& kv) {
+  return emit_sticky(topic, Payload::parse(kv));
+}
+
+bool emit_sticky(const String& topic, const Payload& p) {
+  const topic_t id = intern(topic);
+  if (id == topic_t::NONE) return false;
+  emit_sticky(id, p);
+  return true;
+}
+
+void emit_sticky(topic_t topic, const Payload& p) {
+#if BUS_PROFILE
+  if (Sticky* s = sticky_upsert(topic, p)) ++s->emits;
+  ++PROF_EMITS;
+  uint32_t topic_us = 0;
+#else
+  sticky_upsert(topic, p);
+#endif
+  size_t tn = 0;
+  const char* t = topic_name(topic, &tn);
+  Hits hits;
+  collect(t, tn, hits);
+  uint32_t tags = 0;
+  for (size_t i = 0; i < hits.n; ++i) if (!hits.h[i].handler) tags |= 1u << hits.h[i].tag;
+  const uint32_t epoch = UNSUB_EPOCH;
+  sink_evt(topic, p, tags);
+
+  for (size_t i = 0; i < hits.n; ++i) {
+    if (!hits.h[i].handler) continue;
+    if (UNSUB_EPOCH != epoch && !sub_alive(hits.h[i].id)) continue;
+#if BUS_PROFILE
+    const int64_t t0 = esp_timer_get_time();
+    hits.h[i].handler(topic, p);
+    const uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+    topic_us += us;
+    ++PROF_CALLS;
+    // Slot kann im Handler freigegeben/neu vergeben worden sein → ID prüfen
+    const uint16_t ps = hits.h[i].prof;
+    if (ps < sub_prof.size() && sub_prof[ps].id == hits.h[i].id) {
+      SubProfile& sp = sub_prof[ps];
+      ++sp.calls;
+      sp.total_us += us;
+      if (us > sp.max_us) sp.max_us = us;
+      ++sp.hist[prof_bucket(us)];
     }
+#else
+    hits.h[i].handler(topic, p);
+#endif
+  }
+#if BUS_PROFILE
+  if (topic_us) { if (Sticky* s = sticky_find(topic)) s->handler_us += topic_us; }
+#endif
+}
+
+static void replay_one(const Sticky& s, evt_handler_t h) {
+  const topic_t topic = s.id;
+  const Payload kv    = s.val;   // Kopie: Handler dürfen emit_sticky aufrufen
+  if (h) h(topic, kv);
+  else   sink_evt(topic, kv, 0);
+}
+
+// Delta-Replay aus dem Journal; false bei fremder Epoche oder wenn `since`
+// nicht (mehr) abgedeckt ist
+static bool replay_since(const String& pattern, evt_handler_t h, uint32_t epoch, uint32_t since, size_t& count) {
+  const uint32_t head   = STICKY_SEQ;
+  const uint32_t oldest = head > JOURNAL_CAP ? head - JOURNAL_CAP + 1 : 1;
+  if (epoch != STICKY_EPOCH || since > head || since + 1 < oldest) return false;
+  for (uint32_t seq = since + 1; seq <= head; ++seq) {
+    const JournalEntry e = journal[seq & (JOURNAL_CAP - 1)];
+    if (e.seq != seq) continue;                        // von Handler-Emits überholt
+    const Sticky* s = sticky_find(e.id);
+    if (!s || s->seq != seq) continue;                 // später erneut geändert
+    size_t tn = 0;
+    const char* t = topic_name(e.id, &tn);
+    if (!match(pattern.c_str(), pattern.length(), t, tn)) continue;
+    replay_one(*s, h);
+    ++count;
+  }
+  return true;
+}
+
+static size_t replay_all(const String& pattern, evt_handler_t h) {
+  size_t count = 0;
+  // Replay per Index (Handler dürfen emit_sticky aufrufen → Vector kann wachsen)
+  for (size_t i = 0; i < stickies.size(); ++i) {
+    size_t tn = 0;
+    const char* t = topic_name(stickies[i].id, &tn);
+    if (!match(pattern.c_str(), pattern.length(), t, tn)) continue;
+    replay_one(stickies[i], h);
+    ++count;
   }
+  return count;
 }
 
-static uint32_t add_sub(const String& pattern, evt_handler_t h) {
+static uint32_t add_sub(const String& pattern, evt_handler_t h, uint8_t tag) {
   Sub s;
   s.id = NEXT_ID++;
   s.pattern = pattern;
   s.handler = h;
+  s.tag     = tag < TAG_MAX ? tag : 0;
+#if BUS_PROFILE
+  if (h) s.prof = prof_alloc(s.id);
+#endif
+  if (nodes.empty()) trie_reset();
+  s.kind    = compile_sub(s);
   subs.push_back(s);
-  if (h) {
-    for (const auto &p : stickies) {
-      if (match(pattern, p.first)) h(p.first, p.second);
-    }
-  } else {
-    for (const auto &p : stickies) {
-      if (match(pattern, p.first)) sink_evt(p.first, p.second);
-    }
-  }
   return s.id;
 }
 
-uint32_t subscribe(const String& pattern) {
-  return add_sub(pattern, nullptr);
+uint32_t subscribe(const String& pattern, uint8_t tag) {
+  const uint32_t id = add_sub(pattern, nullptr, tag);
+  replay_all(pattern, nullptr);
+  return id;
+}
+
+uint32_t subscribe_since(const String& pattern, uint8_t tag, uint32_t epoch, uint32_t since, bool* delta,
+                         size_t* replayed) {
+  const uint32_t id = add_sub(pattern, nullptr, tag);
+  size_t n = 0;
+  const bool d = replay_since(pattern, nullptr, epoch, since, n);
+  if (!d) n = replay_all(pattern, nullptr);
+  if (delta)    *delta = d;
+  if (replayed) *replayed = n;
+  return id;
 }
 
 uint32_t subscribe(const String& pattern, evt_handler_t handler) {
-  return add_sub(pattern, handler);
+  const uint32_t id = add_sub(pattern, handler, 0);
+  replay_all(pattern, handler);
+  return id;
+}
+
+uint32_t subscribe(topic_t topic, evt_handler_t handler) {
+  return subscribe(String(topic_name(topic)), handler);
 }
 
 bool unsubscribe(uint32_t id) {
   for (size_t i = 0; i < subs.size(); ++i) {
     if (subs[i].id == id) {
+      uncompile_sub(subs[i]);
+#if BUS_PROFILE
+      if (subs[i].handler && subs[i].prof < sub_prof.size()) sub_prof[subs[i].prof].id = 0;
+#endif
       subs.erase(subs.begin() + i);
+      ++UNSUB_EPOCH;
       return true;
     }
   }
@@ -97,6 +552,100 @@ bool unsubscribe(uint32_t id) {
 
 void unsubscribe_all() {
   subs.clear();
+  trie_reset();
+#if BUS_PROFILE
+  sub_prof.clear();
+#endif
+  ++UNSUB_EPOCH;
+}
+
+bool get_sticky(topic_t topic, Payload& out) {
+  const Sticky* s = sticky_find(topic);
+  if (!s) return false;
+  out = s->val;
+  return true;
+}
+
+bool get_sticky(const String& topic, Payload& out) {
+  const topic_t id = find_topic(topic.c_str(), topic.length());
+  return id != topic_t::NONE && get_sticky(id, out);
+}
+
+bool get_sticky(const char* topic, size_t n, Payload& out, uint32_t* seq) {
+  const topic_t id = find_topic(topic, n);
+  const Sticky* s = id != topic_t::NONE ? sticky_find(id) : nullptr;
+  if (!s) return false;
+  out = s->val;
+  if (seq) *seq = s->seq;
+  return true;
+}
+
+size_t for_each_sticky(const char* pattern, size_t pn, sticky_fn fn, void* ctx) {
+  size_t count = 0;
+  for (size_t i = 0; i < stickies.size(); ++i) {
+    size_t tn = 0;
+    const char* t = topic_name(stickies[i].id, &tn);
+    if (!match(pattern, pn, t, tn)) continue;
+    fn(stickies[i].id, stickies[i].val, stickies[i].seq, ctx);
+    ++count;
+  }
+  return count;
+}
+
+size_t sticky_count() { return stickies.size(); }
+size_t sub_count()    { return subs.size(); }
+uint32_t hit_spills() { return HIT_SPILLS; }
+uint32_t sticky_seq() { return STICKY_SEQ; }
+uint32_t sticky_epoch() { return STICKY_EPOCH; }
+
+// ---------------------------------------------------------------------------
+// Profiling
+String sub_pattern(uint32_t id) {
+  for (const auto& s : subs) if (s.id == id) return s.pattern;
+  return String();
+}
+
+#if BUS_PROFILE
+size_t profile_top_subs(SubProfile* out, size_t max) {
+  std::vector<const SubProfile*> v;
+  for (const auto& sp : sub_prof) if (sp.id && sp.calls) v.push_back(&sp);
+  std::sort(v.begin(), v.end(), [](const SubProfile* a, const SubProfile* b) { return a->total_us > b->total_us; });
+  const size_t n = std::min(max, v.size());
+  for (size_t i = 0; i < n; ++i) out[i] = *v[i];
+  return n;
+}
+
+size_t profile_top_topics(TopicProfile* out, size_t max) {
+  std::vector<const Sticky*> v;
+  for (const auto& s : stickies) if (s.emits) v.push_back(&s);
+  std::sort(v.begin(), v.end(), [](const Sticky* a, const Sticky* b) { return a->emits > b->emits; });
+  const size_t n = std::min(max, v.size());
+  for (size_t i = 0; i < n; ++i) out[i] = { v[i]->id, v[i]->emits, v[i]->handler_us };
+  return n;
+}
+
+void profile_totals(uint32_t& emits, uint32_t& calls) { emits = PROF_EMITS; calls = PROF_CALLS; }
+
+void profile_reset() {
+  for (auto& sp : sub_prof) {
+    const uint32_t id = sp.id;
+    sp = SubProfile{};
+    sp.id = id;
+  }
+  for (auto& s : stickies) { s.emits = 0; s.handler_us = 0; }
+  PROF_EMITS = PROF_CALLS = 0;
+}
+#else
+size_t profile_top_subs(SubProfile*, size_t)     { return 0; }
+size_t profile_top_topics(TopicProfile*, size_t) { return 0; }
+void   profile_totals(uint32_t& emits, uint32_t& calls) { emits = calls = 0; }
+void   profile_reset() {}
+#endif
+
+bool matches(const String& pattern, topic_t topic) {
+  size_t tn = 0;
+  const char* t = topic_name(topic, &tn);
+  return match(pattern.c_str(), pattern.length(), t, tn);
 }
 
 } // namespace bus
@@ -1,31 +1,144 @@
 // src/core/bus.hpp
 #pragma once
 #include <Arduino.h>
+#include "payload.hpp"
+#include "topics.hpp"
+
+// Bus-Profiling (Zähler + Handler-Laufzeit-Histogramme, `info bus.top`).
+// Aus (0): kein Code, kein RAM, kein Zeitstempel im Emit-Pfad.
+#ifndef BUS_PROFILE
+#define BUS_PROFILE 0
+#endif
 
 namespace bus {
 
 // Textausgabe-Senke (z. B. Serial.println in main)
 using sink_fn = void (*)(const String& line);
 
-// Event-Handler für interne Abonnenten (Services)
-using evt_handler_t = void (*)(const String& topic, const String& kv);
+// Event-Handler für interne Abonnenten (Services): Topic-ID + typisierte Payload
+// (Vergleich gegen bus::t::…, Name bei Bedarf über topic_name())
+using evt_handler_t = void (*)(topic_t topic, const Payload& p);
 
 // Bus initialisieren (setzt globale Ausgabesenke)
 void init(sink_fn out);
 
-// Sticky-Emit: speichert (topic -> kv), schreibt "evt <topic> <kv>" an SINK,
-// und ruft passende Handler auf.
-void emit_sticky(const String& topic, const String& kv);
+// Typisierte Senke statt der Textform (session.cpp verteilt an die Sessions).
+// tags = Bitmaske der Tags aller Konsolen-Abos, die der Trie für dieses Topic
+// trifft (0 beim Replay); nullptr → wieder "evt <topic> <kv>" an SINK.
+// Bleibt über init() hinweg gesetzt.
+using evt_sink_t = void (*)(topic_t topic, const Payload& p, uint32_t tags);
+static constexpr uint8_t TAG_MAX = 32;   // Tags 0..31 (Bit in tags)
+void set_evt_sink(evt_sink_t fn);
+
+// Sticky-Emit: speichert (topic -> payload), schreibt "evt <topic> <kv>" an SINK,
+// und ruft passende Handler auf. Interne Emits nutzen die IDs aus bus::t.
+void emit_sticky(topic_t topic, const Payload& p);
+
+// Text-Variante (Freitext-Traces): "k=v k=v" wird einmal geparst
+void emit_sticky(topic_t topic, const String& kv);
 
-// Subscribe (Konsolenmodus): nur Sticky-Replay an SINK (keine Handler).
+// Laufzeit-Topics (Konsole, INI): Name wird interniert. false = abgelehnt
+// (leer / Tabelle voll).
+bool emit_sticky(const String& topic, const Payload& p);
+bool emit_sticky(const String& topic, const String& kv);
+
+// Subscribe (Konsolenmodus): Sticky-Replay an SINK, live meldet der Emit den
+// Tag (z. B. Session-ID) in der Maske an die Evt-Senke (keine Handler).
 // Rückgabewert: Abo-ID (für unsubscribe)
-uint32_t subscribe(const String& pattern);
+uint32_t subscribe(const String& pattern, uint8_t tag = 0);
+
+// Konsolen-Abo mit Delta-Resync: repliziert nur Topics, die sich nach Sequenz
+// `since` geändert haben (je Topic der letzte Stand, in Änderungsreihenfolge).
+// Stammt `epoch` aus einem anderen Boot (≠ sticky_epoch(), 0 = unbekannt) oder
+// liegt `since` vor dem Journal-Anfang bzw. hinter der aktuellen Sequenz, wird
+// voll repliziert → *delta = false.
+uint32_t subscribe_since(const String& pattern, uint8_t tag, uint32_t epoch, uint32_t since,
+                         bool* delta = nullptr, size_t* replayed = nullptr);
 
 // Subscribe mit Handler inkl. sofortigem Sticky-Replay
 uint32_t subscribe(const String& pattern, evt_handler_t handler);
+uint32_t subscribe(topic_t topic, evt_handler_t handler);   // exakt, registriertes Topic
 
 // Unsubscribe
 bool unsubscribe(uint32_t id);
 void unsubscribe_all();
 
+// ---------------------------------------------------------------------------
+// Deferred-Emit (ISR / Core 0 / Hintergrund-Tasks)
+// Feste Zellgröße, Texte werden abgeschnitten. Zustellung erst durch drain().
+static constexpr uint32_t QUEUE_CAP       = 32;  // Zweierpotenz
+static constexpr size_t   QUEUE_KV_MAX    = 64;  // inkl. '\0'
+
+struct QueueStats {
+  uint32_t depth;       // aktuell wartend
+  uint32_t high_water;  // max. Tiefe seit init
+  uint32_t posted;      // angenommen
+  uint32_t dropped;     // verworfen (Queue voll)
+  uint32_t drained;     // zugestellt
+};
+
+// ISR-/Thread-sicher, lock-frei, ohne Heap. false = Queue voll (gezählt).
+// Topic nur als ID (registriert in BUS_TOPICS – im ISR wird nichts interniert).
+bool emit_from_isr(topic_t topic, const char* kv);
+
+// Nur vom Bus-Owner (loop-Task) aufrufen: stellt wartende Events in
+// Reihenfolge per emit_sticky zu. Rückgabe: Anzahl zugestellter Events.
+size_t drain(size_t max_events = QUEUE_CAP);
+
+void queue_stats(QueueStats& out);
+
+// Sticky-Sequenz: jede Sticky-Änderung erhält die nächste Nummer (ab 1, pro Boot).
+// Die Epoche (Zufalls-Nonce ≠ 0, neu bei jedem init) macht Nummern verschiedener
+// Boots unterscheidbar; die Konsole meldet beides als seq=<epoch hex>:<seq>.
+// Das Änderungs-Journal hält die letzten JOURNAL_CAP Nummern für subscribe_since.
+static constexpr uint32_t JOURNAL_CAP = 256;   // Zweierpotenz
+uint32_t sticky_seq();                          // zuletzt vergebene Nummer (0 = keine)
+uint32_t sticky_epoch();
+
+// Sticky-Lookup (O(1), Hash-Index). false, wenn Topic nie emittiert wurde.
+bool   get_sticky(topic_t topic, Payload& out);
+bool   get_sticky(const String& topic, Payload& out);   // interniert nicht
+bool   get_sticky(const char* topic, size_t n, Payload& out, uint32_t* seq = nullptr);
+
+// Snapshot: alle Stickies, deren Topic auf pattern passt (Syntax wie subscribe),
+// direkt aus dem Store – ohne Abo, ohne Ausgabe an SINK. Rückgabe: Anzahl Treffer.
+using sticky_fn = void (*)(topic_t topic, const Payload& p, uint32_t seq, void* ctx);
+size_t for_each_sticky(const char* pattern, size_t pn, sticky_fn fn, void* ctx);
+size_t sticky_count();
+size_t sub_count();
+uint32_t hit_spills();   // Emits mit mehr Handlern als der Stack-Puffer fasst (Heap-Pfad)
+
+// ---------------------------------------------------------------------------
+// Profiling (nur mit -D BUS_PROFILE=1 befüllt, sonst liefern die Abfragen 0)
+// Histogramm: Bucket b zählt Handler-Laufzeiten in [2^(b-1), 2^b) µs, Bucket 0 = < 1 µs,
+// der letzte Bucket sammelt alles darüber.
+static constexpr size_t PROF_BUCKETS = 16;
+
+struct SubProfile {
+  uint32_t id;                 // Abo-ID
+  uint32_t calls;
+  uint32_t total_us;           // inkl. verschachtelter Emits aus dem Handler
+  uint32_t max_us;
+  uint32_t hist[PROF_BUCKETS];
+};
+
+struct TopicProfile {
+  topic_t  id;
+  uint32_t emits;
+  uint32_t handler_us;         // Summe aller Handler dieses Topics
+};
+
+constexpr bool profiling() { return BUS_PROFILE != 0; }
+
+// Teuerste Handler (nach total_us) bzw. häufigste Topics (nach emits), absteigend.
+// Rückgabe: Anzahl geschriebener Einträge.
+size_t profile_top_subs(SubProfile* out, size_t max);
+size_t profile_top_topics(TopicProfile* out, size_t max);
+void   profile_totals(uint32_t& emits, uint32_t& calls);
+String sub_pattern(uint32_t id);   // "" für unbekannte IDs
+void   profile_reset();
+
+// Konsolen-Pattern (Syntax wie subscribe) gegen ein Topic prüfen, z. B. für Trace-Replay
+bool matches(const String& pattern, topic_t topic);
+
 } // namespace bus
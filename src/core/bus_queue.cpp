@@ -0,0 +1,104 @@
+// src/core/bus_queue.cpp
+// Deferred-Emit für ISRs und andere Tasks/Kerne: lock-freie MPSC-Queue
+// (bounded, Sequenznummer pro Zelle). Produzenten kopieren Topic-ID + KV in eine
+// feste Zelle – kein Heap, keine Sperre, ISR-tauglich (IRAM). Konsument ist
+// der Bus-Owner (loop-Task) via bus::drain(), der in Reihenfolge dispatcht.
+
+#include "bus.hpp"
+#include <atomic>
+#include <string.h>
+
+namespace bus {
+
+static_assert((QUEUE_CAP & (QUEUE_CAP - 1)) == 0, "QUEUE_CAP muss Zweierpotenz sein");
+
+struct Cell {
+  std::atomic<uint32_t> seq;
+  topic_t topic;
+  char kv[QUEUE_KV_MAX];
+};
+
+static Cell q_cells[QUEUE_CAP];
+static std::atomic<uint32_t> q_enq{0};
+static std::atomic<uint32_t> q_deq{0};   // nur der Konsument schreibt
+static bool                  q_ready = false;
+
+static std::atomic<uint32_t> q_posted{0};
+static std::atomic<uint32_t> q_dropped{0};
+static std::atomic<uint32_t> q_high_water{0};
+static uint32_t              q_drained = 0;
+
+static void q_init_cells() {
+  for (uint32_t i = 0; i < QUEUE_CAP; ++i) q_cells[i].seq.store(i, std::memory_order_relaxed);
+  q_ready = true;
+}
+
+// Kopie mit Abschneiden (kein strncpy/memcpy-Aufruf aus dem Flash im ISR)
+static inline void IRAM_ATTR q_copy(char* dst, const char* src, size_t cap) {
+  size_t i = 0;
+  if (src) { for (; i + 1 < cap && src[i]; ++i) dst[i] = src[i]; }
+  dst[i] = 0;
+}
+
+bool IRAM_ATTR emit_from_isr(topic_t topic, const char* kv) {
+  if (!q_ready || topic == topic_t::NONE) return false;
+  uint32_t pos = q_enq.load(std::memory_order_relaxed);
+  Cell* c;
+  for (;;) {
+    c = &q_cells[pos & (QUEUE_CAP - 1)];
+    const int32_t diff = (int32_t)(c->seq.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (q_enq.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      q_dropped.fetch_add(1, std::memory_order_relaxed); // voll
+      return false;
+    } else {
+      pos = q_enq.load(std::memory_order_relaxed);
+    }
+  }
+  c->topic = topic;
+  q_copy(c->kv, kv, QUEUE_KV_MAX);
+  c->seq.store(pos + 1, std::memory_order_release);
+
+  q_posted.fetch_add(1, std::memory_order_relaxed);
+  const uint32_t depth = pos + 1 - q_deq.load(std::memory_order_relaxed);
+  uint32_t hw = q_high_water.load(std::memory_order_relaxed);
+  while (depth > hw && !q_high_water.compare_exchange_weak(hw, depth, std::memory_order_relaxed)) {}
+  return true;
+}
+
+size_t drain(size_t max_events) {
+  if (!q_ready) return 0;
+  size_t n = 0;
+  while (n < max_events) {
+    const uint32_t pos = q_deq.load(std::memory_order_relaxed);
+    Cell& c = q_cells[pos & (QUEUE_CAP - 1)];
+    if ((int32_t)(c.seq.load(std::memory_order_acquire) - (pos + 1)) < 0) break; // leer / noch in Arbeit
+    const topic_t topic = c.topic;
+    const Payload kv = Payload::parse(c.kv, strnlen(c.kv, QUEUE_KV_MAX));
+    c.seq.store(pos + QUEUE_CAP, std::memory_order_release);
+    q_deq.store(pos + 1, std::memory_order_relaxed);
+    ++q_drained; ++n;
+    emit_sticky(topic, kv);
+  }
+  return n;
+}
+
+void queue_stats(QueueStats& out) {
+  out.depth      = q_enq.load(std::memory_order_relaxed) - q_deq.load(std::memory_order_relaxed);
+  out.high_water = q_high_water.load(std::memory_order_relaxed);
+  out.posted     = q_posted.load(std::memory_order_relaxed);
+  out.dropped    = q_dropped.load(std::memory_order_relaxed);
+  out.drained    = q_drained;
+}
+
+// Aufruf aus bus::init(): Queue leeren und Zähler zurücksetzen
+void queue_reset() {
+  q_init_cells();
+  q_enq.store(0, std::memory_order_relaxed);
+  q_deq.store(0, std::memory_order_relaxed);
+  q_posted.store(0); q_dropped.store(0); q_high_water.store(0);
+  q_drained = 0;
+}
+
+} // namespace bus
@@ -0,0 +1,333 @@
+// src/core/console.cpp
+#include "console.hpp"
+#include "bus.hpp"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <string.h>
+
+namespace console {
+
+static_assert((CONSOLE_TX_CAP & (CONSOLE_TX_CAP - 1)) == 0, "CONSOLE_TX_CAP muss Zweierpotenz sein");
+
+static constexpr size_t   RESP_RESERVE      = 512;   // letzte Bytes nur für ok/err/Prompt
+static constexpr size_t   CO_SLOTS          = 16;    // Coalesce: ein Slot je Topic
+static constexpr size_t   CO_LINE_MAX       = 160;   // inkl. CR/LF
+static constexpr size_t   TX_BATCH_MIN      = 256;   // kleiner → kurz sammeln
+static constexpr uint32_t TX_BATCH_WAIT_MS  = 2;
+static constexpr uint32_t TX_IDLE_MS        = 50;
+
+static const char* const CLASS_NAMES[CLASS_COUNT] = { "resp", "evt", "trace", "log" };
+static const char* const POLICY_NAMES[]           = { "block", "drop", "coalesce" };
+
+// Ring: head/tail laufen monoton, Maskierung beim Zugriff. Produzenten schreiben
+// unter s_mux hinter head; der TX-Task liest [tail, head) ohne Sperre.
+static char          s_ring[CONSOLE_TX_CAP];
+static uint32_t      s_head = 0, s_tail = 0;
+static portMUX_TYPE  s_mux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t  s_tx = nullptr;
+static volatile bool s_running = false;
+static uint32_t      s_hold_ms = 0;
+
+static uint8_t s_policy[CLASS_COUNT] = { P_BLOCK, P_COALESCE, P_DROP, P_DROP };
+
+// Reply-Scope: Task, der gerade einen Befehl ausführt (Tiefe für Batches/';')
+static TaskHandle_t  s_reply_task  = nullptr;
+static uint8_t       s_reply_depth = 0;
+static Stats   s_st = {};
+
+// Coalesce-Slots: letzter Stand je Topic, solange der Ring voll ist (dicht, Einfügereihenfolge)
+struct CoSlot {
+  uint32_t key;
+  uint16_t len;
+  char     line[CO_LINE_MAX];
+};
+static CoSlot s_co[CO_SLOTS];
+static size_t s_co_n = 0;
+
+// ---------------------------------------------------------------------------
+// Helpers (alle *_locked: nur unter s_mux)
+static inline bool starts_word(const char* s, size_t n, const char* w, size_t wn) {
+  return n >= wn && memcmp(s, w, wn) == 0 && (n == wn || s[wn] == ' ');
+}
+
+Class classify(const char* s, size_t n) {
+  if (starts_word(s, n, "ok", 2) || starts_word(s, n, "err", 3)) return C_RESP;
+  if (n >= 10 && memcmp(s, "evt trace.", 10) == 0) return C_TRACE;
+  if (n >= 4 && memcmp(s, "evt ", 4) == 0) return C_EVT;
+  return C_LOG;
+}
+
+// Topic von "evt <topic> …" → Schlüssel ≠ 0
+static uint32_t evt_key(const char* s, size_t n) {
+  if (n < 4) return 0;
+  size_t e = 4;
+  while (e < n && s[e] != ' ') ++e;
+  return bus::fnv1a(s + 4, e - 4) | 1u;
+}
+
+static inline void ring_put_locked(const char* s, size_t n) {
+  const size_t off   = s_head & (CONSOLE_TX_CAP - 1);
+  const size_t first = n < CONSOLE_TX_CAP - off ? n : CONSOLE_TX_CAP - off;
+  memcpy(s_ring + off, s, first);
+  memcpy(s_ring, s + first, n - first);
+  s_head += n;
+}
+
+static CoSlot* co_find_locked(uint32_t key) {
+  for (size_t i = 0; i < s_co_n; ++i) if (s_co[i].key == key) return &s_co[i];
+  return nullptr;
+}
+
+// Teilstücke einer Ausgabe (Frame: Kopf, Text, CRC) → ohne Zwischenpuffer in den Ring
+struct Seg {
+  const char* p;
+  size_t      n;
+};
+
+static void co_store(CoSlot* c, uint32_t key, const Seg* seg, size_t nseg, bool nl) {
+  c->key = key;
+  size_t w = 0;
+  for (size_t i = 0; i < nseg; ++i) { memcpy(c->line + w, seg[i].p, seg[i].n); w += seg[i].n; }
+  if (nl) { c->line[w++] = '\r'; c->line[w++] = '\n'; }
+  c->len = (uint16_t)w;
+}
+
+// Wartende Coalesce-Zeilen in Einfügereihenfolge nachschieben, solange Platz ist.
+// limit: resp darf für den Vortritt bis in die Reserve schreiben.
+static bool co_flush_locked(size_t limit = CONSOLE_TX_CAP - RESP_RESERVE) {
+  size_t i = 0;
+  while (i < s_co_n && (s_head - s_tail) + s_co[i].len <= limit) {
+    ring_put_locked(s_co[i].line, s_co[i].len);
+    ++i;
+  }
+  if (!i) return false;
+  memmove(s_co, s_co + i, (s_co_n - i) * sizeof(CoSlot));
+  s_co_n -= i;
+  return true;
+}
+
+static inline void kick() {
+  if (s_tx) xTaskNotifyGive(s_tx);
+}
+
+// ---------------------------------------------------------------------------
+// Schreiben
+// co_key: Coalesce-Schlüssel für Frames (bin-Modus); 0 → aus "evt <topic>" der Zeile.
+// Mehrteilige Ausgaben (Frames) werden nie abgeschnitten, nur ganz verworfen.
+static void put(Class cls, const Seg* seg, size_t nseg, bool nl, uint32_t co_key) {
+  if (!s_running) {                                  // vor begin(): synchron
+    for (size_t i = 0; i < nseg; ++i) Serial.write((const uint8_t*)seg[i].p, seg[i].n);
+    if (nl) Serial.write((const uint8_t*)"\r\n", 2);
+    return;
+  }
+
+  Seg one;
+  const size_t   limit = cls == C_RESP ? CONSOLE_TX_CAP : CONSOLE_TX_CAP - RESP_RESERVE;
+  const size_t   extra = nl ? 2 : 0;
+  size_t n = 0;
+  for (size_t i = 0; i < nseg; ++i) n += seg[i].n;
+  if (n + extra > limit) {
+    if (nseg != 1) { portENTER_CRITICAL(&s_mux); ++s_st.dropped[cls]; portEXIT_CRITICAL(&s_mux); return; }
+    one = { seg[0].p, limit - extra };               // Überlänge abschneiden
+    seg = &one;
+    n = one.n;
+  }
+  const size_t   need  = n + extra;
+  const Policy   pol   = cls == C_RESP ? P_BLOCK : (Policy)s_policy[cls];
+  const uint32_t key   = pol != P_COALESCE ? 0 : co_key ? co_key : (nl && nseg == 1) ? evt_key(seg[0].p, n) : 0;
+  const bool     self  = s_tx && xTaskGetCurrentTaskHandle() == s_tx;
+
+  for (;;) {
+    portENTER_CRITICAL(&s_mux);
+    const bool was_empty = s_head == s_tail;
+
+    // Neuerer Stand eines wartenden Topics ersetzt den alten
+    if (key) {
+      if (CoSlot* c = co_find_locked(key)) {
+        if (need <= CO_LINE_MAX) {
+          co_store(c, key, seg, nseg, nl);
+          ++s_st.coalesced[cls];
+          ++s_st.lines[cls];
+          portEXIT_CRITICAL(&s_mux);
+          return;
+        }
+        const size_t i = c - s_co;                   // zu lang → alten Stand verwerfen, Zeile normal
+        memmove(s_co + i, s_co + i + 1, (s_co_n - i - 1) * sizeof(CoSlot));
+        --s_co_n;
+        ++s_st.coalesced[cls];
+      }
+    }
+
+    // Reihenfolge: wartende Coalesce-Zeilen sind älter → zuerst; bis dahin
+    // reihen sich neue Topics hinten ein, alles andere wartet bzw. verwirft
+    if (s_co_n) co_flush_locked(limit);
+    if (!s_co_n && (s_head - s_tail) + need <= limit) {
+      for (size_t i = 0; i < nseg; ++i) ring_put_locked(seg[i].p, seg[i].n);
+      if (nl) ring_put_locked("\r\n", 2);
+      const uint32_t used = s_head - s_tail;
+      if (used > s_st.high_water) s_st.high_water = used;
+      ++s_st.lines[cls];
+      portEXIT_CRITICAL(&s_mux);
+      if (was_empty) kick();
+      return;
+    }
+
+    if (key && need <= CO_LINE_MAX && s_co_n < CO_SLOTS) {
+      co_store(&s_co[s_co_n++], key, seg, nseg, nl);
+      ++s_st.lines[cls];
+      portEXIT_CRITICAL(&s_mux);
+      return;
+    }
+
+    if (pol != P_BLOCK || self) {
+      ++s_st.dropped[cls];
+      portEXIT_CRITICAL(&s_mux);
+      return;
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    // block: resp (und log/evt/trace, falls so konfiguriert), nur bis der TX-Task Platz geschaffen hat
+    kick();
+    vTaskDelay(1);
+  }
+}
+
+static void put(Class cls, const char* s, size_t n, bool nl) {
+  const Seg one = { s, n };
+  put(cls, &one, 1, nl, 0);
+}
+
+void bin_line(Class cls, const char* s, size_t n);   // console_bin.cpp
+
+// Frame aus bis zu drei Teilen (Kopf, Nutzdaten, CRC) als eine Einheit
+void put_frame(Class cls, const uint8_t* a, size_t an, const char* b, size_t bn,
+               const uint8_t* c, size_t cn, uint32_t co_key) {
+  const Seg seg[3] = { { (const char*)a, an }, { b, bn }, { (const char*)c, cn } };
+  put(cls, seg, 3, false, co_key);
+  if (s_running) {
+    portENTER_CRITICAL(&s_mux);
+    ++s_st.frames;
+    portEXIT_CRITICAL(&s_mux);
+  }
+}
+
+static inline bool in_reply() {
+  return s_reply_depth && xTaskGetCurrentTaskHandle() == s_reply_task;
+}
+
+Reply::Reply() {
+  if (!s_reply_depth++) s_reply_task = xTaskGetCurrentTaskHandle();
+}
+Reply::~Reply() {
+  if (s_reply_depth && !--s_reply_depth) s_reply_task = nullptr;
+}
+
+void println(const char* s, size_t n) {
+  const Class cls = in_reply() ? C_RESP : classify(s, n);
+  if (mode() == MODE_BIN) { bin_line(cls, s, n); return; }
+  put(cls, s, n, true);
+}
+void println(const String& line) { println(line.c_str(), line.length()); }
+
+// Prompt nur im Textmodus (Frames haben kein "ohne Zeilenende")
+void print(const char* s) {
+  if (mode() == MODE_BIN) return;
+  put(C_RESP, s, strlen(s), false);
+}
+
+// ---------------------------------------------------------------------------
+// TX-Task
+static void tx_task(void*) {
+  if (s_hold_ms) vTaskDelay(pdMS_TO_TICKS(s_hold_ms));
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TX_IDLE_MS));
+
+    // Kurz sammeln, damit Serial große Blöcke bekommt
+    portENTER_CRITICAL(&s_mux);
+    const uint32_t pending = s_head - s_tail;
+    portEXIT_CRITICAL(&s_mux);
+    if (pending && pending < TX_BATCH_MIN) vTaskDelay(pdMS_TO_TICKS(TX_BATCH_WAIT_MS));
+
+    for (;;) {
+      portENTER_CRITICAL(&s_mux);
+      if (s_head == s_tail && !co_flush_locked()) { portEXIT_CRITICAL(&s_mux); break; }
+      const uint32_t tail = s_tail;
+      const uint32_t used = s_head - tail;
+      portEXIT_CRITICAL(&s_mux);
+
+      const size_t off = tail & (CONSOLE_TX_CAP - 1);
+      const size_t n   = used < CONSOLE_TX_CAP - off ? used : CONSOLE_TX_CAP - off;
+      Serial.write((const uint8_t*)s_ring + off, n);
+
+      portENTER_CRITICAL(&s_mux);
+      s_tail += n;
+      s_st.bytes_tx += n;
+      ++s_st.writes;
+      portEXIT_CRITICAL(&s_mux);
+    }
+  }
+}
+
+void begin(uint32_t hold_ms) {
+  if (s_running) return;
+  s_hold_ms = hold_ms;
+  if (xTaskCreatePinnedToCore(tx_task, "con_tx", 3072, nullptr, 1, &s_tx, 0) == pdPASS) s_running = true;
+}
+
+bool flush(uint32_t timeout_ms) {
+  if (!s_running) return true;
+  const uint32_t t0 = millis();
+  for (;;) {
+    portENTER_CRITICAL(&s_mux);
+    const bool empty = s_head == s_tail && s_co_n == 0;
+    portEXIT_CRITICAL(&s_mux);
+    if (empty) return true;
+    if (millis() - t0 >= timeout_ms) return false;
+    kick();
+    vTaskDelay(1);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Policy / Stats
+void set_policy(Class c, Policy p) {
+  if (c != C_RESP && c < CLASS_COUNT && p <= P_COALESCE) s_policy[c] = p;
+}
+Policy      policy(Class c)       { return c < CLASS_COUNT ? (Policy)s_policy[c] : P_BLOCK; }
+const char* class_name(Class c)   { return c < CLASS_COUNT ? CLASS_NAMES[c] : "?"; }
+const char* policy_name(Policy p) { return p <= P_COALESCE ? POLICY_NAMES[p] : "?"; }
+
+void stats(Stats& out) {
+  portENTER_CRITICAL(&s_mux);
+  out = s_st;
+  out.depth = s_head - s_tail;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+// console.policy.<evt|trace|log> = block|drop|coalesce
+static void on_policy(bus::topic_t topic, const bus::Payload& p) {
+  static const char PREFIX[] = "console.policy.";
+  size_t tn = 0;
+  const char* t = bus::topic_name(topic, &tn);
+  if (tn <= sizeof(PREFIX) - 1 || memcmp(t, PREFIX, sizeof(PREFIX) - 1) != 0) return;
+  const char* name = t + sizeof(PREFIX) - 1;
+  const size_t nn = tn - (sizeof(PREFIX) - 1);
+
+  const char* v; size_t vn;
+  if (!p.get_str(bus::k::value, &v, &vn)) return;
+  for (uint8_t pol = 0; pol <= P_COALESCE; ++pol) {
+    if (strlen(POLICY_NAMES[pol]) != vn || strncasecmp(POLICY_NAMES[pol], v, vn) != 0) continue;
+    for (uint8_t c = 0; c < CLASS_COUNT; ++c) {
+      if (strlen(CLASS_NAMES[c]) == nn && memcmp(CLASS_NAMES[c], name, nn) == 0) set_policy((Class)c, (Policy)pol);
+    }
+  }
+}
+
+void rx_init();   // console_rx.cpp
+
+void init() {
+  bus::subscribe("console.policy.*", on_policy);
+  rx_init();
+}
+
+} // namespace console
@@ -0,0 +1,137 @@
+// src/core/console.hpp
+// Konsolen-Ausgabe: Emitter schreiben Zeilen in einen Byte-Ring, ein TX-Task
+// leert ihn in großen Blöcken auf USB-CDC. Damit wartet kein Display-/Power-Code
+// mehr auf Serial.println, wenn der Host nicht liest oder `sub *` repliziert.
+//
+// Zeilenklassen (aus dem Zeilenanfang, Antworten nach Herkunft):
+//   resp  – "ok …", "err …", Prompt und jede Textzeile, die der Task während
+//           eines Befehls schreibt (Reply-Scope, z. B. info trace / sub trace.*
+//           mit "evt trace.…")        → nie verworfen (wartet im Notfall)
+//   evt   – "evt …"                       → Default coalesce (letzter Stand je Topic)
+//   trace – "evt trace.…" (live)          → Default drop
+//   log   – alles andere (Boot, [FS] …)   → Default drop (blockiert nie den Aufrufer)
+// Policy zur Laufzeit: console.policy.<evt|trace|log> = block|drop|coalesce
+// (INI [console.policy] oder `set console.policy.trace value=drop`).
+//
+// Reihenfolge: Zeilen erscheinen in Schreibreihenfolge. Warten coalesce-Zeilen
+// (Ring war voll), kommen sie vor jeder späteren Zeile heraus – eine Antwort
+// wartet dann, bis sie abgeflossen sind. Ein neuerer Stand desselben Topics
+// ersetzt den wartenden an dessen Position.
+//
+// Ausgabemodus (console_bin.cpp): `console mode=bin` schreibt Events typisiert
+// und alle übrigen Zeilen als Frames mit CRC (Format: console_frame.hpp), die
+// Eingabe bleibt zeilenweise Text. `console mode=text` schaltet zurück.
+//
+// Eingabe (console_rx.cpp): RX-Task setzt Zeilen bis CONSOLE_LINE_MAX in einem
+// festen Puffer zusammen; CR/LF übergibt sofort, console.rx.idle_flush_ms nur
+// als Fallback für Terminals ohne Zeilenende (0 = aus).
+
+#pragma once
+#include <Arduino.h>
+#include "topics.hpp"
+
+#ifndef CONSOLE_TX_CAP
+#define CONSOLE_TX_CAP 4096          // Byte-Ring, Zweierpotenz
+#endif
+#ifndef CONSOLE_RX_CAP
+#define CONSOLE_RX_CAP 4096          // Ring fertiger Eingabezeilen, Zweierpotenz
+#endif
+#ifndef CONSOLE_LINE_MAX
+#define CONSOLE_LINE_MAX 1024        // längste Eingabezeile (z. B. Batches mit ';')
+#endif
+
+namespace bus { class Payload; }
+
+namespace console {
+
+enum Class : uint8_t { C_RESP = 0, C_EVT, C_TRACE, C_LOG, CLASS_COUNT };
+enum Policy : uint8_t { P_BLOCK = 0, P_DROP, P_COALESCE };
+
+struct Stats {
+  uint32_t lines[CLASS_COUNT];       // angenommen (Ring oder Coalesce-Slot)
+  uint32_t dropped[CLASS_COUNT];
+  uint32_t coalesced[CLASS_COUNT];   // durch neueren Stand desselben Topics ersetzt
+  uint32_t bytes_tx;                 // an Serial übergeben
+  uint32_t writes;                   // Serial.write-Aufrufe
+  uint32_t high_water;               // max. Füllstand in Bytes
+  uint32_t depth;                    // aktueller Füllstand
+  uint32_t frames;                   // bin-Modus: erzeugte Frames (auch verworfene)
+};
+
+// TX-Task starten (direkt nach Serial.begin). Vorher wird synchron geschrieben.
+// hold_ms: TX-Task wartet so lange, bevor er Serial bedient (USB-CDC-Enumeration) –
+// Ausgaben sammeln sich solange im Ring, setup() läuft weiter.
+void begin(uint32_t hold_ms = 0);
+
+// Policies aus console.policy.* übernehmen (nach bus::init)
+void init();
+
+// Zeile (ohne CR/LF) ausgeben; Klasse aus dem Inhalt bzw. resp im Reply-Scope
+void println(const String& line);
+void println(const char* s, size_t n);
+
+// Reply-Scope: solange offen, sind Textzeilen dieses Tasks Antworten (resp).
+// api::handleLine öffnet ihn je Befehl; typisierte Events (evt()) bleiben evt.
+struct Reply {
+  Reply();
+  ~Reply();
+  Reply(const Reply&) = delete;
+  Reply& operator=(const Reply&) = delete;
+};
+
+// Ohne Zeilenende (Prompt), Klasse resp
+void print(const char* s);
+
+// Warten, bis der Ring geleert ist (z. B. vor Light-Sleep). false bei Timeout.
+bool flush(uint32_t timeout_ms);
+
+Class       classify(const char* s, size_t n);
+void        set_policy(Class c, Policy p);   // resp bleibt immer block
+Policy      policy(Class c);
+const char* class_name(Class c);
+const char* policy_name(Policy p);
+void        stats(Stats& out);
+
+// ---------------------------------------------------------------------------
+// Ausgabemodus
+enum Mode : uint8_t { MODE_TEXT = 0, MODE_BIN };
+
+void        set_mode(Mode m);    // bin: Topic-/Key-Ansagen beginnen neu
+void        announce();          // Ansagen neu beginnen, ohne Moduswechsel (`console announce`)
+Mode        mode();
+const char* mode_name(Mode m);
+
+// Event-Ausgabe der USB-Session (session::set_evt): bin → 'E'/'X'-Frame samt
+// Topic-/Key-Ansagen, text → "evt <topic> <kv>"
+void evt(bus::topic_t topic, const bus::Payload& p);
+
+// Event als Frame ('E', Textmodus-Payload 'X'); Länge, 0 wenn cap nicht reicht.
+// Ohne Topic-/Key-Ansagen (die schickt erst evt() im bin-Modus).
+size_t encode_evt(uint32_t topic, const bus::Payload& p, uint8_t* out, size_t cap);
+
+// ---------------------------------------------------------------------------
+// Eingabe
+struct RxStats {
+  uint32_t lines;          // fertige Zeilen
+  uint32_t bytes;
+  uint32_t overlong;       // > CONSOLE_LINE_MAX, verworfen
+  uint32_t idle_flushes;   // per Idle-Timeout statt CR/LF beendet
+  uint32_t stalls;         // Ring voll, RX-Task hat gewartet
+  uint32_t high_water;
+  uint32_t depth;
+};
+
+// RX-Task starten; fertige Zeilen wecken den aufrufenden Task (loop)
+void rx_begin();
+
+// Bytes in den Zeilen-Assembler (RX-Task; Host/Tests auch direkt)
+void rx_feed(const char* s, size_t n);
+
+// Nächste fertige Zeile (ohne CR/LF). overlong=true: Zeile war zu lang, n=0.
+bool read_line(char* buf, size_t cap, size_t* n, bool* overlong);
+
+// Bis zu ms auf die nächste Zeile warten (ersetzt delay(1) in loop)
+void rx_wait(uint32_t ms);
+void rx_stats(RxStats& out);
+
+} // namespace console
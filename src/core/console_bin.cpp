@@ -0,0 +1,168 @@
+// src/core/console_bin.cpp
+// Binärer Ausgabemodus (`console mode=bin`): console::evt kodiert Events direkt
+// aus der typisierten Payload (keine Textform, kein render()), übrige Zeilen
+// werden als 'L'-Frames verpackt. Topic- und Key-Namen gehen einmal je Modus-
+// wechsel bzw. `console announce` als 'T'/'K'-Frame voraus (Klasse resp → nie
+// verworfen), danach tragen Events nur noch IDs. Format: console_frame.hpp.
+#include "console.hpp"
+#include "console_frame.hpp"
+#include "bus.hpp"
+#include <string.h>
+
+namespace console {
+
+void put_frame(Class cls, const uint8_t* a, size_t an, const char* b, size_t bn,
+               const uint8_t* c, size_t cn, uint32_t co_key);   // console.cpp
+
+using namespace frame;
+
+static_assert(F_INT == (int)bus::Payload::T_INT && F_FLOAT == (int)bus::Payload::T_FLOAT &&
+              F_STR == (int)bus::Payload::T_STR,
+              "Frame-Feldtypen = Payload::Type");
+
+static constexpr size_t TOPIC_SET = 256;            // Zweierpotenz, max. 3/4 belegt
+
+static volatile uint8_t s_mode = MODE_TEXT;
+static uint32_t s_topic_sent[TOPIC_SET];            // angesagte Topic-IDs (0 = frei)
+static size_t   s_topic_n = 0;
+static uint32_t s_key_sent[256 / 32];               // Bitset angesagter Key-IDs
+
+static const char* const MODE_NAMES[] = { "text", "bin" };
+
+// ---------------------------------------------------------------------------
+// Ansagen
+static void announce_reset() {
+  memset(s_topic_sent, 0, sizeof(s_topic_sent));
+  memset(s_key_sent, 0, sizeof(s_key_sent));
+  s_topic_n = 0;
+}
+
+// true, wenn die ID neu ist (dann angesagt werden muss)
+static bool topic_mark(uint32_t id) {
+  if (s_topic_n >= TOPIC_SET * 3 / 4) announce_reset();   // voll → alles neu ansagen
+  size_t i = (id * 0x9E3779B1u) >> 24;
+  while (s_topic_sent[i]) {
+    if (s_topic_sent[i] == id) return false;
+    i = (i + 1) & (TOPIC_SET - 1);
+  }
+  s_topic_sent[i] = id;
+  ++s_topic_n;
+  return true;
+}
+
+// Frame = SYNC | len | pre[pn] | txt[tn] | crc – Text (Zeilen, Namen) wird nicht
+// umkopiert, sondern als eigenes Teilstück in den TX-Ring gelegt.
+static void send(Class cls, const uint8_t* pre, size_t pn, const char* txt, size_t tn, uint32_t co_key) {
+  uint8_t head[1 + 5 + BODY_MAX];
+  size_t h = 0;
+  head[h++] = SYNC;
+  h += put_varint(head + h, (uint32_t)(pn + tn));
+  memcpy(head + h, pre, pn);
+  h += pn;
+  const uint16_t crc = crc16((const uint8_t*)txt, tn, crc16(head + 1, h - 1));
+  const uint8_t tail[2] = { (uint8_t)crc, (uint8_t)(crc >> 8) };
+  put_frame(cls, head, h, txt, tn, tail, 2, co_key);
+}
+
+static void announce_topic(uint32_t id) {
+  uint8_t b[5] = { F_TOPIC };
+  put_u32(b + 1, id);
+  size_t nn = 0;
+  const char* name = bus::topic_name((bus::topic_t)id, &nn);
+  send(C_RESP, b, sizeof(b), name, nn < BODY_MAX - 5 ? nn : BODY_MAX - 5, 0);
+}
+
+static void announce_key(uint8_t key) {
+  uint32_t& word = s_key_sent[key >> 5];
+  const uint32_t bit = 1u << (key & 31);
+  if (word & bit) return;
+  word |= bit;
+  const uint8_t b[2] = { F_KEY, key };
+  const char* name = bus::key_name(key);
+  const size_t nn = strlen(name);
+  send(C_RESP, b, sizeof(b), name, nn < BODY_MAX - 2 ? nn : BODY_MAX - 2, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Kodierung
+// Typisierte Payload → 'E'-Body (max. 6 Felder × 18 Bytes < BODY_MAX);
+// Textmodus-Payload → nur Kopf 'X' + Topic + Flags, Text folgt separat (text/tn)
+static size_t evt_body(uint32_t topic, const bus::Payload& p, uint8_t* b, const char** text, size_t* tn) {
+  size_t w = 0;
+  *text = ""; *tn = 0;
+  b[w++] = p.is_text() ? F_EVT_TEXT : F_EVT;
+  put_u32(b + w, topic); w += 4;
+  if (p.is_text()) {
+    const size_t n = p.text().length();
+    b[w++] = n > TEXT_MAX ? XF_TRUNC : 0;
+    *text = p.text().c_str();
+    *tn = n > TEXT_MAX ? TEXT_MAX : n;
+    return w;
+  }
+  bus::Payload::FieldRef f;
+  for (size_t i = 0; p.field(i, f); ++i) {
+    w += put_varint(b + w, (uint32_t)f.key << 2 | f.type);
+    switch (f.type) {
+      case F_INT:   w += put_varint(b + w, zigzag(f.i)); break;
+      case F_FLOAT: { uint32_t u; memcpy(&u, &f.f, 4); put_u32(b + w, u); w += 4; break; }
+      default:      b[w++] = f.len; memcpy(b + w, f.s, f.len); w += f.len; break;
+    }
+  }
+  return w;
+}
+
+size_t encode_evt(uint32_t topic, const bus::Payload& p, uint8_t* out, size_t cap) {
+  uint8_t b[BODY_MAX];
+  const char* text; size_t tn;
+  size_t w = evt_body(topic, p, b, &text, &tn);
+  if (cap < w + tn + 1 + 2 + 2) return 0;
+  memcpy(b + w, text, tn);
+  return seal(b, w + tn, out);
+}
+
+static void bin_evt(bus::topic_t topic, const bus::Payload& p) {
+  const uint32_t id = (uint32_t)topic;
+  if (topic_mark(id)) announce_topic(id);
+  bus::Payload::FieldRef f;
+  for (size_t i = 0; p.field(i, f); ++i) announce_key(f.key);
+
+  size_t nn = 0;
+  const char* name = bus::topic_name(topic, &nn);
+  const Class cls = (nn > 6 && memcmp(name, "trace.", 6) == 0) ? C_TRACE : C_EVT;
+  uint8_t b[BODY_MAX];
+  const char* text; size_t tn;
+  const size_t w = evt_body(id, p, b, &text, &tn);
+  send(cls, b, w, text, tn, id | 1u);
+}
+
+// Zeile (ok/err/log/Trace-Record) als 'L'-Frame, Länge wie im Textmodus
+void bin_line(Class cls, const char* s, size_t n) {
+  const uint8_t b[2] = { F_LINE, cls };
+  send(cls, b, sizeof(b), s, n < LEN_MAX - 2 ? n : LEN_MAX - 2, 0);
+}
+
+// Event-Ausgabe der USB-Session (session::set_evt): bin → Frame direkt aus der
+// Payload, text → "evt <topic> <kv>" wie bisher
+void evt(bus::topic_t topic, const bus::Payload& p) {
+  if (s_mode == MODE_BIN) { bin_evt(topic, p); return; }
+  char kv[192];
+  const size_t n = p.render(kv, sizeof(kv));
+  String line = "evt ";
+  line += bus::topic_name(topic);
+  if (n) { line += " "; line += kv; }
+  println(line);
+}
+
+// ---------------------------------------------------------------------------
+// Modus
+void set_mode(Mode m) {
+  if (m == MODE_BIN) announce_reset();
+  s_mode = m == MODE_BIN ? MODE_BIN : MODE_TEXT;
+}
+
+void announce() { announce_reset(); }
+
+Mode        mode()           { return (Mode)s_mode; }
+const char* mode_name(Mode m) { return m <= MODE_BIN ? MODE_NAMES[m] : "?"; }
+
+} // namespace console
@@ -0,0 +1,89 @@
+// src/core/console_frame.hpp
+// Binäres Konsolenformat (`console mode=bin`): Events und Antworten als Frames
+// statt Textzeilen. Gemeinsam für Firmware (console_bin.cpp) und den
+// Host-Decoder (host/tools/twatch_decode.cpp) → nur Header, keine Abhängigkeiten.
+//
+//   0xA5 | len (varint) | type | body[len-1] | crc16 (LE)
+//   len   = Bytes von type + body
+//   crc16 = CRC-16/CCITT-FALSE über len-Bytes, type und body
+//
+// Frame-Typen:
+//   'E' Event     topic_id u32 LE, dann Felder bis Frame-Ende:
+//                 varint (key << 2 | ftype), Wert:
+//                   F_INT   zigzag-varint
+//                   F_FLOAT f32 LE
+//                   F_STR   u8 Länge + Bytes
+//   'X' Event     topic_id u32 LE + flags u8 + Freitext (Payload im Textmodus)
+//                 flags: XF_TRUNC = Text nach TEXT_MAX Bytes abgeschnitten
+//   'L' Zeile     class u8 (console::Class) + Text ohne CR/LF (ok/err/log/trace)
+//   'T' Topic     topic_id u32 LE + Name   (vor dem ersten Event eines Topics)
+//   'K' Key       key u8 + Name            (vor der ersten Nutzung eines Keys)
+// Ansagen gelten ab `console mode=bin` bzw. `console announce` (Decoder, der
+// mitten im Stream einsteigt: danach kommt jedes Topic/Key erneut vor dem Event).
+// 0xA5 kommt in Textausgaben nicht vor: Bytes außerhalb gültiger Frames sind Text
+// (z. B. die Antwort "ok console mode=bin" vor dem Umschalten).
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+namespace console {
+namespace frame {
+
+static constexpr uint8_t SYNC      = 0xA5;
+static constexpr size_t  BODY_MAX  = 320;                 // type + body bei Events/Ansagen
+static constexpr size_t  FRAME_MAX = 1 + 2 + BODY_MAX + 2;
+static constexpr size_t  LEN_MAX   = 4096;                // 'L'-Zeilen bis zur TX-Ringgröße
+
+enum Type : uint8_t { F_EVT = 'E', F_EVT_TEXT = 'X', F_LINE = 'L', F_TOPIC = 'T', F_KEY = 'K' };
+enum FieldType : uint8_t { F_INT = 1, F_FLOAT = 2, F_STR = 3 };   // = bus::Payload::Type
+
+static constexpr uint8_t XF_TRUNC = 0x01;                // 'X': Freitext gekürzt
+static constexpr size_t  TEXT_MAX = BODY_MAX - 6;        // 'X': type + topic + flags
+
+inline uint16_t crc16(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF) {
+  for (size_t i = 0; i < n; ++i) {
+    crc ^= (uint16_t)p[i] << 8;
+    for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? (uint16_t)(crc << 1 ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+inline size_t put_varint(uint8_t* d, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) { d[n++] = (uint8_t)(v | 0x80); v >>= 7; }
+  d[n++] = (uint8_t)v;
+  return n;
+}
+
+// 0 = unvollständig/zu lang
+inline size_t get_varint(const uint8_t* s, size_t n, uint32_t& v) {
+  v = 0;
+  for (size_t i = 0; i < n && i < 5; ++i) {
+    v |= (uint32_t)(s[i] & 0x7F) << (7 * i);
+    if (!(s[i] & 0x80)) return i + 1;
+  }
+  return 0;
+}
+
+inline uint32_t zigzag(int32_t v)    { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+inline int32_t  unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+inline void     put_u32(uint8_t* d, uint32_t v) { d[0] = (uint8_t)v; d[1] = (uint8_t)(v >> 8); d[2] = (uint8_t)(v >> 16); d[3] = (uint8_t)(v >> 24); }
+inline uint32_t get_u32(const uint8_t* s) { return (uint32_t)s[0] | (uint32_t)s[1] << 8 | (uint32_t)s[2] << 16 | (uint32_t)s[3] << 24; }
+
+// body (type + Nutzdaten, n ≤ BODY_MAX) in einen Frame verpacken → Frame-Länge
+inline size_t seal(const uint8_t* body, size_t n, uint8_t* out) {
+  size_t w = 0;
+  out[w++] = SYNC;
+  const size_t lw = put_varint(out + w, (uint32_t)n);
+  for (size_t i = 0; i < n; ++i) out[w + lw + i] = body[i];
+  const uint16_t crc = crc16(out + 1, lw + n);
+  w += lw + n;
+  out[w++] = (uint8_t)crc;
+  out[w++] = (uint8_t)(crc >> 8);
+  return w;
+}
+
+} // namespace frame
+} // namespace console
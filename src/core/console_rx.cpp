@@ -0,0 +1,196 @@
+// src/core/console_rx.cpp
+// Konsolen-Eingabe: ein RX-Task liest USB-CDC, sobald der Treiber Daten meldet
+// (RX-Event/onReceive → Task-Notify; RX_POLL_MS nur als Sicherheitsnetz), setzt
+// Zeilen in einem festen Puffer zusammen und legt fertige Zeilen in einen Ring.
+// Der Konsument (loop-Task) wird per Notify geweckt → keine 350-ms-Wartezeit.
+#include "console.hpp"
+#include "bus.hpp"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <string.h>
+
+namespace console {
+
+static_assert((CONSOLE_RX_CAP & (CONSOLE_RX_CAP - 1)) == 0, "CONSOLE_RX_CAP muss Zweierpotenz sein");
+static_assert(CONSOLE_LINE_MAX + 2 <= CONSOLE_RX_CAP, "CONSOLE_RX_CAP < CONSOLE_LINE_MAX");
+
+static constexpr uint32_t RX_POLL_MS   = 20;       // ohne RX-Event: so oft nachsehen
+static constexpr uint16_t LEN_OVERLONG = 0xFFFF;   // Ring-Eintrag: Zeile war zu lang
+
+// Ring fertiger Zeilen: [len lo][len hi][bytes…], head/tail monoton
+static uint8_t       s_ring[CONSOLE_RX_CAP];
+static uint32_t      s_head = 0, s_tail = 0;
+static portMUX_TYPE  s_mux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t  s_rx = nullptr;
+static TaskHandle_t  s_consumer = nullptr;
+static RxStats       s_st = {};
+
+// Assembler (nur RX-Task bzw. rx_feed-Aufrufer)
+static char          s_acc[CONSOLE_LINE_MAX];
+static size_t        s_acc_n = 0;
+static bool          s_skip = false;                // Überlänge: Rest bis Zeilenende verwerfen
+static uint32_t      s_last_rx = 0;
+static volatile uint32_t s_idle_ms = 350;           // console.rx.idle_flush_ms, 0 = aus
+
+// ---------------------------------------------------------------------------
+// Ring
+static inline void ring_put_locked(const uint8_t* s, size_t n) {
+  for (size_t i = 0; i < n; ++i) s_ring[(s_head + i) & (CONSOLE_RX_CAP - 1)] = s[i];
+  s_head += n;
+}
+
+static inline void ring_get_locked(uint8_t* d, size_t n) {
+  for (size_t i = 0; i < n; ++i) d[i] = s_ring[(s_tail + i) & (CONSOLE_RX_CAP - 1)];
+  s_tail += n;
+}
+
+// Fertige Zeile ablegen; bei vollem Ring wartet der RX-Task (Gegendruck auf USB)
+static void push(const char* s, uint16_t len) {
+  const size_t need = 2 + (len == LEN_OVERLONG ? 0 : len);
+  for (;;) {
+    portENTER_CRITICAL(&s_mux);
+    if ((s_head - s_tail) + need <= CONSOLE_RX_CAP) {
+      const uint8_t hdr[2] = { (uint8_t)(len & 0xFF), (uint8_t)(len >> 8) };
+      ring_put_locked(hdr, 2);
+      if (len != LEN_OVERLONG) ring_put_locked((const uint8_t*)s, len);
+      const uint32_t used = s_head - s_tail;
+      if (used > s_st.high_water) s_st.high_water = used;
+      portEXIT_CRITICAL(&s_mux);
+      if (s_consumer) xTaskNotifyGive(s_consumer);
+      return;
+    }
+    ++s_st.stalls;
+    portEXIT_CRITICAL(&s_mux);
+    if (s_consumer) xTaskNotifyGive(s_consumer);
+    vTaskDelay(1);
+  }
+}
+
+static void finish_line() {
+  if (s_skip) {
+    ++s_st.overlong;
+    push(nullptr, LEN_OVERLONG);
+  } else if (s_acc_n) {
+    ++s_st.lines;
+    push(s_acc, (uint16_t)s_acc_n);
+  }
+  s_acc_n = 0;
+  s_skip = false;
+}
+
+// ---------------------------------------------------------------------------
+// Assembler
+void rx_feed(const char* s, size_t n) {
+  s_st.bytes += n;
+  s_last_rx = millis();
+  for (size_t i = 0; i < n; ++i) {
+    const char c = s[i];
+    if (c == '\r' || c == '\n') { finish_line(); continue; }
+    if (c == '\b' || c == 0x7F) { if (s_acc_n && !s_skip) --s_acc_n; continue; }
+    if (s_skip) continue;
+    if (s_acc_n == CONSOLE_LINE_MAX) { s_skip = true; continue; }
+    s_acc[s_acc_n++] = c;
+  }
+}
+
+// Fallback für Terminals ohne Zeilenende: Rest nach idle_flush_ms ohne Eingabe
+static void idle_check() {
+  const uint32_t idle = s_idle_ms;
+  if (!idle || (!s_acc_n && !s_skip)) return;
+  if (millis() - s_last_rx < idle) return;
+  ++s_st.idle_flushes;
+  finish_line();
+}
+
+bool read_line(char* buf, size_t cap, size_t* n, bool* overlong) {
+  portENTER_CRITICAL(&s_mux);
+  if (s_head == s_tail) { portEXIT_CRITICAL(&s_mux); return false; }
+  uint8_t hdr[2];
+  ring_get_locked(hdr, 2);
+  const uint16_t len = (uint16_t)(hdr[0] | hdr[1] << 8);
+  if (len == LEN_OVERLONG) {
+    portEXIT_CRITICAL(&s_mux);
+    *n = 0; *overlong = true;
+    return true;
+  }
+  const size_t take = len < cap ? len : cap;        // cap < CONSOLE_LINE_MAX: abschneiden
+  ring_get_locked((uint8_t*)buf, take);
+  s_tail += len - take;
+  portEXIT_CRITICAL(&s_mux);
+  *n = take; *overlong = false;
+  return true;
+}
+
+void rx_wait(uint32_t ms) {
+  portENTER_CRITICAL(&s_mux);
+  const bool pending = s_head != s_tail;
+  portEXIT_CRITICAL(&s_mux);
+  if (!pending) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+}
+
+void rx_stats(RxStats& out) {
+  portENTER_CRITICAL(&s_mux);
+  out = s_st;
+  out.depth = s_head - s_tail;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+// ---------------------------------------------------------------------------
+// RX-Task
+static void rx_kick() { if (s_rx) xTaskNotifyGive(s_rx); }
+
+#if ARDUINO_USB_MODE && ARDUINO_USB_CDC_ON_BOOT
+static void on_cdc_event(void*, esp_event_base_t, int32_t, void*) { rx_kick(); }
+#endif
+
+static void rx_task(void*) {
+  char buf[128];
+  for (;;) {
+    uint32_t wait = RX_POLL_MS;
+    const uint32_t idle = s_idle_ms;
+    if (idle && (s_acc_n || s_skip)) {
+      const uint32_t since = millis() - s_last_rx;
+      wait = since >= idle ? 1 : (idle - since < wait ? idle - since : wait);
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+
+    int avail;
+    while ((avail = Serial.available()) > 0) {
+      size_t n = 0;
+      while (n < sizeof(buf) && avail-- > 0) {
+        const int c = Serial.read();
+        if (c < 0) break;
+        buf[n++] = (char)c;
+      }
+      if (!n) break;
+      rx_feed(buf, n);
+    }
+    idle_check();
+  }
+}
+
+void rx_begin() {
+  if (s_rx) return;
+  s_consumer = xTaskGetCurrentTaskHandle();
+  if (xTaskCreatePinnedToCore(rx_task, "con_rx", 4096, nullptr, 2, &s_rx, 0) != pdPASS) { s_rx = nullptr; return; }
+#if ARDUINO_USB_MODE && ARDUINO_USB_CDC_ON_BOOT
+  Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, on_cdc_event);
+#else
+  Serial.onReceive(rx_kick);
+#endif
+}
+
+// console.rx.idle_flush_ms = <ms>  (0 = nur CR/LF beendet eine Zeile)
+static void on_rx_config(bus::topic_t topic, const bus::Payload& p) {
+  size_t tn = 0;
+  const char* t = bus::topic_name(topic, &tn);
+  static const char KEY[] = "console.rx.idle_flush_ms";
+  if (tn != sizeof(KEY) - 1 || memcmp(t, KEY, tn) != 0 || !p.has(bus::k::value)) return;
+  s_idle_ms = (uint32_t)p.get_int(bus::k::value, 350);   // 0..10000, Config-Schema
+}
+
+void rx_init() {
+  bus::subscribe("console.rx.*", on_rx_config);
+}
+
+} // namespace console
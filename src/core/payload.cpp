@@ -0,0 +1,416 @@
+// src/core/payload.cpp
+#include "payload.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace bus {
+
+// ---------------------------------------------------------------------------
+// Key-Registry
+static const char* const KEY_NAMES[] = {
+#define BUS_KEY_NAME(n) #n,
+  BUS_KEYS(BUS_KEY_NAME)
+#undef BUS_KEY_NAME
+};
+static std::vector<String> s_dyn_keys;   // IDs ab k::COUNT_
+
+uint8_t key_find(const char* name, size_t n) {
+  for (uint8_t i = 0; i < k::COUNT_; ++i) {
+    if (strlen(KEY_NAMES[i]) == n && memcmp(KEY_NAMES[i], name, n) == 0) return i;
+  }
+  for (size_t i = 0; i < s_dyn_keys.size(); ++i) {
+    const String& s = s_dyn_keys[i];
+    if (s.length() == n && memcmp(s.c_str(), name, n) == 0) return (uint8_t)(k::COUNT_ + i);
+  }
+  return k::NONE;
+}
+
+uint8_t key_id(const char* name, size_t n) {
+  const uint8_t id = key_find(name, n);
+  if (id != k::NONE) return id;
+  if (k::COUNT_ + s_dyn_keys.size() >= k::NONE) return k::NONE;
+  s_dyn_keys.push_back(String(name, n));
+  return (uint8_t)(k::COUNT_ + s_dyn_keys.size() - 1);
+}
+
+const char* key_name(uint8_t id) {
+  if (id < k::COUNT_) return KEY_NAMES[id];
+  if (id != k::NONE && (size_t)(id - k::COUNT_) < s_dyn_keys.size()) return s_dyn_keys[id - k::COUNT_].c_str();
+  return "?";
+}
+
+// ---------------------------------------------------------------------------
+// Helpers
+static bool is_canonical_int(const char* s, size_t n) {
+  size_t i = (n && s[0] == '-') ? 1 : 0;
+  if (i == n || n - i > 9) return false;
+  if (s[i] == '0' && n - i > 1) return false;   // "007" bleibt String
+  for (; i < n; ++i) if (s[i] < '0' || s[i] > '9') return false;
+  return true;
+}
+
+static int parse_int(const char* s, size_t n, int def) {
+  char tmp[16];
+  if (!n || n >= sizeof(tmp)) return def;
+  memcpy(tmp, s, n); tmp[n] = 0;
+  char* end = nullptr;
+  const bool hex = n > 2 && tmp[0] == '0' && (tmp[1] == 'x' || tmp[1] == 'X');
+  long v = strtol(tmp, &end, hex ? 16 : 10);
+  return end == tmp ? def : (int)v;
+}
+
+static float parse_float(const char* s, size_t n, float def) {
+  char tmp[24];
+  if (!n || n >= sizeof(tmp)) return def;
+  memcpy(tmp, s, n); tmp[n] = 0;
+  char* end = nullptr;
+  float v = strtof(tmp, &end);
+  return end == tmp ? def : v;
+}
+
+// Wert braucht Quotes (Tokenizer trennt an Leerzeichen, '"' öffnet Quotes,
+// '\\' bleibt nur in Quotes eindeutig; leer → "" statt eines nackten k=)
+static bool needs_quote(const char* v, size_t n) {
+  if (!n) return true;
+  for (size_t i = 0; i < n; ++i) if (v[i] == ' ' || v[i] == '\t' || v[i] == '"' || v[i] == '\\') return true;
+  return false;
+}
+
+// Wert (ggf. in Quotes, '"' und '\\' escaped) ab buf[w]; Rückgabe: neues w (≤ cap-1)
+static size_t put_value(char* buf, size_t cap, size_t w, const char* v, size_t n) {
+  const bool q = needs_quote(v, n);
+  if (q && w + 1 < cap) buf[w++] = '"';
+  for (size_t i = 0; i < n && w + 1 < cap; ++i) {
+    if (q && (v[i] == '"' || v[i] == '\\')) {
+      if (w + 2 >= cap) break;
+      buf[w++] = '\\';
+    }
+    buf[w++] = v[i];
+  }
+  if (q && w + 1 < cap) buf[w++] = '"';
+  return w;
+}
+
+// Ende des Tokens ab i (Leerzeichen außerhalb von Quotes)
+static size_t token_end(const char* t, size_t i, size_t tn) {
+  bool q = false;
+  for (; i < tn; ++i) {
+    if (q && t[i] == '\\' && i + 1 < tn) { ++i; continue; }
+    if (t[i] == '"') q = !q;
+    else if (t[i] == ' ' && !q) break;
+  }
+  return i;
+}
+
+static bool span_eq_ci(const char* s, size_t n, const char* lit) {
+  size_t m = strlen(lit);
+  if (m != n) return false;
+  for (size_t i = 0; i < n; ++i) if (tolower((unsigned char)s[i]) != lit[i]) return false;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Builder
+Payload::Field* Payload::slot(uint8_t key) {
+  for (uint8_t i = 0; i < _n; ++i) if (_f[i].key == key) return &_f[i];
+  if (_n >= MAX_FIELDS) return nullptr;
+  Field* f = &_f[_n++];
+  f->key = key;
+  return f;
+}
+
+// Typisierte Felder in Text überführen (selten: Überlauf)
+void Payload::spill() {
+  if (_text.length() || !_n) return;
+  char buf[256];
+  render(buf, sizeof(buf));
+  _text = buf;
+  _n = 0;
+  _s_used = 0;
+}
+
+void Payload::append_text(uint8_t key, const char* v, size_t n) {
+  for (uint8_t i = 0; i < _n; ++i) {               // alter Wert desselben Keys fällt weg
+    if (_f[i].key != key) continue;
+    memmove(&_f[i], &_f[i + 1], (_n - i - 1) * sizeof(Field));
+    --_n;
+    break;
+  }
+  spill();
+  char buf[2 * STR_MAX + 3];
+  const size_t w = put_value(buf, sizeof(buf), 0, v, n);
+  if (_text.length()) _text += ' ';
+  _text += key_name(key); _text += '='; _text.concat(buf, w);
+}
+
+// String in die Arena; bei Platzmangel einmal verdichten (tote Werte fallen weg)
+bool Payload::set_str(uint8_t key, const char* v, size_t n) {
+  if (is_text() || n > STR_MAX) return false;
+  Field* f = (Field*)find(key);
+  if (f && f->type == T_STR && n <= f->len) {      // passt an die alte Stelle
+    memcpy(_s + f->off, v, n); _s[f->off + n] = 0;
+    f->len = (uint8_t)n;
+    return true;
+  }
+  if (!f && _n >= MAX_FIELDS) return false;
+  if (_s_used + n + 1 > ARENA) {
+    char tmp[ARENA];
+    uint8_t w = 0;
+    for (uint8_t i = 0; i < _n; ++i) {
+      Field& o = _f[i];
+      if (o.type != T_STR || o.key == key) continue;
+      memcpy(tmp + w, sp(o), o.len + 1u);
+      o.off = w;
+      w = (uint8_t)(w + o.len + 1);
+    }
+    memcpy(_s, tmp, w);
+    _s_used = w;
+    if (_s_used + n + 1 > ARENA) return false;
+  }
+  if (!f) f = slot(key);
+  f->type = T_STR;
+  f->off  = _s_used;
+  f->len  = (uint8_t)n;
+  memcpy(_s + _s_used, v, n); _s[_s_used + n] = 0;
+  _s_used = (uint8_t)(_s_used + n + 1);
+  return true;
+}
+
+Payload& Payload::set(uint8_t key, int v) {
+  Field* f = is_text() ? nullptr : slot(key);
+  if (!f) { char tmp[16]; append_text(key, tmp, (size_t)snprintf(tmp, sizeof(tmp), "%d", v)); return *this; }
+  f->type = T_INT; f->i = v;
+  return *this;
+}
+
+Payload& Payload::set(uint8_t key, float v) {
+  Field* f = is_text() ? nullptr : slot(key);
+  if (!f) { char tmp[24]; append_text(key, tmp, (size_t)snprintf(tmp, sizeof(tmp), "%g", (double)v)); return *this; }
+  f->type = T_FLOAT; f->f = v;
+  return *this;
+}
+
+Payload& Payload::set(uint8_t key, const char* v) {
+  if (!v) v = "";
+  const size_t n = strlen(v);
+  if (!set_str(key, v, n)) append_text(key, v, n);
+  return *this;
+}
+
+Payload& Payload::put(uint8_t key, const char* raw, size_t n) {
+  if (is_canonical_int(raw, n)) return set(key, parse_int(raw, n, 0));
+  if (!set_str(key, raw, n)) append_text(key, raw, n);
+  return *this;
+}
+
+Payload Payload::text(const String& t) {
+  Payload p;
+  p._text = t;
+  return p;
+}
+
+Payload Payload::parse(const char* kv, size_t n) {
+  Payload p;
+  size_t i = 0;
+  while (i < n) {
+    while (i < n && kv[i] == ' ') ++i;
+    if (i >= n) break;
+    size_t a = i;
+    i = token_end(kv, i, n);
+    const char* tok = kv + a;
+    const size_t tn = i - a;
+    const char* eq = (const char*)memchr(tok, '=', tn);
+    const char* v = eq ? eq + 1 : tok;
+    size_t vn = eq ? tn - (eq - tok) - 1 : 0;
+    char unq[STR_MAX + 1];
+    if (vn >= 2 && v[0] == '"' && v[vn - 1] == '"') {   // "a \"b\"" → a "b" (wie render())
+      size_t w = 0;
+      for (size_t j = 1; j + 1 < vn && w <= STR_MAX; ++j) {
+        if (v[j] == '\\' && j + 2 < vn) ++j;
+        if (w < sizeof(unq)) unq[w] = v[j];
+        ++w;
+      }
+      v = unq; vn = w;
+    }
+    const uint8_t key = (eq && eq != tok) ? key_id(tok, eq - tok) : k::NONE;
+    if (key == k::NONE || vn > STR_MAX || (p._n == MAX_FIELDS && !p.find(key))) {
+      p = Payload(); p._text = String(kv, n); p._text.trim();   // Freitext / Überlauf
+      return p;
+    }
+    p.put(key, v, vn);
+  }
+  return p;
+}
+
+// ---------------------------------------------------------------------------
+// Lesen
+const Payload::Field* Payload::find(uint8_t key) const {
+  for (uint8_t i = 0; i < _n; ++i) if (_f[i].key == key) return &_f[i];
+  return nullptr;
+}
+
+// Textmodus: "key=" nur an Token-Anfang (kein Treffer in "xvalue=" oder in Quotes).
+// Gequotete Werte ohne die Quotes; Escapes bleiben stehen (Span zeigt in den Text).
+bool Payload::text_span(uint8_t key, const char** s, size_t* n) const {
+  const char* name = key_name(key);
+  const size_t kn = strlen(name);
+  const char* t = _text.c_str();
+  const size_t tn = _text.length();
+  for (size_t i = 0; i < tn; ) {
+    while (i < tn && t[i] == ' ') ++i;
+    const size_t e = token_end(t, i, tn);
+    if (e - i > kn && t[i + kn] == '=' && memcmp(t + i, name, kn) == 0) {
+      size_t a = i + kn + 1, b = e;
+      if (b - a >= 2 && t[a] == '"' && t[b - 1] == '"') { ++a; --b; }
+      *s = t + a; *n = b - a;
+      return true;
+    }
+    i = e;
+  }
+  return false;
+}
+
+bool Payload::field(size_t i, FieldRef& out) const {
+  if (i >= _n) return false;
+  const Field& f = _f[i];
+  out.key  = f.key;
+  out.type = f.type;
+  out.i    = f.type == T_INT ? f.i : 0;
+  out.f    = f.type == T_FLOAT ? f.f : 0.0f;
+  out.s    = f.type == T_STR ? sp(f) : nullptr;
+  out.len  = f.type == T_STR ? f.len : 0;
+  return true;
+}
+
+bool Payload::same(const Payload& o) const {
+  if (_n != o._n || _text != o._text) return false;
+  for (uint8_t i = 0; i < _n; ++i) {
+    const Field& a = _f[i];
+    const Field& b = o._f[i];
+    if (a.key != b.key || a.type != b.type) return false;
+    switch (a.type) {
+      case T_INT:   if (a.i != b.i) return false; break;
+      case T_FLOAT: if (memcmp(&a.f, &b.f, sizeof(a.f))) return false; break;
+      default:      if (a.len != b.len || memcmp(sp(a), o.sp(b), a.len)) return false; break;
+    }
+  }
+  return true;
+}
+
+bool Payload::has(uint8_t key) const {
+  const char* s; size_t n;
+  return find(key) || (is_text() && text_span(key, &s, &n));
+}
+
+int Payload::get_int(uint8_t key, int def) const {
+  if (const Field* f = find(key)) {
+    if (f->type == T_INT)   return f->i;
+    if (f->type == T_FLOAT) return (int)f->f;
+    return parse_int(sp(*f), f->len, def);
+  }
+  const char* s; size_t n;
+  return (is_text() && text_span(key, &s, &n)) ? parse_int(s, n, def) : def;
+}
+
+float Payload::get_float(uint8_t key, float def) const {
+  if (const Field* f = find(key)) {
+    if (f->type == T_FLOAT) return f->f;
+    if (f->type == T_INT)   return (float)f->i;
+    return parse_float(sp(*f), f->len, def);
+  }
+  const char* s; size_t n;
+  return (is_text() && text_span(key, &s, &n)) ? parse_float(s, n, def) : def;
+}
+
+bool Payload::get_bool(uint8_t key, bool def) const {
+  if (const Field* f = find(key)) {
+    if (f->type != T_STR) return f->type == T_INT ? f->i != 0 : f->f != 0.0f;
+  }
+  const char* s; size_t n;
+  if (!get_str(key, &s, &n)) return def;
+  if (span_eq_ci(s, n, "on") || span_eq_ci(s, n, "true") || span_eq_ci(s, n, "yes") || span_eq_ci(s, n, "1")) return true;
+  if (span_eq_ci(s, n, "off") || span_eq_ci(s, n, "false") || span_eq_ci(s, n, "no") || span_eq_ci(s, n, "0")) return false;
+  return def;
+}
+
+bool Payload::get_str(uint8_t key, const char** s, size_t* n) const {
+  if (const Field* f = find(key)) {
+    if (f->type != T_STR) return false;   // Zahlen: get_int/get_float
+    *s = sp(*f); *n = f->len;
+    return true;
+  }
+  return is_text() && text_span(key, s, n);
+}
+
+bool Payload::is(uint8_t key, const char* lit) const {
+  const char* s; size_t n;
+  if (!get_str(key, &s, &n)) return false;
+  return strlen(lit) == n && memcmp(s, lit, n) == 0;
+}
+
+String Payload::str(uint8_t key) const {
+  if (const Field* f = find(key)) {
+    if (f->type == T_INT)   return String(f->i);
+    if (f->type == T_FLOAT) { char tmp[24]; snprintf(tmp, sizeof(tmp), "%g", (double)f->f); return String(tmp); }
+    return String(sp(*f), f->len);
+  }
+  const char* s; size_t n;
+  return (is_text() && text_span(key, &s, &n)) ? String(s, n) : String();
+}
+
+// ---------------------------------------------------------------------------
+// Text
+static bool wanted(uint8_t key, const uint8_t* only, size_t n_only) {
+  if (!only) return true;
+  for (size_t i = 0; i < n_only; ++i) if (only[i] == key) return true;
+  return false;
+}
+
+size_t Payload::render(char* buf, size_t cap, const uint8_t* only, size_t n_only) const {
+  if (!cap) return 0;
+  if (is_text() && !only) {
+    size_t n = _text.length() < cap - 1 ? _text.length() : cap - 1;
+    memcpy(buf, _text.c_str(), n); buf[n] = 0;
+    return n;
+  }
+  size_t w = 0;
+  if (is_text()) {                                   // Projektion im Textmodus: k=v-Tokens filtern
+    const char* t = _text.c_str();
+    const size_t tn = _text.length();
+    for (size_t i = 0; i < tn && w + 1 < cap; ) {
+      while (i < tn && t[i] == ' ') ++i;
+      const size_t a = i;
+      i = token_end(t, i, tn);
+      const char* eq = (const char*)memchr(t + a, '=', i - a);
+      if (!eq || !wanted(key_find(t + a, eq - (t + a)), only, n_only)) continue;
+      const int r = snprintf(buf + w, cap - w, "%s%.*s", w ? " " : "", (int)(i - a), t + a);
+      if (r < 0) break;
+      w += (size_t)r;
+    }
+  }
+  for (uint8_t i = 0; i < _n && w + 1 < cap; ++i) {
+    const Field& f = _f[i];
+    if (!wanted(f.key, only, n_only)) continue;
+    int r;
+    if (f.type == T_INT)        r = snprintf(buf + w, cap - w, "%s%s=%ld", w ? " " : "", key_name(f.key), (long)f.i);
+    else if (f.type == T_FLOAT) r = snprintf(buf + w, cap - w, "%s%s=%g",  w ? " " : "", key_name(f.key), (double)f.f);
+    else                        r = snprintf(buf + w, cap - w, "%s%s=",    w ? " " : "", key_name(f.key));
+    if (r < 0) break;
+    w += (size_t)r;
+    if (w >= cap) break;
+    if (f.type == T_STR) w = put_value(buf, cap, w, sp(f), f.len);
+  }
+  if (w >= cap) w = cap - 1;
+  buf[w] = 0;
+  return w;
+}
+
+String Payload::to_string() const {
+  if (is_text()) return _text;
+  char buf[256];
+  render(buf, sizeof(buf));
+  return String(buf);
+}
+
+} // namespace bus
@@ -0,0 +1,134 @@
+// src/core/payload.hpp
+// Typisierte Event-Payloads für den Bus: kleines Inline-Array aus
+// (Key-ID, int | float | String). Strings liegen gemeinsam in einer Inline-
+// Arena (ARENA Bytes inkl. '\0' je String), z. B. Pfade oder ALDO-Listen aus der
+// Config. Der Emitter baut einmal, Abonnenten lesen Felder ohne Parsing und ohne
+// Heap. Die Textform "k=v k=v" entsteht erst, wenn eine Konsolen-Senke sie
+// wirklich braucht (render()); Werte mit Leerzeichen, '"' oder '\\' bzw. leere
+// Werte werden dort in Quotes gesetzt ("a \"b\"") – wie sie der Tokenizer liest.
+//
+// Freitext (z. B. Log-Zeilen) oder Payloads mit mehr als MAX_FIELDS Feldern
+// bzw. mehr String-Bytes als die Arena fasst landen im Textmodus; die Accessoren
+// funktionieren dort weiter (Scan über den Text, ebenfalls ohne Allokation).
+
+#pragma once
+#include <Arduino.h>
+
+namespace bus {
+
+// Bekannte Keys (feste IDs). Weitere Keys (Konsole, INI, Traces) werden zur
+// Laufzeit interniert (IDs ab k::COUNT_, max. 254).
+#define BUS_KEYS(X) \
+  X(value) X(origin) X(target) X(mode) X(epoch) X(ms) X(path) X(bytes) \
+  X(op) X(rot) X(gamma) X(key) X(reason) X(src) X(edge) X(lvl) \
+  X(phase) X(tag) X(ok) X(vbat_mv) X(vsys_mv) X(vbus_mv) X(pct) X(duty) \
+  X(state) X(power) X(irq) X(cause) X(intent) X(rgb) X(x0) X(y0) \
+  X(w) X(h) X(hz) X(bits) X(x) X(y) X(g) X(b) X(init) X(en) X(st) \
+  X(err) X(vbus_in) X(chg_start) X(chg_done) X(n) X(reset) X(since)
+
+namespace k {
+enum : uint8_t {
+#define BUS_KEY_ENUM(n) n,
+  BUS_KEYS(BUS_KEY_ENUM)
+#undef BUS_KEY_ENUM
+  COUNT_
+};
+static constexpr uint8_t NONE = 0xFF;
+} // namespace k
+
+// Key-Name → ID (interniert unbekannte Namen; k::NONE wenn Tabelle voll)
+uint8_t     key_id(const char* name, size_t n);
+uint8_t     key_find(const char* name, size_t n);   // nur nachschlagen, k::NONE wenn unbekannt
+const char* key_name(uint8_t id);
+
+class Payload {
+public:
+  static constexpr size_t MAX_FIELDS = 6;
+  static constexpr size_t ARENA      = 64;           // Bytes für alle String-Felder zusammen
+  static constexpr size_t STR_MAX    = ARENA - 1;    // längster Einzelstring (ohne '\0')
+
+  enum Type : uint8_t { T_INT = 1, T_FLOAT, T_STR };
+
+  Payload() {}
+
+  // Builder (verkettbar). Zu lange Strings / zu viele Felder → Textmodus.
+  Payload& set(uint8_t key, int v);
+  Payload& set(uint8_t key, long v)          { return set(key, (int)v); }
+  Payload& set(uint8_t key, unsigned v)      { return set(key, (int)v); }
+  Payload& set(uint8_t key, unsigned long v) { return set(key, (int)v); }
+  Payload& set(uint8_t key, bool v)          { return set(key, v ? 1 : 0); }
+  Payload& set(uint8_t key, float v);
+  Payload& set(uint8_t key, double v)        { return set(key, (float)v); }
+  Payload& set(uint8_t key, const char* v);
+  Payload& set(uint8_t key, const String& v) { return set(key, v.c_str()); }
+
+  // Rohwert (INI/Konsole): kanonische Ganzzahl → int, sonst String
+  Payload& put(uint8_t key, const char* raw, size_t n);
+  Payload& put(uint8_t key, const String& raw) { return put(key, raw.c_str(), raw.length()); }
+
+  // "k=v k=v" parsen (Werte: kanonische Ganzzahlen → int, sonst String);
+  // alles ohne k=v-Struktur bleibt Freitext.
+  static Payload parse(const char* kv, size_t n);
+  static Payload parse(const String& kv) { return parse(kv.c_str(), kv.length()); }
+  static Payload text(const String& t);
+
+  // Lesen (ohne Heap)
+  bool    has(uint8_t key) const;
+  int     get_int(uint8_t key, int def = 0) const;
+  float   get_float(uint8_t key, float def = 0.0f) const;
+  bool    get_bool(uint8_t key, bool def = false) const;   // on/true/yes/1
+  bool    get_str(uint8_t key, const char** s, size_t* n) const;
+  bool    is(uint8_t key, const char* s) const;            // exakter Stringvergleich
+  String  str(uint8_t key) const;                          // Komfort (allokiert)
+
+  bool    is_text() const { return _text.length() > 0; }
+  size_t  field_count() const { return _n; }
+  const String& text() const { return _text; }
+
+  // Feld i < field_count() roh lesen (Serialisierer, z. B. console_bin)
+  struct FieldRef {
+    uint8_t     key;
+    uint8_t     type;    // Type
+    int32_t     i;
+    float       f;
+    const char* s;
+    uint8_t     len;
+  };
+  bool    field(size_t i, FieldRef& out) const;
+  bool    empty() const { return !_n && !_text.length(); }
+  // Gleicher Inhalt (Felder in gleicher Reihenfolge bzw. gleicher Text), z. B. Config-Diff
+  bool    same(const Payload& o) const;
+
+  // Textform in einen Puffer (abgeschnitten, immer '\0'-terminiert).
+  // only/n_only: Projektion auf diese Keys (Reihenfolge wie in der Payload)
+  size_t  render(char* buf, size_t cap, const uint8_t* only = nullptr, size_t n_only = 0) const;
+  String  to_string() const;
+
+private:
+  struct Field {
+    uint8_t key;
+    uint8_t type;
+    uint8_t len;              // T_STR: Länge in der Arena
+    uint8_t off;              // T_STR: Offset in _s
+    union {
+      int32_t i;
+      float   f;
+    };
+  };
+
+  Field*       slot(uint8_t key);
+  const Field* find(uint8_t key) const;
+  const char*  sp(const Field& f) const { return _s + f.off; }
+  bool         set_str(uint8_t key, const char* v, size_t n);   // false = passt nicht (→ Text)
+  bool         text_span(uint8_t key, const char** s, size_t* n) const;
+  void         spill();
+  void         append_text(uint8_t key, const char* v, size_t n);
+
+  Field   _f[MAX_FIELDS] = {};
+  uint8_t _n = 0;
+  uint8_t _s_used = 0;
+  char    _s[ARENA] = {};
+  String  _text;   // Textmodus (leer = typisiert)
+};
+
+} // namespace bus
@@ -0,0 +1,265 @@
+// src/core/session.cpp
+#include "session.hpp"
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+#include <vector>
+
+namespace session {
+
+static constexpr size_t NAME_MAX = 12;
+
+struct Slot {
+  bool     open;
+  char     name[NAME_MAX];
+  line_fn  line;
+  evt_fn   evt;
+  bool     monitor;
+  std::vector<uint32_t> subs;   // Bus-Abo-IDs (Tag = Session-ID)
+  // Event-Limit: Token-Bucket in Milli-Events, Burst = rate
+  uint32_t rate, tokens, last_ms;
+  // Ring-Sessions: [len lo][len hi][bytes…], head/tail monoton, Index = & mask
+  // (cap Zweierpotenz, damit der uint32-Überlauf von head/tail nahtlos bleibt)
+  char*    ring;
+  uint32_t cap, mask, head, tail;
+  uint32_t lines, events, dropped_rate, dropped_full, high_water;
+};
+
+static Slot         s_slot[MAX];
+static uint8_t      s_replay = NONE;     // subscribe() repliziert gerade für diese Session
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// ---------------------------------------------------------------------------
+// Ring (nur Ring-Sessions)
+static void ring_put(Slot& s, const char* p, size_t n) {
+  if (n > 0xFFFF) n = 0xFFFF;
+  portENTER_CRITICAL(&s_mux);
+  if ((s.head - s.tail) + 2 + n > s.cap) {
+    ++s.dropped_full;
+    portEXIT_CRITICAL(&s_mux);
+    return;
+  }
+  const uint8_t hdr[2] = { (uint8_t)(n & 0xFF), (uint8_t)(n >> 8) };
+  for (size_t i = 0; i < 2; ++i) s.ring[(s.head + i) & s.mask] = (char)hdr[i];
+  s.head += 2;
+  for (size_t i = 0; i < n; ++i) s.ring[(s.head + i) & s.mask] = p[i];
+  s.head += n;
+  if (s.head - s.tail > s.high_water) s.high_water = s.head - s.tail;
+  ++s.lines;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+bool read_line(uint8_t sid, char* buf, size_t cap, size_t* n) {
+  if (!valid(sid) || !s_slot[sid].ring) return false;
+  Slot& s = s_slot[sid];
+  portENTER_CRITICAL(&s_mux);
+  if (s.head == s.tail) { portEXIT_CRITICAL(&s_mux); return false; }
+  const size_t len = (uint8_t)s.ring[s.tail & s.mask] | (size_t)(uint8_t)s.ring[(s.tail + 1) & s.mask] << 8;
+  s.tail += 2;
+  const size_t take = len < cap ? len : cap;
+  for (size_t i = 0; i < take; ++i) buf[i] = s.ring[(s.tail + i) & s.mask];
+  s.tail += len;
+  portEXIT_CRITICAL(&s_mux);
+  *n = take;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Ausgabe
+void write(uint8_t sid, const String& line) {
+  if (!valid(sid)) return;
+  Slot& s = s_slot[sid];
+  if (s.ring) { ring_put(s, line.c_str(), line.length()); return; }
+  ++s.lines;
+  if (s.line) s.line(line);
+}
+
+static bool rate_ok(Slot& s) {
+  if (!s.rate) return true;
+  const uint32_t now = millis();
+  uint32_t dt = now - s.last_ms;
+  s.last_ms = now;
+  if (dt > 1000) dt = 1000;
+  const uint32_t full = s.rate * 1000u;
+  s.tokens = s.tokens + dt * s.rate > full ? full : s.tokens + dt * s.rate;
+  if (s.tokens < 1000) return false;
+  s.tokens -= 1000;
+  return true;
+}
+
+// Event an eine Session; Replay (Antwort auf sub) ist nicht limitiert
+static void deliver(uint8_t sid, bus::topic_t topic, const bus::Payload& p, bool replay) {
+  Slot& s = s_slot[sid];
+  if (!replay && !rate_ok(s)) { ++s.dropped_rate; return; }
+  ++s.events;
+  if (s.evt) { ++s.lines; s.evt(topic, p); return; }
+
+  size_t tn = 0;
+  const char* t = bus::topic_name(topic, &tn);
+  if (s.ring && s.cap - (s.head - s.tail) < 2 + 4 + tn) { ++s.dropped_full; return; }   // voll: gar nicht erst rendern
+  char kv[192];
+  const size_t kn = p.render(kv, sizeof(kv));
+  if (s.ring) {                                    // ohne String: direkt in den Ring
+    char buf[4 + 96 + 1 + sizeof(kv)];
+    int n = snprintf(buf, sizeof(buf), "evt %.*s%s%s", (int)(tn < 96 ? tn : 96), t, kn ? " " : "", kv);
+    if (n < 0) return;
+    ring_put(s, buf, (size_t)n < sizeof(buf) ? (size_t)n : sizeof(buf) - 1);
+    return;
+  }
+  String line = "evt ";
+  line += t;
+  if (kn) { line += " "; line += kv; }
+  ++s.lines;
+  if (s.line) s.line(line);
+}
+
+// Typisierte Bus-Senke: jede Emission genau einmal je interessierter Session;
+// tags = Sessions mit passendem Abo (Treffer aus dem Bus-Trie)
+static void on_emit(bus::topic_t topic, const bus::Payload& p, uint32_t tags) {
+  if (s_replay != NONE) { deliver(s_replay, topic, p, true); return; }
+  for (uint8_t sid = 0; sid < MAX; ++sid) {
+    const Slot& s = s_slot[sid];
+    if (s.open && (s.monitor || (tags >> sid & 1))) deliver(sid, topic, p, false);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Lebenszyklus
+static void reset(Slot& s) {
+  delete[] s.ring;
+  s.subs.clear();
+  s.subs.shrink_to_fit();
+  s.open = false; s.name[0] = 0; s.line = nullptr; s.evt = nullptr; s.monitor = false;
+  s.rate = 0; s.tokens = 0; s.last_ms = 0;
+  s.ring = nullptr; s.cap = s.mask = s.head = s.tail = 0;
+  s.lines = s.events = s.dropped_rate = s.dropped_full = s.high_water = 0;
+}
+
+void init() {
+  for (Slot& s : s_slot) reset(s);
+  s_replay = NONE;
+  bus::set_evt_sink(on_emit);
+}
+
+static uint8_t take(uint8_t from, const char* name, bool monitor) {
+  for (uint8_t sid = from; sid < MAX; ++sid) {
+    Slot& s = s_slot[sid];
+    if (s.open) continue;
+    reset(s);
+    s.open = true;
+    strncpy(s.name, name ? name : "", NAME_MAX - 1);
+    s.name[NAME_MAX - 1] = 0;
+    s.monitor = monitor;
+    return sid;
+  }
+  return NONE;
+}
+
+uint8_t open(const char* name, line_fn line, evt_fn evt, bool monitor) {
+  const uint8_t sid = take(CONSOLE + 1, name, monitor);
+  if (sid != NONE) { s_slot[sid].line = line; s_slot[sid].evt = evt; }
+  return sid;
+}
+
+uint8_t open_ring(const char* name, size_t cap, bool monitor) {
+  size_t pow2 = 64;
+  while (pow2 < cap && pow2 < 0x80000000u) pow2 <<= 1;   // aufrunden auf Zweierpotenz
+  const uint8_t sid = take(CONSOLE + 1, name, monitor);
+  if (sid == NONE) return NONE;
+  s_slot[sid].ring = new char[pow2];
+  s_slot[sid].cap  = (uint32_t)pow2;
+  s_slot[sid].mask = (uint32_t)pow2 - 1;
+  return sid;
+}
+
+void open_console(line_fn line) {
+  close(CONSOLE);
+  take(CONSOLE, "console", true);
+  s_slot[CONSOLE].line = line;
+}
+
+void set_evt(uint8_t sid, evt_fn evt) { if (valid(sid)) s_slot[sid].evt = evt; }
+
+void close(uint8_t sid) {
+  if (sid >= MAX || !s_slot[sid].open) return;
+  unsubscribe_all(sid);
+  portENTER_CRITICAL(&s_mux);
+  s_slot[sid].open = false;
+  portEXIT_CRITICAL(&s_mux);
+  reset(s_slot[sid]);
+}
+
+bool valid(uint8_t sid) { return sid < MAX && s_slot[sid].open; }
+
+// ---------------------------------------------------------------------------
+// Abos
+uint32_t subscribe(uint8_t sid, const String& pattern, bool has_since, uint32_t epoch, uint32_t since,
+                   bool* delta, size_t* replayed) {
+  if (!valid(sid)) return 0;
+  s_replay = sid;                                   // Replay nur an diese Session
+  const uint32_t id = has_since ? bus::subscribe_since(pattern, sid, epoch, since, delta, replayed)
+                                : bus::subscribe(pattern, sid);
+  s_replay = NONE;
+  s_slot[sid].subs.push_back(id);
+  return id;
+}
+
+bool owns(uint8_t sid, uint32_t id) {
+  if (!valid(sid)) return false;
+  for (uint32_t sub : s_slot[sid].subs) if (sub == id) return true;
+  return false;
+}
+
+bool unsubscribe(uint8_t sid, uint32_t id) {
+  if (!owns(sid, id)) return false;
+  std::vector<uint32_t>& v = s_slot[sid].subs;
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (v[i] != id) continue;
+    bus::unsubscribe(id);
+    v.erase(v.begin() + i);
+    return true;
+  }
+  return false;
+}
+
+size_t unsubscribe_all(uint8_t sid) {
+  if (!valid(sid)) return 0;
+  Slot& s = s_slot[sid];
+  size_t n = 0;
+  for (uint32_t id : s.subs) if (bus::unsubscribe(id)) ++n;
+  s.subs.clear();
+  return n;
+}
+
+// ---------------------------------------------------------------------------
+// Einstellungen / Stats
+void set_monitor(uint8_t sid, bool on) { if (valid(sid)) s_slot[sid].monitor = on; }
+
+void set_rate(uint8_t sid, uint32_t per_s) {
+  if (!valid(sid)) return;
+  Slot& s = s_slot[sid];
+  s.rate = per_s > 1000000 ? 1000000 : per_s;
+  s.tokens = s.rate * 1000u;
+  s.last_ms = millis();
+}
+
+bool info(uint8_t sid, Info& out) {
+  if (sid >= MAX) return false;
+  const Slot& s = s_slot[sid];
+  portENTER_CRITICAL(&s_mux);
+  out.name = s.name;
+  out.open = s.open;
+  out.monitor = s.monitor;
+  out.subs = (uint32_t)s.subs.size();
+  out.rate = s.rate;
+  out.lines = s.lines;
+  out.events = s.events;
+  out.dropped_rate = s.dropped_rate;
+  out.dropped_full = s.dropped_full;
+  out.depth = s.head - s.tail;
+  out.high_water = s.high_water;
+  out.cap = s.cap;
+  portEXIT_CRITICAL(&s_mux);
+  return s.open;
+}
+
+} // namespace session
@@ -0,0 +1,78 @@
+// src/core/session.hpp
+// Konsolen-Sessions: jeder Transport (USB-CDC, später UART/LoRa, Host-Tests)
+// bekommt eine Session-ID mit eigenem Abo-Satz, eigener Ausgabe und eigenem
+// Event-Limit. Events gehen nur an Sessions, die sie abonniert haben; eine
+// langsame Session verwirft bei sich (Ring voll / Limit) und bremst nie den
+// Emitter oder andere Sessions.
+//
+// Ausgabe je Session:
+//   open()       – Transport schreibt selbst (USB: console::println / console::evt)
+//   open_ring()  – Zeilen-Ring in der Session, der Transport holt mit read_line()
+//
+// monitor=on: alle Events (wie die frühere globale Bus-Senke), Default nur für
+// die Konsole (CONSOLE). Abos liefern dann nur das Replay, live kommt alles einmal.
+// Antworten (ok/err) sind nie limitiert; das Limit gilt für Events (rate/s).
+//
+// Abos je Session: unbegrenzt (wie beim Bus). Jedes Abo ist ein Konsolen-Abo
+// im Bus-Trie mit der Session-ID als Tag; der Emit meldet die getroffenen
+// Sessions als Maske, hier wird kein Pattern mehr verglichen.
+
+#pragma once
+#include <Arduino.h>
+#include "bus.hpp"
+
+namespace session {
+
+static constexpr uint8_t MAX      = 4;
+static constexpr uint8_t CONSOLE  = 0;      // USB-Konsole (api::init)
+static constexpr uint8_t NONE     = 0xFF;
+static constexpr size_t  RING_DEFAULT = 2048;   // Ring-Größe wird auf Zweierpotenz aufgerundet
+static_assert(MAX <= bus::TAG_MAX, "Session-ID ist Bus-Tag");
+
+using line_fn = bus::sink_fn;                                   // Antwort-/Eventzeile
+using evt_fn  = void (*)(bus::topic_t topic, const bus::Payload& p);   // typisiert (z. B. bin-Modus)
+
+struct Info {
+  const char* name;
+  bool     open;
+  bool     monitor;
+  uint32_t subs;
+  uint32_t rate;            // Events/s, 0 = unbegrenzt
+  uint32_t lines;           // ausgegebene Zeilen (inkl. Events)
+  uint32_t events;
+  uint32_t dropped_rate;    // über dem Limit verworfen
+  uint32_t dropped_full;    // Ring voll
+  uint32_t depth;           // Ring: aktueller Füllstand (Bytes)
+  uint32_t high_water;
+  uint32_t cap;             // Ring-Größe (Zweierpotenz), 0 = eigene Ausgabe
+};
+
+// Tabelle leeren und als typisierte Bus-Senke einhängen (api::init)
+void init();
+
+// Session öffnen → ID oder NONE (Tabelle voll). CONSOLE ist fest Slot 0.
+uint8_t open(const char* name, line_fn line, evt_fn evt = nullptr, bool monitor = false);
+uint8_t open_ring(const char* name, size_t cap = RING_DEFAULT, bool monitor = false);
+void    open_console(line_fn line);           // Slot CONSOLE, monitor=on
+void    set_evt(uint8_t sid, evt_fn evt);      // z. B. console::evt für bin-Modus
+void    close(uint8_t sid);                    // Abos werden mit entfernt
+bool    valid(uint8_t sid);
+
+// Ausgabe (Antworten): nie limitiert, bei vollem Ring verworfen + gezählt
+void write(uint8_t sid, const String& line);
+
+// Ring-Sessions: nächste Zeile (ohne CR/LF) für den Transport
+bool read_line(uint8_t sid, char* buf, size_t cap, size_t* n);
+
+// Abos der Session. Rückgabe: Bus-Abo-ID (0 = Session ungültig)
+uint32_t subscribe(uint8_t sid, const String& pattern, bool has_since, uint32_t epoch, uint32_t since,
+                   bool* delta = nullptr, size_t* replayed = nullptr);
+bool     unsubscribe(uint8_t sid, uint32_t id);   // nur eigene IDs
+size_t   unsubscribe_all(uint8_t sid);
+bool     owns(uint8_t sid, uint32_t id);
+
+void set_monitor(uint8_t sid, bool on);
+void set_rate(uint8_t sid, uint32_t per_s);
+bool info(uint8_t sid, Info& out);
+
+} // namespace session
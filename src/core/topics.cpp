@@ -0,0 +1,126 @@
+// src/core/topics.cpp
+#include "topics.hpp"
+#include <string.h>
+#include <vector>
+
+namespace bus {
+
+struct TopicEntry {
+  topic_t     id;
+  const char* name;   // Literal oder interniert (nie freigegeben, daher TOPIC_MAX)
+  uint16_t    len;
+};
+
+// Generierte Reverse-Tabelle (Compile-Zeit-IDs + Literale)
+static const TopicEntry REGISTERED[] = {
+#define BUS_TOPIC_ENTRY(id, name) { t::id, name, (uint16_t)(sizeof(name) - 1) },
+  BUS_TOPICS(BUS_TOPIC_ENTRY)
+#undef BUS_TOPIC_ENTRY
+};
+
+static constexpr uint16_t IDX_EMPTY   = 0xFFFF;
+static constexpr size_t   IDX_MIN_CAP = 128;   // Zweierpotenz
+
+// Alle Einträge (registrierte zuerst) + Hash-Index ID → Eintrag
+static std::vector<TopicEntry> s_entries;
+static std::vector<uint16_t>   s_index;
+static uint32_t s_probed = 0;   // Namen auf Ausweich-ID
+static uint32_t s_full   = 0;   // abgelehnt: Tabelle voll / Sondierung erschöpft
+
+static_assert(TOPIC_MAX < IDX_EMPTY, "TOPIC_MAX: Index ist uint16_t");
+
+// Sondierfolge einer Kollision: k = 0 ist der FNV-Hash selbst (0 → Ersatz), danach
+// Ausweich-IDs (ungerader Multiplikator, nie 0). intern und find_topic laufen
+// dieselbe Folge ab, bis der Name passt oder die ID frei ist.
+static topic_t probe_id(uint32_t h, uint32_t k) {
+  uint32_t id = h ^ (k * 0x9E3779B1u);
+  if (!id) id = 0x9E3779B1u;
+  return (topic_t)id;
+}
+
+static void index_insert(uint16_t e) {
+  const size_t mask = s_index.size() - 1;
+  size_t i = (uint32_t)s_entries[e].id & mask;
+  while (s_index[i] != IDX_EMPTY) i = (i + 1) & mask;
+  s_index[i] = e;
+}
+
+// Füllgrad ≤ 3/4; true = neu aufgebaut (alle Einträge bereits einsortiert)
+static bool index_reserve(size_t count) {
+  size_t cap = s_index.size();
+  if (cap && count * 4 <= cap * 3) return false;
+  if (!cap) cap = IDX_MIN_CAP;
+  while (count * 4 > cap * 3) cap <<= 1;
+  s_index.assign(cap, IDX_EMPTY);
+  for (size_t e = 0; e < s_entries.size(); ++e) index_insert((uint16_t)e);
+  return true;
+}
+
+static void ensure_init() {
+  if (!s_entries.empty()) return;
+  const size_t n = sizeof(REGISTERED) / sizeof(REGISTERED[0]);
+  s_entries.assign(REGISTERED, REGISTERED + n);
+  index_reserve(n);
+}
+
+static const TopicEntry* entry_of(topic_t id) {
+  ensure_init();
+  const size_t mask = s_index.size() - 1;
+  for (size_t i = (uint32_t)id & mask; s_index[i] != IDX_EMPTY; i = (i + 1) & mask) {
+    const TopicEntry& e = s_entries[s_index[i]];
+    if (e.id == id) return &e;
+  }
+  return nullptr;
+}
+
+static bool same_name(const TopicEntry& e, const char* name, size_t n) {
+  return e.len == n && memcmp(e.name, name, n) == 0;
+}
+
+// Sucht den Namen entlang der Sondierfolge; *free_id = erste freie ID (NONE = erschöpft)
+static topic_t lookup(const char* name, size_t n, topic_t* free_id) {
+  const uint32_t h = fnv1a(name, n);
+  for (uint32_t k = 0; k < TOPIC_PROBE_MAX; ++k) {
+    const topic_t id = probe_id(h, k);
+    const TopicEntry* e = entry_of(id);
+    if (!e) { if (free_id) *free_id = id; return topic_t::NONE; }
+    if (same_name(*e, name, n)) return id;
+  }
+  if (free_id) *free_id = topic_t::NONE;
+  return topic_t::NONE;
+}
+
+topic_t find_topic(const char* name, size_t n) {
+  if (!n) return topic_t::NONE;
+  return lookup(name, n, nullptr);
+}
+
+topic_t intern(const char* name, size_t n) {
+  if (!n || n > 0xFFFF) return topic_t::NONE;
+  topic_t id = topic_t::NONE;
+  const topic_t hit = lookup(name, n, &id);
+  if (hit != topic_t::NONE) return hit;
+  if (id == topic_t::NONE || s_entries.size() >= TOPIC_MAX) { ++s_full; return topic_t::NONE; }
+  if (id != (topic_t)fnv1a(name, n)) ++s_probed;
+  char* copy = new char[n + 1];
+  memcpy(copy, name, n); copy[n] = 0;
+  s_entries.push_back({ id, copy, (uint16_t)n });
+  if (!index_reserve(s_entries.size())) index_insert((uint16_t)(s_entries.size() - 1));
+  return id;
+}
+
+const char* topic_name(topic_t id, size_t* len) {
+  const TopicEntry* e = entry_of(id);
+  if (len) *len = e ? e->len : 1;
+  return e ? e->name : "?";
+}
+
+size_t topic_count() {
+  ensure_init();
+  return s_entries.size();
+}
+
+uint32_t topic_probed() { return s_probed; }
+uint32_t topic_full()   { return s_full; }
+
+} // namespace bus
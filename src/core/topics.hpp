@@ -0,0 +1,169 @@
+// src/core/topics.hpp
+// Topic-Registry: alle intern benutzten Topics stehen einmal in BUS_TOPICS.
+// Jedes Literal wird zur Compile-Zeit per FNV-1a zu einer topic_t-ID gehasht
+// (bus::t::<name>); Emits, Abos und der Sticky-Store arbeiten nur mit IDs.
+// Die Rückrichtung ID → Name (Konsole) erzeugt topics.cpp aus derselben Liste.
+//
+// Laufzeit-Topics (Konsole `emit`/`set`, INI-Keys) laufen über intern():
+// gleicher Hash, d. h. "backlight.gamma" aus der INI trifft t::backlight_gamma.
+// Nur bei einer Laufzeit-Kollision weicht die ID vom Hash ab.
+
+#pragma once
+#include <Arduino.h>
+
+namespace bus {
+
+enum class topic_t : uint32_t { NONE = 0 };
+
+// FNV-1a (32 Bit) – identisch für constexpr-Literale und Laufzeit-Strings
+constexpr uint32_t fnv1a(const char* s, size_t n) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; ++i) { h ^= (uint8_t)s[i]; h *= 16777619u; }
+  return h;
+}
+constexpr size_t cstr_len(const char* s) {
+  size_t n = 0;
+  while (s[n]) ++n;
+  return n;
+}
+constexpr topic_t topic_of(const char* lit) { return (topic_t)fnv1a(lit, cstr_len(lit)); }
+
+#define BUS_TOPICS(X) \
+  /* Power / Zeit / UI */ \
+  X(power_mode_changed,           "power.mode_changed") \
+  X(power_intent,                 "power.intent") \
+  X(power_last_call,              "power.last_call") \
+  X(power_sleep_autowake_ms,      "power.sleep.autowake_ms") \
+  X(power_dev_prevent_lightsleep, "power.dev.prevent_lightsleep") \
+  X(power_dev_prevent_standby,    "power.dev.prevent_standby") \
+  X(power_resume_dump,            "power.resume.dump") \
+  X(power_axp_irq,                "power.axp.irq") \
+  X(state_power_telemetry,        "state.power.telemetry") \
+  X(log_persist_path,             "log.persist.path") \
+  X(log_persist_tail_bytes,       "log.persist.tail_bytes") \
+  X(time_ready,                   "time.ready") \
+  X(ui_brightness,                "ui.brightness") \
+  X(ui_cal_cmd,                   "ui.cal.cmd") \
+  X(ui_cal_gamma,                 "ui.cal.gamma") \
+  X(ui_cal_rot,                   "ui.cal.rot") \
+  X(wake_touch_standby,           "wake.touch_standby") \
+  X(wake_touch_lightsleep,        "wake.touch_lightsleep") \
+  X(config_saved,                 "config.saved") \
+  /* Boot-Stages (Readiness-Stickies, siehe boot.hpp) */ \
+  X(boot_pmu,                     "boot.pmu") \
+  X(boot_display,                 "boot.display") \
+  X(boot_touch,                   "boot.touch") \
+  X(boot_telemetry,               "boot.telemetry") \
+  X(boot_fs,                      "boot.fs") \
+  X(boot_ready,                   "boot.ready") \
+  /* IRQ-Quellen (Deferred-Queue) */ \
+  X(pmu_irq,                      "pmu.irq") \
+  X(touch_irq,                    "touch.irq") \
+  X(touch_power,                  "touch.power") \
+  /* Treiber-Keys (INI / set) */ \
+  X(backlight_pwm_timer_hz,       "backlight.pwm_timer_hz") \
+  X(backlight_pwm_resolution_bits,"backlight.pwm_resolution_bits") \
+  X(backlight_min_pct,            "backlight.min_pct") \
+  X(backlight_gamma,              "backlight.gamma") \
+  X(display_rotate,               "display.rotate") \
+  X(display_fill,                 "display.fill") \
+  X(display_test,                 "display.test") \
+  X(display_offset_rot0,          "display.offset.rot0") \
+  X(display_offset_rot1,          "display.offset.rot1") \
+  X(display_offset_rot2,          "display.offset.rot2") \
+  X(display_offset_rot3,          "display.offset.rot3") \
+  X(display_colmod,               "display.colmod") \
+  X(display_rgb565_endian,        "display.rgb565_endian") \
+  X(display_spi_mode,             "display.spi_mode") \
+  X(display_spi_hz,               "display.spi_hz") \
+  X(display_color_order,          "display.color_order") \
+  X(display_invert,               "display.invert") \
+  X(spi0_slice_ms,                "spi0.slice_ms") \
+  X(spi0_prio,                    "spi0.prio") \
+  X(spi0_role,                    "spi0.role") \
+  X(i2c0_timeout_ms,              "i2c0.timeout_ms") \
+  X(i2c0_retry,                   "i2c0.retry") \
+  /* Traces */ \
+  X(trace_drv_display_apply,      "trace.drv.display.apply") \
+  X(trace_drv_display_backlight,  "trace.drv.display.backlight") \
+  X(trace_drv_display_fill,       "trace.drv.display.fill") \
+  X(trace_drv_display_init,       "trace.drv.display.init") \
+  X(trace_drv_display_init_defaults, "trace.drv.display.init_defaults") \
+  X(trace_drv_display_panel,      "trace.drv.display.panel") \
+  X(trace_drv_display_pwm,        "trace.drv.display.pwm") \
+  X(trace_drv_display_spi,        "trace.drv.display.spi") \
+  X(trace_drv_display_window,     "trace.drv.display.window") \
+  X(trace_drv_touch_apply,        "trace.drv.touch.apply") \
+  X(trace_drv_touch_init,         "trace.drv.touch.init") \
+  X(trace_svc_config_persist,     "trace.svc.config.persist") \
+  X(trace_svc_display_ignored,    "trace.svc.display.ignored") \
+  X(trace_svc_power_autowake,     "trace.svc.power.autowake") \
+  X(trace_svc_power_autowake_set, "trace.svc.power.autowake.set") \
+  X(trace_svc_power_block,        "trace.svc.power.block") \
+  X(trace_svc_power_guard,        "trace.svc.power.guard") \
+  X(trace_svc_power_irq,          "trace.svc.power.irq") \
+  X(trace_svc_power_log,          "trace.svc.power.log") \
+  X(trace_svc_power_persist_path, "trace.svc.power.persist.path") \
+  X(trace_svc_power_persist_tail, "trace.svc.power.persist.tail") \
+  X(trace_svc_power_pmu_begin,    "trace.svc.power.pmu.begin") \
+  X(trace_svc_power_pmu_twatchS3, "trace.svc.power.pmu.twatchS3") \
+  X(trace_svc_power_policy,       "trace.svc.power.policy") \
+  X(trace_svc_power_resume,       "trace.svc.power.resume") \
+  X(trace_svc_power_resume_capsule, "trace.svc.power.resume.capsule") \
+  X(trace_svc_power_resume_persist, "trace.svc.power.resume.persist") \
+  X(trace_svc_power_warn,         "trace.svc.power.warn") \
+  X(trace_svc_touch_policy,       "trace.svc.touch.policy") \
+  X(trace_svc_touch_state,        "trace.svc.touch.state") \
+  X(trace_testing_diag_isr,       "trace.testing.diag.isr") \
+  X(trace_testing_diag_stats,     "trace.testing.diag.stats")
+
+namespace t {
+#define BUS_TOPIC_ID(id, name) constexpr topic_t id = topic_of(name);
+  BUS_TOPICS(BUS_TOPIC_ID)
+#undef BUS_TOPIC_ID
+} // namespace t
+
+// Kollisionen zwischen registrierten Literalen fallen schon beim Bauen auf
+namespace detail {
+constexpr topic_t REGISTERED_TOPICS[] = {
+#define BUS_TOPIC_REF(id, name) t::id,
+  BUS_TOPICS(BUS_TOPIC_REF)
+#undef BUS_TOPIC_REF
+};
+constexpr bool registered_topics_unique() {
+  constexpr size_t n = sizeof(REGISTERED_TOPICS) / sizeof(REGISTERED_TOPICS[0]);
+  for (size_t i = 0; i < n; ++i) {
+    if (REGISTERED_TOPICS[i] == topic_t::NONE) return false;
+    for (size_t j = i + 1; j < n; ++j) if (REGISTERED_TOPICS[i] == REGISTERED_TOPICS[j]) return false;
+  }
+  return true;
+}
+static_assert(registered_topics_unique(), "BUS_TOPICS: Hash-Kollision oder ID 0");
+} // namespace detail
+
+// Obergrenze registriert + interniert. Internierte Namen werden nie freigegeben
+// (IDs stecken in Stickies/Abos), daher fest begrenzt; info bus meldet topic_cap/topic_full.
+#ifndef BUS_TOPIC_MAX
+#define BUS_TOPIC_MAX 16384
+#endif
+static constexpr size_t   TOPIC_MAX       = BUS_TOPIC_MAX;
+static constexpr uint32_t TOPIC_PROBE_MAX = 8;   // Ausweich-IDs je Hash-Kollision
+
+// Laufzeit-Topic → ID (legt unbekannte Namen dauerhaft an). Kollidiert der Hash
+// mit einem anderen Namen, bekommt der neue eine Ausweich-ID (Sondierfolge) –
+// registrierte Literale behalten immer ihre Compile-Zeit-ID.
+// topic_t::NONE nur bei leerem Namen oder voller Tabelle (topic_full() zählt mit).
+topic_t intern(const char* name, size_t n);
+inline topic_t intern(const String& name) { return intern(name.c_str(), name.length()); }
+
+// Nur nachschlagen (kein Anlegen); NONE, wenn der Name nie interniert wurde
+topic_t find_topic(const char* name, size_t n);
+
+// Reverse-Tabelle: ID → Name ("?" für unbekannte IDs), optional mit Länge
+const char* topic_name(topic_t id, size_t* len = nullptr);
+
+size_t   topic_count();    // registriert + interniert
+uint32_t topic_probed();   // davon auf Ausweich-ID
+uint32_t topic_full();     // intern() abgelehnt (TOPIC_MAX erreicht)
+
+} // namespace bus
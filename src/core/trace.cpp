@@ -0,0 +1,168 @@
+// src/core/trace.cpp
+#include "trace.hpp"
+#include "bus.hpp"
+#include <atomic>
+#include <string.h>
+
+namespace trace {
+
+static_assert((TRACE_RING_CAP & (TRACE_RING_CAP - 1)) == 0, "TRACE_RING_CAP muss Zweierpotenz sein");
+
+uint8_t g_level[SUBSYS_COUNT] = {
+#define TRACE_SUBSYS_RDEF(id, name, cmax, rdef) rdef,
+  TRACE_SUBSYSTEMS(TRACE_SUBSYS_RDEF)
+#undef TRACE_SUBSYS_RDEF
+};
+
+static const char* const SUBSYS_NAMES[SUBSYS_COUNT] = {
+#define TRACE_SUBSYS_NAME(id, name, cmax, rdef) name,
+  TRACE_SUBSYSTEMS(TRACE_SUBSYS_NAME)
+#undef TRACE_SUBSYS_NAME
+};
+
+static const char* const LEVEL_NAMES[] = { "off", "error", "warn", "info", "debug" };
+
+// Ring: seq pro Slot als Gültigkeitsmarke (0 = wird gerade geschrieben).
+// Leser kopieren und prüfen seq davor/danach → überholte Slots werden verworfen.
+struct Slot {
+  std::atomic<uint32_t> seq;
+  Record                r;
+};
+static Slot s_ring[TRACE_RING_CAP];
+static std::atomic<uint32_t> s_head{0};   // zuletzt vergebene seq
+
+static inline Slot* IRAM_ATTR claim(Subsys s, Level l, bus::topic_t topic, uint32_t* seq) {
+  *seq = s_head.fetch_add(1, std::memory_order_relaxed) + 1;
+  Slot* slot = &s_ring[*seq & (TRACE_RING_CAP - 1)];
+  slot->seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->r.seq   = *seq;
+  slot->r.t_ms  = millis();
+  slot->r.topic = topic;
+  slot->r.sub   = s;
+  slot->r.lvl   = l;
+  return slot;
+}
+
+void IRAM_ATTR rec(Subsys s, Level l, bus::topic_t topic, std::initializer_list<Arg> args) {
+  uint32_t seq;
+  Slot* slot = claim(s, l, topic, &seq);
+  uint8_t n = 0;
+  for (const Arg& a : args) {
+    if (n >= MAX_ARGS) break;
+    slot->r.a.key[n]  = a.key;
+    slot->r.a.type[n] = a.type;
+    slot->r.a.v[n]    = a.v;
+    ++n;
+  }
+  slot->r.n = n;
+  slot->seq.store(seq, std::memory_order_release);
+}
+
+void IRAM_ATTR txt(Subsys s, Level l, bus::topic_t topic, const char* text) {
+  uint32_t seq;
+  Slot* slot = claim(s, l, topic, &seq);
+  size_t i = 0;
+  if (text) { for (; i + 1 < TEXT_MAX && text[i]; ++i) slot->r.text[i] = text[i]; }
+  slot->r.text[i] = 0;
+  slot->r.n = TEXT;
+  slot->seq.store(seq, std::memory_order_release);
+}
+
+uint32_t written() { return s_head.load(std::memory_order_relaxed); }
+
+Cursor oldest() {
+  const uint32_t head = written();
+  Cursor c;
+  c.next = head > TRACE_RING_CAP ? head - TRACE_RING_CAP + 1 : 1;
+  return c;
+}
+
+bool read(Cursor& c, Record& out, uint32_t* lost) {
+  for (;;) {
+    const uint32_t head = written();
+    if (c.next > head) return false;
+    const Cursor o = oldest();
+    if (c.next < o.next) {                      // überholt
+      if (lost) *lost += o.next - c.next;
+      c.next = o.next;
+    }
+    const Slot& slot = s_ring[c.next & (TRACE_RING_CAP - 1)];
+    const uint32_t want = c.next;
+    const uint32_t s1 = slot.seq.load(std::memory_order_acquire);
+    if (s1 == 0 || s1 < want) return false;     // wird gerade geschrieben → später
+    out = slot.r;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32_t s2 = slot.seq.load(std::memory_order_relaxed);
+    ++c.next;
+    if (s1 == want && s2 == want) return true;
+    if (lost) ++*lost;                          // überholt / beim Lesen überschrieben
+  }
+}
+
+size_t render(const Record& r, char* buf, size_t cap) {
+  if (!cap) return 0;
+  size_t w = 0;
+  auto put = [&](int n) { if (n > 0) w += (size_t)n; if (w >= cap) w = cap - 1; };
+  put(snprintf(buf, cap, "evt %s t_ms=%lu", bus::topic_name(r.topic), (unsigned long)r.t_ms));
+  if (r.n == TEXT) {
+    put(snprintf(buf + w, cap - w, " %s", r.text));
+    return w;
+  }
+  for (uint8_t i = 0; i < r.n && i < MAX_ARGS && w + 1 < cap; ++i) {
+    const char* key = bus::key_name(r.a.key[i]);
+    const ArgVal& v = r.a.v[i];
+    switch (r.a.type[i]) {
+      case A_FLOAT: put(snprintf(buf + w, cap - w, " %s=%g", key, (double)v.f)); break;
+      case A_TOPIC: put(snprintf(buf + w, cap - w, " %s=%s", key, bus::topic_name((bus::topic_t)v.u))); break;
+      case A_HEX:   put(snprintf(buf + w, cap - w, " %s=0x%lx", key, (unsigned long)v.u)); break;
+      case A_LIT:   put(snprintf(buf + w, cap - w, " %s=%s", key, v.s ? v.s : "")); break;
+      default:      put(snprintf(buf + w, cap - w, " %s=%ld", key, (long)v.i)); break;
+    }
+  }
+  return w;
+}
+
+// ---------------------------------------------------------------------------
+// Level
+void set_level(Subsys s, Level l) {
+  if (s < SUBSYS_COUNT) g_level[s] = l > LV_DEBUG ? LV_DEBUG : l;
+}
+Level level(Subsys s) { return s < SUBSYS_COUNT ? (Level)g_level[s] : LV_OFF; }
+const char* subsys_name(Subsys s) { return s < SUBSYS_COUNT ? SUBSYS_NAMES[s] : "?"; }
+const char* level_name(Level l) { return l <= LV_DEBUG ? LEVEL_NAMES[l] : "?"; }
+
+bool parse_level(const char* s, size_t n, Level& out) {
+  if (n == 1 && s[0] >= '0' && s[0] <= '4') { out = (Level)(s[0] - '0'); return true; }
+  for (uint8_t i = 0; i <= LV_DEBUG; ++i) {
+    if (strlen(LEVEL_NAMES[i]) == n && strncasecmp(LEVEL_NAMES[i], s, n) == 0) { out = (Level)i; return true; }
+  }
+  return false;
+}
+
+// log.level.<subsys> = off|error|warn|info|debug  ("all" setzt alle Subsysteme)
+static void on_level(bus::topic_t topic, const bus::Payload& p) {
+  static const char PREFIX[] = "log.level.";
+  size_t tn = 0;
+  const char* t = bus::topic_name(topic, &tn);
+  if (tn <= sizeof(PREFIX) - 1 || memcmp(t, PREFIX, sizeof(PREFIX) - 1) != 0) return;
+  const char* name = t + sizeof(PREFIX) - 1;
+  const size_t nn = tn - (sizeof(PREFIX) - 1);
+
+  Level l;
+  const char* v; size_t vn;
+  if (p.get_str(bus::k::value, &v, &vn)) { if (!parse_level(v, vn, l)) return; }
+  else if (p.has(bus::k::value))         { l = (Level)p.get_int(bus::k::value); }
+  else return;
+
+  const bool all = nn == 3 && memcmp(name, "all", 3) == 0;
+  for (uint8_t s = 0; s < SUBSYS_COUNT; ++s) {
+    if (all || (strlen(SUBSYS_NAMES[s]) == nn && memcmp(SUBSYS_NAMES[s], name, nn) == 0)) set_level((Subsys)s, l);
+  }
+}
+
+void init() {
+  bus::subscribe("log.level.*", on_level);
+}
+
+} // namespace trace
@@ -0,0 +1,135 @@
+// src/core/trace.hpp
+// Trace-Facility: Diagnose landet nicht mehr als Sticky auf dem Bus, sondern als
+// binärer Record (Topic-ID + bis zu MAX_ARGS Zahlen, oder kurzer Text) in einem
+// festen RAM-Ring. Kein Heap, keine Sperre, kein Serial-Print im Aufrufer →
+// auch aus Zeichen-/Sleep-Pfaden und ISRs (IRAM) nutzbar.
+//
+// Level je Subsystem:
+//   - Compile-Zeit: Obergrenze aus TRACE_SUBSYSTEMS, gedeckelt durch
+//     -D TRACE_LEVEL_MAX=<0..4>. Darüber liegende Aufrufe verschwinden komplett.
+//   - Laufzeit: log.level.<subsys> (INI [log.level] oder `set log.level.<subsys> value=debug`),
+//     Test kostet einen Byte-Vergleich; Argumente werden nur bei aktivem Level ausgewertet.
+//
+// Auslesen: `info trace` (konsumierend), `sub trace.*` (Replay + live), siehe api_parser.
+
+#pragma once
+#include <Arduino.h>
+#include <initializer_list>
+#include "topics.hpp"
+
+#ifndef TRACE_LEVEL_MAX
+#define TRACE_LEVEL_MAX 4        // 0=off … 4=debug
+#endif
+#ifndef TRACE_RING_CAP
+#define TRACE_RING_CAP 128       // Records, Zweierpotenz
+#endif
+
+namespace trace {
+
+enum Level : uint8_t { LV_OFF = 0, LV_ERROR, LV_WARN, LV_INFO, LV_DEBUG };
+
+// X(id, "name", Compile-Obergrenze, Laufzeit-Default)
+#define TRACE_SUBSYSTEMS(X) \
+  X(core,        "core",        LV_DEBUG, LV_INFO) \
+  X(drv_display, "drv.display", LV_DEBUG, LV_INFO) \
+  X(drv_touch,   "drv.touch",   LV_DEBUG, LV_INFO) \
+  X(drv_power,   "drv.power",   LV_DEBUG, LV_INFO) \
+  X(svc_power,   "svc.power",   LV_DEBUG, LV_INFO) \
+  X(svc_display, "svc.display", LV_DEBUG, LV_INFO) \
+  X(svc_touch,   "svc.touch",   LV_DEBUG, LV_INFO) \
+  X(svc_config,  "svc.config",  LV_DEBUG, LV_INFO) \
+  X(testing,     "testing",     LV_DEBUG, LV_INFO)
+
+enum Subsys : uint8_t {
+#define TRACE_SUBSYS_ENUM(id, name, cmax, rdef) id,
+  TRACE_SUBSYSTEMS(TRACE_SUBSYS_ENUM)
+#undef TRACE_SUBSYS_ENUM
+  SUBSYS_COUNT
+};
+
+constexpr uint8_t COMPILE_LEVEL[SUBSYS_COUNT] = {
+#define TRACE_SUBSYS_CMAX(id, name, cmax, rdef) (cmax < TRACE_LEVEL_MAX ? cmax : TRACE_LEVEL_MAX),
+  TRACE_SUBSYSTEMS(TRACE_SUBSYS_CMAX)
+#undef TRACE_SUBSYS_CMAX
+};
+
+extern uint8_t g_level[SUBSYS_COUNT];   // Laufzeit-Level (nur via set_level schreiben)
+
+static constexpr size_t MAX_ARGS = 6;
+static constexpr size_t TEXT_MAX = 48;  // inkl. '\0'
+
+enum ArgType : uint8_t { A_INT = 0, A_FLOAT, A_TOPIC, A_HEX, A_LIT };
+
+struct Hex { uint32_t v; };   // Ausgabe als 0x…
+
+// Wert eines Arguments; A_LIT nur mit Literalen/statischen Strings (Zeiger wird gespeichert)
+union ArgVal { int32_t i; uint32_t u; float f; const char* s; };
+
+struct Arg {
+  uint8_t key;     // bus::k
+  uint8_t type;
+  ArgVal  v;
+  template <typename T>
+  Arg(uint8_t k, T x) : key(k), type(A_INT)  { v.i = (int32_t)x; }
+  Arg(uint8_t k, float x)        : key(k), type(A_FLOAT) { v.f = x; }
+  Arg(uint8_t k, double x)       : key(k), type(A_FLOAT) { v.f = (float)x; }
+  Arg(uint8_t k, bus::topic_t x) : key(k), type(A_TOPIC) { v.u = (uint32_t)x; }
+  Arg(uint8_t k, Hex x)          : key(k), type(A_HEX)   { v.u = x.v; }
+  Arg(uint8_t k, const char* x)  : key(k), type(A_LIT)   { v.s = x; }
+};
+
+// Kopie eines Records (Leser-Seite)
+struct Record {
+  uint32_t     seq;     // fortlaufend ab 1
+  uint32_t     t_ms;
+  bus::topic_t topic;
+  uint8_t      sub;
+  uint8_t      lvl;
+  uint8_t      n;       // Anzahl Args; TEXT = Textrecord
+  uint8_t      _pad;
+  union {
+    struct {
+      uint8_t key[MAX_ARGS];
+      uint8_t type[MAX_ARGS];
+      ArgVal  v[MAX_ARGS];
+    } a;
+    char text[TEXT_MAX];
+  };
+};
+static constexpr uint8_t TEXT = 0xFF;
+
+inline bool on(Subsys s, Level l) { return COMPILE_LEVEL[s] >= l && g_level[s] >= l; }
+
+// Schreiben (lock-frei, mehrere Produzenten, überschreibt die ältesten Records)
+void rec(Subsys s, Level l, bus::topic_t topic, std::initializer_list<Arg> args);
+void txt(Subsys s, Level l, bus::topic_t topic, const char* text);
+inline void txt(Subsys s, Level l, bus::topic_t topic, const String& text) { txt(s, l, topic, text.c_str()); }
+
+// Lesen: Cursor = nächste erwartete seq. Überholte Records zählen als lost.
+struct Cursor { uint32_t next = 1; };
+bool read(Cursor& c, Record& out, uint32_t* lost = nullptr);
+Cursor oldest();                 // Cursor auf den ältesten noch vorhandenen Record
+uint32_t written();              // Records gesamt seit Boot
+
+// "evt <topic> t_ms=… k=v …" in buf (abgeschnitten, '\0'-terminiert)
+size_t render(const Record& r, char* buf, size_t cap);
+
+// Level
+void        set_level(Subsys s, Level l);
+Level       level(Subsys s);
+const char* subsys_name(Subsys s);
+const char* level_name(Level l);
+bool        parse_level(const char* s, size_t n, Level& out);   // off|error|warn|info|debug|0..4
+
+// Laufzeit-Level aus log.level.<subsys> (Bus-Sticky) übernehmen
+void init();
+
+} // namespace trace
+
+#define TRACE_REC(sub, lvl, topic, ...) \
+  do { if (::trace::on(::trace::sub, ::trace::lvl)) \
+         ::trace::rec(::trace::sub, ::trace::lvl, ::bus::t::topic, { __VA_ARGS__ }); } while (0)
+
+#define TRACE_TXT(sub, lvl, topic, text) \
+  do { if (::trace::on(::trace::sub, ::trace::lvl)) \
+         ::trace::txt(::trace::sub, ::trace::lvl, ::bus::t::topic, (text)); } while (0)
@@ -1,5 +1,6 @@
 #include "drv_display_st7789v.hpp"
 #include "../core/bus.hpp"
+#include "../core/trace.hpp"
 #include <SPI.h>
 #include <algorithm>
 #include <cmath>
@@ -7,13 +8,7 @@
 
 namespace drv::display_st7789v {
 
-// ---------- kleines Telemetry-Wrapper ----------
-static inline void EMIT(const char* topic, const String& msg) {
-  bus::emit_sticky(String(topic), msg);
-}
-static inline void EMIT(const char* topic, const char* msg) {
-  bus::emit_sticky(String(topic), String(msg ? msg : ""));
-}
+namespace k = bus::k;
 
 // -------------------- Pins / SPI --------------------
 static constexpr int PIN_SCK   = 18;
@@ -83,10 +78,8 @@ static void set_addr_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
   write_cmd(CMD_RASET); write_data(ra, 4);
   write_cmd(CMD_RAMWR);
 
-  EMIT("trace.drv.display.window",
-       String("rot=")+String((int)g_rot)+
-       " x0="+String((int)x0)+" y0="+String((int)y0)+
-       " w="+String((int)w)+" h="+String((int)h));
+  TRACE_REC(drv_display, LV_DEBUG, trace_drv_display_window,
+            {k::rot, g_rot}, {k::x0, x0}, {k::y0, y0}, {k::w, w}, {k::h, h});
 }
 
 // ---------------- Backlight -------------------
@@ -97,8 +90,7 @@ static void backlight_apply(uint8_t pct) {
   uint32_t duty = (uint32_t)(powf(p, g_gamma) * max_duty + 0.5f);
   ledcWrite(g_pwm_chan, duty);
 
-  EMIT("trace.drv.display.backlight",
-       String("pct=") + String(pct) + " duty=" + String(duty));
+  TRACE_REC(drv_display, LV_DEBUG, trace_drv_display_backlight, {k::pct, pct}, {k::duty, duty});
 }
 void set_brightness_pct(uint8_t pct) { backlight_apply(pct); }
 
@@ -125,7 +117,7 @@ static void update_madctl_and_window() {
 
 // ---------------- Panel init -----------------
 static void panel_init() {
-  EMIT("trace.drv.display.panel", "init=1 rot=" + String(g_rot));
+  TRACE_REC(drv_display, LV_INFO, trace_drv_display_panel, {k::init, 1}, {k::rot, g_rot});
 
   write_cmd(CMD_SWRESET); delay(120);
   write_cmd(CMD_SLPOUT);  delay(100);
@@ -140,8 +132,8 @@ static void panel_init() {
   update_madctl_and_window(); // nutzt g_bgr=false + OFF_X/Y=0,0
   write_cmd(CMD_DISPON); delay(10);
 
-  EMIT("trace.drv.display.init_defaults",
-       "colmod=0x55 invert=on color_order=rgb off_all=0,0");
+  TRACE_TXT(drv_display, LV_INFO, trace_drv_display_init_defaults,
+            "colmod=0x55 invert=on color_order=rgb off_all=0,0");
 }
 
 // ---------------- Public API -----------------
@@ -154,39 +146,35 @@ void init() {
   // SPI
   spi.end();
   spi.begin(PIN_SCK, -1, PIN_MOSI, PIN_CS);
-  EMIT("trace.drv.display.spi", "mode=0 hz=40000000");
+  TRACE_REC(drv_display, LV_INFO, trace_drv_display_spi, {k::mode, 0}, {k::hz, 40000000});
 
   // PWM try → 20k/10bit, Fallback 19.5k/11bit
   bool ok = ledcSetup(g_pwm_chan, g_pwm_hz, g_pwm_bits);
   if (!ok) {
-    EMIT("trace.drv.display.pwm",
-         "setup_fail hz_req=20000 bits_req=10");
+    TRACE_REC(drv_display, LV_WARN, trace_drv_display_pwm, {k::ok, 0}, {k::hz, g_pwm_hz}, {k::bits, g_pwm_bits});
     g_pwm_hz = 19531; g_pwm_bits = 11;
     ok = ledcSetup(g_pwm_chan, g_pwm_hz, g_pwm_bits);
   }
   if (ok) {
     ledcAttachPin(PIN_BLK, g_pwm_chan);
-    EMIT("trace.drv.display.pwm",
-         String("setup_ok hz=") + String(g_pwm_hz) + " bits=" + String(g_pwm_bits));
+    TRACE_REC(drv_display, LV_INFO, trace_drv_display_pwm, {k::ok, 1}, {k::hz, g_pwm_hz}, {k::bits, g_pwm_bits});
   } else {
     digitalWrite(PIN_BLK, HIGH); // Hard ON als letzte Rettung
   }
 
   panel_init();
-  EMIT("trace.drv.display.init", "ok=1");
+  TRACE_REC(drv_display, LV_INFO, trace_drv_display_init, {k::ok, 1});
 }
 
 void rotate(uint8_t rot) {
   g_rot = (rot & 3);
   update_madctl_and_window();
-  EMIT("trace.drv.display.apply",
-       String("key=display.rotate value=") + String(g_rot));
+  TRACE_REC(drv_display, LV_INFO, trace_drv_display_apply, {k::key, bus::t::display_rotate}, {k::value, g_rot});
 }
 
 // Farblogik ist hart verdrahtet (RGB + invert=on) → Laufzeitänderung ignorieren
 void set_color_order_rgb(bool /*rgb_is_true*/) {
-  EMIT("trace.drv.display.apply",
-       "key=display.color_order ignored=hardwired_rgb");
+  TRACE_TXT(drv_display, LV_INFO, trace_drv_display_apply, "key=display.color_order ignored=hardwired_rgb");
 }
 
 // Vollflächen-Fill (konstant 16bpp, Hi→Lo)
@@ -209,9 +197,8 @@ void fill_rgb565(uint16_t rgb565) {
   }
   cs_high(); spi.endTransaction();
 
-  EMIT("trace.drv.display.fill",
-       String("rgb=") + String((rgb565 >> 11) & 0x1F) + "," +
-       String((rgb565 >> 5) & 0x3F) + "," + String(rgb565 & 0x1F));
+  TRACE_REC(drv_display, LV_DEBUG, trace_drv_display_fill,
+            {k::rgb, (rgb565 >> 11) & 0x1F}, {k::g, (rgb565 >> 5) & 0x3F}, {k::b, rgb565 & 0x1F});
 }
 
 void test_pattern(uint8_t /*which*/) {
@@ -254,86 +241,78 @@ void test_pattern(uint8_t /*which*/) {
   }
   cs_high(); spi.endTransaction();
 
-  EMIT("trace.drv.display.apply", "key=display.test");
+  TRACE_REC(drv_display, LV_INFO, trace_drv_display_apply, {k::key, bus::t::display_test});
 }
 
-void apply_kv(const String& key, const String& value) {
-  // Backlight params
-  if (key == "backlight.pwm_timer_hz") {
-    uint32_t hz = (uint32_t) value.toInt();
-    if (!hz) return;
-    g_pwm_hz = hz;
+void apply_kv(bus::topic_t key, const bus::Payload& p) {
+  // Backlight params: Werte kommen geprüft und geklemmt aus dem Config-Schema
+  if (key == bus::t::backlight_pwm_timer_hz) {
+    g_pwm_hz = (uint32_t) p.get_int(k::value, g_pwm_hz);
     bool ok = ledcSetup(g_pwm_chan, g_pwm_hz, g_pwm_bits);
-    EMIT("trace.drv.display.pwm", ok
-      ? String("setup_ok hz=") + String(g_pwm_hz) + " bits=" + String(g_pwm_bits)
-      : String("setup_fail hz_req=") + String(g_pwm_hz) + " bits_req=" + String(g_pwm_bits));
+    if (ok) TRACE_REC(drv_display, LV_INFO, trace_drv_display_pwm, {k::ok, 1}, {k::hz, g_pwm_hz}, {k::bits, g_pwm_bits});
+    else    TRACE_REC(drv_display, LV_WARN, trace_drv_display_pwm, {k::ok, 0}, {k::hz, g_pwm_hz}, {k::bits, g_pwm_bits});
     return;
   }
-  if (key == "backlight.pwm_resolution_bits") {
-    int bits = (int) value.toInt();
-    if (bits < 8) bits = 8;
-    if (bits > 15) bits = 15;
-    g_pwm_bits = (uint8_t) bits;
+  if (key == bus::t::backlight_pwm_resolution_bits) {
+    g_pwm_bits = (uint8_t) p.get_int(k::value, g_pwm_bits);
     bool ok = ledcSetup(g_pwm_chan, g_pwm_hz, g_pwm_bits);
-    EMIT("trace.drv.display.pwm", ok
-      ? String("setup_ok hz=") + String(g_pwm_hz) + " bits=" + String(g_pwm_bits)
-      : String("setup_fail hz_req=") + String(g_pwm_hz) + " bits_req=" + String(g_pwm_bits));
+    if (ok) TRACE_REC(drv_display, LV_INFO, trace_drv_display_pwm, {k::ok, 1}, {k::hz, g_pwm_hz}, {k::bits, g_pwm_bits});
+    else    TRACE_REC(drv_display, LV_WARN, trace_drv_display_pwm, {k::ok, 0}, {k::hz, g_pwm_hz}, {k::bits, g_pwm_bits});
     return;
   }
-  if (key == "backlight.min_pct") {
-    int v = (int)value.toInt();
-    v = std::max(0, std::min(100, v));
-    g_min_pct = (uint8_t) v;
-    EMIT("trace.drv.display.apply", String("key=")+key+" value="+value);
+  if (key == bus::t::backlight_min_pct) {
+    g_min_pct = (uint8_t) p.get_int(k::value, g_min_pct);
+    TRACE_REC(drv_display, LV_INFO, trace_drv_display_apply, {k::key, key}, {k::value, g_min_pct});
     return;
   }
-  if (key == "backlight.gamma") {
-    g_gamma = value.toFloat();
-    if (g_gamma < 0.1f) g_gamma = 0.1f;
-    EMIT("trace.drv.display.apply", String("key=")+key+" value="+value);
+  if (key == bus::t::backlight_gamma) {
+    g_gamma = p.get_float(k::value, g_gamma);
+    TRACE_REC(drv_display, LV_INFO, trace_drv_display_apply, {k::key, key}, {k::value, g_gamma});
     return;
   }
 
   // Rotation / Offsets
-  if (key == "display.rotate") {
-    rotate((uint8_t)value.toInt());
+  if (key == bus::t::display_rotate) {
+    rotate((uint8_t)p.get_int(k::value, g_rot));
     return;
   }
-  if (key == "display.offset.rot0" ||
-      key == "display.offset.rot1" ||
-      key == "display.offset.rot2" ||
-      key == "display.offset.rot3") {
+  if (key == bus::t::display_offset_rot0 ||
+      key == bus::t::display_offset_rot1 ||
+      key == bus::t::display_offset_rot2 ||
+      key == bus::t::display_offset_rot3) {
+    const String value = p.str(k::value);   // "x,y"
     int comma = value.indexOf(',');
     if (comma > 0) {
       int x = value.substring(0, comma).toInt();
       int y = value.substring(comma + 1).toInt();
-      int idx = key.charAt(key.length()-1) - '0';
+      size_t kl = 0;
+      const char* kn = bus::topic_name(key, &kl);
+      int idx = kn[kl-1] - '0';
       if (idx >=0 && idx <=3) { OFF_X[idx] = x; OFF_Y[idx] = y; }
       update_madctl_and_window();
-      EMIT("trace.drv.display.apply", String("key=")+key+" value="+value);
+      TRACE_REC(drv_display, LV_INFO, trace_drv_display_apply, {k::key, key}, {k::x, x}, {k::y, y});
     }
     return;
   }
 
   // Farbschalter sind hart verdrahtet → Laufzeit-Intents ignorieren (nur Telemetrie)
-  if (key == "display.color_order" || key == "display.invert") {
-    EMIT("trace.drv.display.apply", String("key=")+key+" ignored=hardwired");
+  if (key == bus::t::display_color_order || key == bus::t::display_invert) {
+    TRACE_TXT(drv_display, LV_INFO, trace_drv_display_apply, String("key=")+bus::topic_name(key)+" ignored=hardwired");
     return;
   }
 
   // Draw commands
-  if (key == "display.fill") {
+  if (key == bus::t::display_fill) {
     // RGB888 → RGB565 (inline, keine Helper)
-    String rgbHex;
-    int vpos = value.indexOf("rgb=");
-    if (vpos >= 0) rgbHex = value.substring(vpos+4);
-    else {
-      vpos = value.indexOf("value=");
-      if (vpos >= 0) rgbHex = value.substring(vpos+6);
-      else rgbHex = value;
+    const char* hex; size_t hn;
+    char tmp[12] = {0};
+    if (p.get_str(k::rgb, &hex, &hn) || p.get_str(k::value, &hex, &hn)) {
+      memcpy(tmp, hex, std::min(hn, sizeof(tmp) - 1));
+    } else {
+      // rein numerisch übergeben (z. B. value=112233) → Ziffern als Hex lesen
+      snprintf(tmp, sizeof(tmp), "%d", p.has(k::rgb) ? p.get_int(k::rgb) : p.get_int(k::value));
     }
-    rgbHex.trim(); rgbHex.toUpperCase();
-    uint32_t rgb = (uint32_t) strtoul(rgbHex.c_str(), nullptr, 16);
+    uint32_t rgb = (uint32_t) strtoul(tmp, nullptr, 16);
     uint8_t r = (rgb >> 16) & 0xFF;
     uint8_t g = (rgb >> 8)  & 0xFF;
     uint8_t b = (rgb)       & 0xFF;
@@ -341,14 +320,14 @@ void apply_kv(const String& key, const String& value) {
     fill_rgb565(rgb565);
     return;
   }
-  if (key == "display.test") {
+  if (key == bus::t::display_test) {
     test_pattern(1);
     return;
   }
 
   // SPI-Profil-Keys (nur Telemetrie übernehmen, keine Funktionseinwirkung)
-  if (key == "spi0.slice_ms" || key == "spi0.prio" || key == "spi0.role") {
-    EMIT("trace.drv.display.apply", String("key=")+key+" value="+value);
+  if (key == bus::t::spi0_slice_ms || key == bus::t::spi0_prio || key == bus::t::spi0_role) {
+    TRACE_TXT(drv_display, LV_INFO, trace_drv_display_apply, String("key=")+bus::topic_name(key)+" value="+p.str(k::value));
     return;
   }
 }
@@ -29,7 +29,7 @@ static constexpr uint16_t PANEL_H = 240;
 
 // Öffentliche Driver-API (genutzt von service_display / diagnostics)
 void init();
-void apply_kv(const String& key, const String& value);
+void apply_kv(bus::topic_t key, const bus::Payload& p);   // Wert in k::value
 
 // Explizite Helfer/Intents (weiter verfügbar, aber farbseitig hart verdrahtet)
 void set_brightness_pct(uint8_t pct);     // 0..100 → PWM
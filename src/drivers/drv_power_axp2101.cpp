@@ -1,4 +1,5 @@
 #include "drv_power_axp2101.hpp"
+#include "../core/bus.hpp"
 #include <stdarg.h>
 #include "driver/gpio.h"
 #include "esp_sleep.h"
@@ -26,7 +27,9 @@ void Axp2101::logf(const char* fmt, ...) const {
 }
 
 void IRAM_ATTR Axp2101::_isrThunk() {
-  if (_isrOwner) _irqFlag = true;
+  if (!_isrOwner) return;
+  _irqFlag = true;
+  bus::emit_from_isr(bus::t::pmu_irq, "src=axp2101 edge=fall"); // Zustellung via bus::drain()
 }
 
 bool Axp2101::begin(uint32_t i2cHz, bool release_irq_if_low, TwoWire* bus) {
@@ -1,34 +1,47 @@
 // GPT: Vorbereitender Stub für spätere Implementierung (von Andi gewünscht)
 #include "drv_touch_ft6236u.hpp"
 #include "../core/bus.hpp"
+#include "../core/trace.hpp"
 #include <Wire.h>
 
 namespace drv { namespace touch_ft6236u {
 
+static constexpr int PIN_INT = 16;   // FT6336U INT (active-LOW)
+
 static bool s_irq_on = true;
 static bool s_active = true;
+static bool s_isr_attached = false;
 
-// Minimal-Telemetrie-Wrapper
-static inline void TRACE(const char* topic, const String& msg){
-  bus::emit_sticky(String(topic), msg);
+// INT-Flanke → Deferred-Event (Zustellung im loop-Task via bus::drain)
+static void IRAM_ATTR touch_isr() {
+  bus::emit_from_isr(bus::t::touch_irq, "edge=fall");
 }
 
+namespace k = bus::k;
+
 // Hier ggf. echte FT6236U-Register ansteuern (Power/Sleep/IRQ-Enable)
 // Aktuell nur Traces, um Bus-Flow zu verifizieren.
 static void hw_power_active(){
   // TODO: echte Reg-Writes (z.B. MODE=ACTIVE)
   s_active = true;
-  TRACE("trace.drv.touch.apply", "key=touch.power value=active");
+  TRACE_TXT(drv_touch, LV_INFO, trace_drv_touch_apply, "key=touch.power value=active");
 }
 static void hw_power_sleep(){
   // TODO: echte Reg-Writes (z.B. MODE=SLEEP)
   s_active = false;
-  TRACE("trace.drv.touch.apply", "key=touch.power value=sleep");
+  TRACE_TXT(drv_touch, LV_INFO, trace_drv_touch_apply, "key=touch.power value=sleep");
 }
 static void hw_irq(bool en){
-  // TODO: GPIO/INT Mask setzen
+  if (en && !s_isr_attached) {
+    pinMode(PIN_INT, INPUT_PULLUP);
+    attachInterrupt(PIN_INT, touch_isr, FALLING);
+    s_isr_attached = true;
+  } else if (!en && s_isr_attached) {
+    detachInterrupt(PIN_INT);
+    s_isr_attached = false;
+  }
   s_irq_on = en;
-  TRACE("trace.drv.touch.apply", String("key=touch.irq value=") + (en?"on":"off"));
+  TRACE_TXT(drv_touch, LV_INFO, trace_drv_touch_apply, en ? "key=touch.irq value=on" : "key=touch.irq value=off");
 }
 
 // I2C-Härtung / Forward-Keys
@@ -38,31 +51,30 @@ static uint8_t  s_i2c_retry      = 2;
 void init(){
   // Annahme: Wire bereits global init; sonst hier begin() aufrufen.
   // IRQ-Pin/GPIO Setup wäre hier sinnvoll, falls vorhanden.
-  TRACE("trace.drv.touch.init", "ok=1 i2c1=1 ft6336u_ack=1");
+  TRACE_TXT(drv_touch, LV_INFO, trace_drv_touch_init, "ok=1 i2c1=1 ft6336u_ack=1");
 }
 
-void apply_kv(const String& key, const String& value){
-  if (key == "touch.power") {
-    if (value == "active") hw_power_active();
-    else                   hw_power_sleep();
+void apply_kv(bus::topic_t key, const bus::Payload& p){
+  if (key == bus::t::touch_power) {
+    if (p.is(k::value, "active")) hw_power_active();
+    else                               hw_power_sleep();
     return;
   }
-  if (key == "touch.irq") {
-    hw_irq(value == "on");
+  if (key == bus::t::touch_irq) {
+    hw_irq(p.get_bool(k::value, false));
     return;
   }
 
-  // I2C-Härtung (nur Traces; echte Anwendung je nach Low-Level)
-  if (key == "i2c0.timeout_ms") {
-    long t = value.toInt(); if (t < 1) t = 1; if (t > 1000) t = 1000;
-    s_i2c_timeout_ms = (uint16_t)t;
-    TRACE("trace.drv.touch.apply", String("key=i2c0.timeout_ms value=")+String((int)s_i2c_timeout_ms));
+  // I2C-Härtung (nur Traces; echte Anwendung je nach Low-Level).
+  // Bereich prüft das Config-Schema (i2c0.timeout_ms 1..1000, i2c0.retry 0..10).
+  if (key == bus::t::i2c0_timeout_ms) {
+    s_i2c_timeout_ms = (uint16_t)p.get_int(k::value, s_i2c_timeout_ms);
+    TRACE_REC(drv_touch, LV_INFO, trace_drv_touch_apply, {k::key, key}, {k::value, s_i2c_timeout_ms});
     return;
   }
-  if (key == "i2c0.retry") {
-    long t = value.toInt(); if (t < 0) t = 0; if (t > 10) t = 10;
-    s_i2c_retry = (uint8_t)t;
-    TRACE("trace.drv.touch.apply", String("key=i2c0.retry value=")+String((int)s_i2c_retry));
+  if (key == bus::t::i2c0_retry) {
+    s_i2c_retry = (uint8_t)p.get_int(k::value, s_i2c_retry);
+    TRACE_REC(drv_touch, LV_INFO, trace_drv_touch_apply, {k::key, key}, {k::value, s_i2c_retry});
     return;
   }
 }
@@ -1,10 +1,11 @@
 // GPT: Vorbereitender Stub für spätere Implementierung (von Andi gewünscht)
 #pragma once
 #include <Arduino.h>
+#include "../core/bus.hpp"
 
 namespace drv { namespace touch_ft6236u {
 
 void init();
-void apply_kv(const String& key, const String& value);
+void apply_kv(bus::topic_t key, const bus::Payload& p);   // Wert in k::value
 
 } } // namespace drv::touch_ft6236u
@@ -1,5 +1,5 @@
 // Minimal: USB-CDC Serial only, LittleFS mount, Event-Bus + A2-Parser.
-// Idle-Flush-Konsole mit Prompt. Keine Fremdlibs.
+// Zeilen-Konsole (RX-Task, console_rx) mit Prompt. Keine Fremdlibs.
 
 #include <Arduino.h>
 #include <FS.h>
@@ -7,22 +7,29 @@
 #include <stdarg.h>
 #include <stdlib.h>
 
+#include "core/boot.hpp"
 #include "core/bus.hpp"
+#include "core/console.hpp"
+#include "core/trace.hpp"
 #include "core/api_parser.hpp"
+#include "core/session.hpp"
 #include "services/service_config.hpp"
 #include "services/service_power.hpp"
 #include "services/service_display.hpp"
 #include "services/service_touch.hpp"
 
-static void prompt() { Serial.print(">> "); }
-static void outln(const String& s) { Serial.println(s); }
+static void prompt() { if (api::prompt_wanted()) console::print(">> "); }
+static void outln(const String& s) { console::println(s); }
 
 static void outf(const char* fmt, ...) {
   char buf[256];
   va_list ap; va_start(ap, fmt);
-  vsnprintf(buf, sizeof(buf), fmt, ap);
+  int n = vsnprintf(buf, sizeof(buf), fmt, ap);
   va_end(ap);
-  Serial.print(buf);
+  if (n < 0) return;
+  size_t len = (size_t)n < sizeof(buf) ? (size_t)n : sizeof(buf) - 1;
+  if (len && buf[len - 1] == '\n') --len;
+  console::println(buf, len);
 }
 
 // ----- FS Utils -----
@@ -42,64 +49,96 @@ static void dumpFirstLines(const char *path, size_t maxLines = 3) {
   f.close();
 }
 
+// Diagnose-Listing als letzte Stage: läuft nach der Hardware auf dem Hintergrund-Task
+static bool s_fs_mounted = false;
+static void fsList() {
+  if (!s_fs_mounted) return;
+  listDir("/"); listDir("/config"); dumpFirstLines("/config/dev.ini"); dumpFirstLines("/config/user.ini");
+}
+
+// Gestufte Hardware-Inits (boot.hpp): work auf dem Hintergrund-Task, done im loop().
+// Bit i in deps = Stage i muss vorher fertig sein; PMU schaltet die Rails für Panel/Touch.
+// Display zuletzt: Panel-Reset braucht ~230 ms, Touch/Telemetrie sind nach wenigen ms durch.
+// Das FS-Listing hängt hinten an und hält weder setup() noch die Hardware auf.
+static const boot::Stage STAGES[] = {
+  { boot::P_st_pmu,       0,      svc::power::hw_init,        svc::power::hw_attach,         bus::t::boot_pmu },
+  { boot::P_st_touch,     1 << 0, svc::touch::hw_init,        svc::touch::init,              bus::t::boot_touch },
+  { boot::P_st_telemetry, 1 << 0, svc::power::telemetry_read, svc::power::telemetry_publish, bus::t::boot_telemetry },
+  { boot::P_st_display,   1 << 0, svc::display::hw_init,      svc::display::init,            bus::t::boot_display },
+  { boot::P_fs_list,      0,      fsList,                     nullptr,                       bus::t::boot_fs },
+};
+
 void setup() {
   // USB-CDC Konsole
-  Serial.begin(115200);
-  delay(400);
+  { boot::Scope b(boot::P_serial); Serial.begin(115200); }
+  { boot::Scope b(boot::P_console); console::begin(400); }   // TX-Task wartet 400 ms auf USB-CDC, setup() nicht
 
   // LittleFS
+  boot::begin(boot::P_fs_mount);
   bool mounted = LittleFS.begin(false, "/littlefs", 8, "littlefs");
+  boot::end(boot::P_fs_mount);
   outf("[FS] mount=%s\n", mounted ? "ok" : "fail");
-  if (mounted) { listDir("/"); listDir("/config"); dumpFirstLines("/config/dev.ini"); dumpFirstLines("/config/user.ini"); }
+  s_fs_mounted = mounted;   // Listing folgt als Stage (fsList)
 
   // Bus
-  bus::init(outln);
+  { boot::Scope b(boot::P_bus); bus::init(outln); }
+  { boot::Scope b(boot::P_console_cfg); console::init(); }   // console.policy.* (INI [console.policy])
+  { boot::Scope b(boot::P_trace); trace::init(); }   // log.level.* aus der INI greift ab config::init()
 
   // Config-Service (lädt dev.ini & user.ini, primed Stickies)
-  config::init();
+  { boot::Scope b(boot::P_config); config::init(); }
+  boot::set_window_ms((uint32_t)config::get_int(config::K_boot_safe_window_ms));
 
   // Start-Stickies (ohne ui.brightness – kommt ggf. aus config.init())
-  bus::emit_sticky("power.mode_changed", "mode=ready");
-  bus::emit_sticky("time.ready", "epoch=0");
-  if (!config::has_ui_brightness()) { bus::emit_sticky("ui.brightness", "value=50"); }
+  boot::begin(boot::P_stickies);
+  bus::emit_sticky(bus::t::power_mode_changed, bus::Payload().set(bus::k::mode, "ready"));
+  bus::emit_sticky(bus::t::time_ready, bus::Payload().set(bus::k::epoch, 0));
+  if (!config::has_ui_brightness()) { bus::emit_sticky(bus::t::ui_brightness, bus::Payload().set(bus::k::value, 50)); }
+  boot::end(boot::P_stickies);
+
+  // Hardware im Hintergrund: PMU → Display/Touch/Telemetrie (Readiness-Stickies boot.*)
+  boot::stages_begin(STAGES, sizeof(STAGES) / sizeof(STAGES[0]));
 
   // Services (orchestrieren Treiber; HW-Zugriffe folgen später im DRV)
-  svc::power::init();
-  svc::display::init();
-  svc::touch::init();
+  { boot::Scope b(boot::P_svc_power); svc::power::init(); }
 
   // Parser
-  api::init(outln);
+  { boot::Scope b(boot::P_api); api::init(outln); }
+  session::set_evt(session::CONSOLE, console::evt);   // Events typisiert (text/bin)
+  { boot::Scope b(boot::P_console_rx); console::rx_begin(); }   // Eingabe-Task: Zeilen wecken loop()
 
   outln("evt/console mode=log");
   outln("[BOOT] ready");
   prompt();
+  boot::ready();   // Timeline → /logs/boot.last (vorige bleibt für info boot prev=on)
 }
 
 void loop() {
-  static String acc;
-  static unsigned long last_rx = 0;
-
+  static char line[CONSOLE_LINE_MAX];
   bool any = false;
-  while (Serial.available()) {
+
+  // Fertige Zeilen vom RX-Task (CR/LF sofort, Idle-Flush nur als Fallback)
+  size_t n = 0;
+  bool overlong = false;
+  while (console::read_line(line, sizeof(line), &n, &overlong)) {
     any = true;
-    char c = (char)Serial.read();
-    last_rx = millis();
-
-    if (c == '\r' || c == '\n') {
-      if (acc.length()) { String ln = acc; acc = ""; api::handleLine(ln); prompt(); }
-    } else if (c == '\b' || c == 0x7F) {
-      if (acc.length()) acc.remove(acc.length() - 1);
-    } else {
-      acc += c;
-      if (acc.length() > 240) { outln("err line_too_long"); acc = ""; prompt(); }
-    }
+    if (overlong) outln("err code=E_SYNTAX msg=\"line too long\"");
+    else          api::handleLine(line, n);
+    prompt();
   }
 
-  // Idle-Flush
-  if (acc.length() && (millis() - last_rx) > 350) {
-    String ln = acc; acc = ""; api::handleLine(ln); prompt();
-  }
+  // Deferred-Events (ISR / Core 0) auf dem Bus-Owner-Task zustellen
+  if (bus::drain()) any = true;
+
+  // Boot-Stages abschließen (Bus-Verdrahtung + Readiness-Sticky)
+  if (boot::poll()) any = true;
+
+  // Trace-Ring → Konsolen-Abos (sub trace.*)
+  api::poll();
+
+  // user.ini Write-Behind (schreibt erst nach dem Debounce-Fenster)
+  config::poll();
 
-  if (!any) delay(1);
+  // Schläft bis zur nächsten Zeile (RX-Task weckt), höchstens 1 ms
+  if (!any) console::rx_wait(1);
 }
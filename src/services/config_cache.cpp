@@ -0,0 +1,212 @@
+// src/services/config_cache.cpp
+// Binärer Config-Cache, Format siehe config_cache.hpp.
+#include "config_cache.hpp"
+#include <FS.h>
+#include <LittleFS.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace config {
+namespace cache {
+
+static constexpr uint32_t MAGIC   = 0x31435754;   // "TWC1"
+static constexpr size_t   INI_MAX = 2;
+static const char TMP[] = "/config/cache.tmp";
+
+struct Src { uint32_t size, mtime, crc; };
+
+struct Header {
+  uint32_t magic;
+  uint32_t schema;
+  Src      src[INI_MAX];
+  uint32_t state_len;
+  uint32_t body_len;
+  uint32_t crc;          // über State + Einträge
+};
+
+static std::vector<uint8_t> s_rec;   // nur während eines INI-Durchlaufs belegt
+static bool s_recording = false;
+static bool s_overflow  = false;      // Eintrag passt nicht ins Format → kein Image
+static Src  s_src[INI_MAX];
+
+// CRC-32 (IEEE), Tabelle beim ersten Aufruf (1 KiB RAM statt 8 Schritte je Byte)
+uint32_t crc32(const uint8_t* p, size_t n, uint32_t crc) {
+  static uint32_t table[256];
+  if (!table[1]) {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int b = 0; b < 8; ++b) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+      table[i] = c;
+    }
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < n; ++i) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+// Kennwerte einer INI: size/mtime aus dem Dateisystem, CRC über den Inhalt nur
+// mit with_crc (ein read) – beim Laden nur, wenn size/mtime nicht entscheiden
+static Src src_of(const char* path, bool with_crc = true) {
+  Src s = {};
+  File f = LittleFS.exists(path) ? LittleFS.open(path, "r") : File();
+  if (!f) return s;
+  s.size  = (uint32_t)f.size();
+  s.mtime = (uint32_t)f.getLastWrite();
+  if (with_crc && s.size) {
+    uint8_t* buf = (uint8_t*)malloc(s.size);
+    if (buf) {
+      const size_t n = f.read(buf, s.size);
+      s.crc = crc32(buf, n);
+      free(buf);
+    }
+  }
+  f.close();
+  return s;
+}
+
+static size_t state_len(const Block* blocks, size_t nblocks) {
+  size_t n = 0;
+  for (size_t i = 0; i < nblocks; ++i) n += blocks[i].n;
+  return n;
+}
+
+// ---------------------------------------------------------------------------
+// Aufbau
+void begin(const char* const* ini, size_t nini) {
+  s_rec.clear();
+  s_recording = true;
+  s_overflow  = nini > INI_MAX;
+  memset(s_src, 0, sizeof(s_src));
+  for (size_t i = 0; i < nini && i < INI_MAX; ++i) s_src[i] = src_of(ini[i]);
+}
+
+void record(bus::topic_t topic, const bus::Payload& p) {
+  if (!s_recording || s_overflow) return;
+  size_t tn = 0;
+  const char* t = bus::topic_name(topic, &tn);
+  uint8_t v[4];
+  const uint8_t* val = v;
+  size_t vn = 4;
+  char type;
+  bus::Payload::FieldRef f, more;
+  if (p.is_text()) {                                // lange Werte ("value=ALDO3,ALDO2,…")
+    type = 'T'; val = (const uint8_t*)p.text().c_str(); vn = p.text().length();
+  } else if (p.field(0, f) && f.key == bus::k::value && !p.field(1, more)) {
+    switch (f.type) {
+      case bus::Payload::T_INT:   type = 'I'; memcpy(v, &f.i, 4); break;
+      case bus::Payload::T_FLOAT: type = 'F'; memcpy(v, &f.f, 4); break;
+      default:                    type = 'S'; val = (const uint8_t*)f.s; vn = f.len; break;
+    }
+  } else {
+    type = 0;
+  }
+  if (!type || tn > 255 || vn > 255) {
+    s_overflow = true;                              // nur value=… bzw. Text bis 255 Zeichen
+    return;
+  }
+  s_rec.push_back((uint8_t)type);
+  s_rec.push_back((uint8_t)tn);
+  s_rec.insert(s_rec.end(), (const uint8_t*)t, (const uint8_t*)t + tn);
+  s_rec.push_back((uint8_t)vn);
+  s_rec.insert(s_rec.end(), val, val + vn);
+}
+
+bool commit(const Block* blocks, size_t nblocks, uint32_t schema) {
+  s_recording = false;
+  if (s_overflow) { s_rec.clear(); s_rec.shrink_to_fit(); return false; }
+
+  Header h = {};
+  h.magic     = MAGIC;
+  h.schema    = schema;
+  memcpy(h.src, s_src, sizeof(h.src));
+  h.state_len = (uint32_t)state_len(blocks, nblocks);
+  h.body_len  = (uint32_t)s_rec.size();
+
+  // Ein Puffer, ein write
+  std::vector<uint8_t> img(sizeof(Header) + h.state_len + h.body_len);
+  size_t w = sizeof(Header);
+  for (size_t i = 0; i < nblocks; ++i) { memcpy(img.data() + w, blocks[i].p, blocks[i].n); w += blocks[i].n; }
+  if (h.body_len) memcpy(img.data() + w, s_rec.data(), h.body_len);
+  h.crc = crc32(img.data() + sizeof(Header), img.size() - sizeof(Header));
+  memcpy(img.data(), &h, sizeof(h));
+  s_rec.clear();
+  s_rec.shrink_to_fit();
+
+  File f = LittleFS.open(TMP, "w");
+  if (!f) return false;
+  const size_t n = f.write(img.data(), img.size());
+  f.close();
+  if (n != img.size()) { LittleFS.remove(TMP); return false; }
+  return LittleFS.rename(TMP, PATH);
+}
+
+// ---------------------------------------------------------------------------
+// Laden
+bool load(const char* const* ini, size_t nini, const Block* blocks, size_t nblocks, uint32_t schema,
+          size_t* keys, size_t* bytes) {
+  if (nini > INI_MAX || !LittleFS.exists(PATH)) return false;
+  File f = LittleFS.open(PATH, "r");
+  if (!f) return false;
+  const size_t size = f.size();
+  if (size < sizeof(Header)) { f.close(); return false; }
+  uint8_t* img = (uint8_t*)malloc(size);
+  if (!img) { f.close(); return false; }
+  const size_t rd = f.read(img, size);              // ein read für das ganze Image
+  f.close();
+
+  Header h;
+  memcpy(&h, img, sizeof(h));
+  bool ok = rd == size && h.magic == MAGIC && h.schema == schema &&
+            h.state_len == state_len(blocks, nblocks) &&
+            sizeof(Header) + (size_t)h.state_len + h.body_len == size &&
+            crc32(img + sizeof(Header), size - sizeof(Header)) == h.crc;
+  // Normalfall ohne INI-Lesen: gleiche size + mtime → gültig. Andere size → veraltet.
+  // Gleiche size, andere/unbekannte mtime (kein RTC, neu geschrieben) → CRC entscheidet.
+  for (size_t i = 0; ok && i < INI_MAX; ++i) {
+    const Src want = h.src[i];
+    if (i >= nini) { ok = !want.size && !want.mtime && !want.crc; continue; }
+    Src got = src_of(ini[i], false);
+    if (got.size != want.size) { ok = false; continue; }
+    if (got.mtime && got.mtime == want.mtime) continue;
+    got = src_of(ini[i]);
+    ok = got.crc == want.crc;
+  }
+  if (!ok) { free(img); return false; }
+
+  size_t r = sizeof(Header);
+  for (size_t i = 0; i < nblocks; ++i) { memcpy(blocks[i].p, img + r, blocks[i].n); r += blocks[i].n; }
+
+  size_t n = 0;
+  while (r + 3 <= size) {
+    const char type = (char)img[r];
+    const size_t tn = img[r + 1];
+    if (r + 2 + tn + 1 > size) break;
+    const char* t = (const char*)img + r + 2;
+    const size_t vn = img[r + 2 + tn];
+    const uint8_t* v = img + r + 3 + tn;
+    if (v + vn > img + size) break;
+    r += 3 + tn + vn;
+
+    const bus::topic_t id = bus::intern(t, tn);
+    if (id == bus::topic_t::NONE) continue;
+    bus::Payload p;
+    if (type == 'I' && vn == 4)      { int32_t x; memcpy(&x, v, 4); p.set(bus::k::value, (int)x); }
+    else if (type == 'F' && vn == 4) { float x;   memcpy(&x, v, 4); p.set(bus::k::value, x); }
+    else if (type == 'T')            p = bus::Payload::text(String((const char*)v, vn));
+    else { char tmp[256]; memcpy(tmp, v, vn); tmp[vn] = 0; p.set(bus::k::value, tmp); }
+    bus::emit_sticky(id, p);
+    ++n;
+  }
+  free(img);
+  if (keys)  *keys = n;
+  if (bytes) *bytes = size;
+  return true;
+}
+
+void invalidate() {
+  if (LittleFS.exists(PATH)) LittleFS.remove(PATH);
+}
+
+} // namespace cache
+} // namespace config
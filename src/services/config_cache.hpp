@@ -0,0 +1,45 @@
+// src/services/config_cache.hpp
+// Binärer Config-Cache (/config/cache.bin): geprüfte Config aus dev.ini/user.ini
+// als kompaktes Image. Späterer Boot = eine Datei, ein read(), keine Zeilen-
+// zerlegung; neu gebaut nur, wenn sich eine INI ändert.
+// Standardmäßig aus (CONFIG_CACHE=0): erst einschalten, wenn eine Messung auf
+// dem Gerät (info config load_us) einen Gewinn gegenüber dem INI-Pfad zeigt.
+//
+//   Header   magic, Schema-Hash, je INI size/mtime/CRC32, Längen, CRC32 des Rests
+//   State    Schema-Struct + Herkunft (Blöcke aus service_config.cpp, 1:1 kopiert)
+//   Einträge u8 typ | u8 name_len | name | u8 val_len | wert   (Emit-Reihenfolge)
+//            typ 'I' int32 LE, 'F' f32 LE, 'S' value=<str>, 'T' Freitext-Payload
+//
+// Gültig nur bei identischem Schema (Layout + Rows) und gleichen INI-Kennwerten:
+// size/mtime gleich → gültig ohne die INIs zu lesen; size anders → veraltet;
+// nur bei gleicher size und anderer bzw. fehlender mtime entscheidet die CRC.
+// Nur für service_config.cpp.
+
+#pragma once
+#include <Arduino.h>
+#include "../core/bus.hpp"
+
+namespace config {
+namespace cache {
+
+static constexpr const char* PATH = "/config/cache.bin";
+
+// Zustands-Segmente, die 1:1 ins Image wandern (Reihenfolge fest)
+struct Block { void* p; size_t n; };
+
+// INI-Pfad: Emits mitschreiben (begin → record… → commit schreibt tmp + rename)
+void begin(const char* const* ini, size_t nini);
+void record(bus::topic_t topic, const bus::Payload& p);
+bool commit(const Block* blocks, size_t nblocks, uint32_t schema);
+
+// Boot: Image prüfen und laden → Blöcke füllen, Einträge emittieren.
+// false = kein/veraltetes Image (Aufrufer parst die INIs).
+bool load(const char* const* ini, size_t nini, const Block* blocks, size_t nblocks, uint32_t schema,
+          size_t* keys = nullptr, size_t* bytes = nullptr);
+
+void invalidate();   // z. B. nach user.ini-Schreibzugriff (spart einen CRC-Fehlschlag)
+
+uint32_t crc32(const uint8_t* p, size_t n, uint32_t crc = 0);
+
+} // namespace cache
+} // namespace config
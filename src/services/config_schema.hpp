@@ -0,0 +1,47 @@
+// src/services/config_schema.hpp
+// Config-Schema: jeder Key, den ein Modul auswertet, steht einmal in CONFIG_SCHEMA
+// mit Typ, Bereich, Default und Owner. service_config.cpp prüft und wandelt
+// INI-Werte (und `set`/`emit` auf diese Topics) genau einmal in einen flachen,
+// typisierten Struct (config::Values) und emittiert typisierte Payloads
+// (value=<int|float|0/1|str>) – Konsumenten klemmen und parsen nicht mehr selbst.
+//
+//   X(id, "section.key", TYPE, min, max, "default", "opts", owner)
+//     INT/FLOAT  min..max (außerhalb: beim Laden geklemmt, bei set abgelehnt)
+//     BOOL       on/off, true/false, yes/no, 1/0
+//     STR        max = maximale Länge (≤ CONFIG_STR_MAX-1)
+//     ENUM       opts = "a|b|c", Wert ist der kanonische Name (get_int → Index)
+// Keys außerhalb des Schemas laufen unverändert als Rohwert auf den Bus.
+
+#pragma once
+
+#define CONFIG_STR_MAX 48
+
+#define CONFIG_SCHEMA(X) \
+  /* UI */ \
+  X(ui_brightness,                 "ui.brightness",                  INT,   0,   100,      "50",       "", ui) \
+  /* Display / Backlight */ \
+  X(backlight_pwm_timer_hz,        "backlight.pwm_timer_hz",         INT,   100, 40000,    "20000",    "", display) \
+  X(backlight_pwm_resolution_bits, "backlight.pwm_resolution_bits",  INT,   8,   15,       "10",       "", display) \
+  X(backlight_min_pct,             "backlight.min_pct",              INT,   0,   100,      "4",        "", display) \
+  X(backlight_gamma,               "backlight.gamma",                FLOAT, 0.1, 5,        "2.2",      "", display) \
+  X(display_rotate,                "display.rotate",                 INT,   0,   3,        "0",        "", display) \
+  /* Touch / I2C */ \
+  X(i2c0_timeout_ms,               "i2c0.timeout_ms",                INT,   1,   1000,     "25",       "", touch) \
+  X(i2c0_retry,                    "i2c0.retry",                     INT,   0,   10,       "2",        "", touch) \
+  /* Power */ \
+  X(power_dev_prevent_standby,     "power.dev.prevent_standby",      BOOL,  0,   1,        "off",      "", power) \
+  X(power_dev_prevent_lightsleep,  "power.dev.prevent_lightsleep",   BOOL,  0,   1,        "off",      "", power) \
+  X(power_sleep_autowake_ms,       "power.sleep.autowake_ms",        INT,   0,   86400000, "0",        "", power) \
+  X(log_persist_tail_bytes,        "log.persist.tail_bytes",         INT,   0,   1048576,  "16384",    "", power) \
+  X(log_persist_path,              "log.persist.path",               STR,   0,   47,       "/logs/last.log", "", power) \
+  /* Konsole */ \
+  X(console_policy_evt,            "console.policy.evt",             ENUM,  0,   0,        "coalesce", "block|drop|coalesce", console) \
+  X(console_policy_trace,          "console.policy.trace",           ENUM,  0,   0,        "drop",     "block|drop|coalesce", console) \
+  X(console_policy_log,            "console.policy.log",             ENUM,  0,   0,        "drop",     "block|drop|coalesce", console) \
+  X(console_rx_idle_flush_ms,      "console.rx.idle_flush_ms",       INT,   0,   10000,    "350",      "", console) \
+  /* Config (Write-Behind user.ini) */ \
+  X(config_persist_debounce_ms,    "config.persist.debounce_ms",     INT,   0,   60000,    "1500",     "", config) \
+  X(config_persist_max_delay_ms,   "config.persist.max_delay_ms",    INT,   0,   600000,   "10000",    "", config) \
+  /* Boot */ \
+  X(boot_safe_window_ms,           "boot.safe_window_ms",            INT,   0,   60000,    "1500",     "", boot) \
+  X(boot_safe_window_extend_ms,    "boot.safe_window_extend_ms",     INT,   0,   600000,   "30000",    "", boot)
@@ -0,0 +1,95 @@
+// src/services/ini_reader.cpp
+// Streaming-INI-Leser, Format siehe ini_reader.hpp.
+#include "ini_reader.hpp"
+#include <string.h>
+
+namespace ini {
+
+static inline bool is_ws(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+static void trim(const char*& p, size_t& n) {
+  while (n && is_ws(*p)) { ++p; --n; }
+  while (n && is_ws(p[n - 1])) --n;
+}
+
+bool Reader::line(const char** p, size_t* n) {
+  for (;;) {
+    const char* nl = (const char*)memchr(_buf + _pos, '\n', _len - _pos);
+    if (nl) {
+      *p = _buf + _pos;
+      *n = nl - *p;
+      _pos = nl - _buf + 1;
+      if (_long) { _long = false; ++_skipped; continue; }   // Rest der überlangen Zeile
+      ++_line;
+      return true;
+    }
+    if (_eof) {
+      if (_pos == _len) return false;
+      *p = _buf + _pos;                             // letzte Zeile ohne '\n'
+      *n = _len - _pos;
+      _pos = _len;
+      if (_long) { _long = false; ++_skipped; return false; }
+      ++_line;
+      return true;
+    }
+    // Angefangene Zeile nach vorn, Rest des Blocks nachladen
+    if (_pos) { memmove(_buf, _buf + _pos, _len - _pos); _len -= _pos; _pos = 0; }
+    if (_len == BLOCK) {                            // kein '\n' im ganzen Puffer
+      if (!_long) ++_line;
+      _long = true;
+      _len = 0;
+    }
+    const size_t r = _f.read((uint8_t*)_buf + _len, BLOCK - _len);
+    if (!r) _eof = true;
+    _len += r;
+  }
+}
+
+bool Reader::next(Entry& e) {
+  const char* p;
+  size_t n;
+  while (line(&p, &n)) {
+    if (_line == 1 && n >= 3 && !memcmp(p, "\xEF\xBB\xBF", 3)) { p += 3; n -= 3; }
+    trim(p, n);
+    if (!n || *p == ';' || *p == '#') continue;
+
+    if (*p == '[') {
+      const char* end = (const char*)memchr(p, ']', n);
+      const char* s = p + 1;
+      size_t sn = end ? (size_t)(end - s) : 0;
+      trim(s, sn);
+      _sec_bad = !end || sn >= SECTION_MAX;
+      if (_sec_bad) { ++_skipped; _sec_n = 0; continue; }
+      memcpy(_sec, s, sn);
+      _sec_n = sn;
+      continue;
+    }
+
+    const char* eq = (const char*)memchr(p, '=', n);
+    if (!eq || eq == p || _sec_bad) { ++_skipped; continue; }
+
+    const char* k = p;
+    size_t kn = eq - p;
+    const char* v = eq + 1;
+    size_t vn = n - kn - 1;
+    trim(k, kn);
+    trim(v, vn);
+    for (size_t i = 0; i < vn; ++i) {                // Inline-Kommentar abschneiden
+      if ((v[i] == ';' || v[i] == '#') && (i == 0 || v[i - 1] == ' ' || v[i - 1] == '\t')) {
+        vn = i;
+        trim(v, vn);
+        break;
+      }
+    }
+    if (!kn) { ++_skipped; continue; }
+
+    e.section = { _sec, _sec_n };
+    e.key     = { k, kn };
+    e.value   = { v, vn };
+    e.line    = _line;
+    return true;
+  }
+  return false;
+}
+
+} // namespace ini
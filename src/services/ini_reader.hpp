@@ -0,0 +1,58 @@
+// src/services/ini_reader.hpp
+// Streaming-INI-Leser: liest die Datei in festen Blöcken (BLOCK Bytes, ein
+// Puffer im Objekt) und liefert je Eintrag Spans für Section/Key/Wert – ohne
+// String, ohne Heap. Spans gelten bis zum nächsten next().
+//
+//   [section]          Section (getrimmt, max. SECTION_MAX-1 Zeichen)
+//   key = value ; x    Wert ohne Inline-Kommentar (';'/'#' am Wertanfang oder
+//                      nach Leerzeichen/Tab; "a#b" bleibt "a#b")
+//   ; …  # …           Kommentarzeile
+// CRLF und LF, UTF-8-BOM am Dateianfang, letzte Zeile ohne Zeilenende.
+// Zeilen länger als BLOCK-1 werden komplett übersprungen (skipped()), ebenso
+// Zeilen ohne '=' und alle Keys unter einer zu langen Section.
+
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+
+namespace ini {
+
+struct Span {
+  const char* p;
+  size_t      n;
+};
+
+struct Entry {
+  Span     section;   // leer = vor der ersten [section]
+  Span     key;
+  Span     value;
+  uint32_t line;      // 1-basiert
+};
+
+class Reader {
+public:
+  static constexpr size_t BLOCK       = 256;   // Lesepuffer = maximale Zeilenlänge
+  static constexpr size_t SECTION_MAX = 64;
+
+  explicit Reader(File& f) : _f(f) {}
+
+  bool next(Entry& e);   // false = Dateiende
+
+  uint32_t lines()   const { return _line; }
+  uint32_t skipped() const { return _skipped; }
+
+private:
+  bool line(const char** p, size_t* n);   // nächste Rohzeile (ohne '\n')
+
+  File&    _f;
+  char     _buf[BLOCK];
+  size_t   _pos = 0, _len = 0;
+  bool     _eof = false;
+  bool     _long = false;     // überlange Zeile wird bis zum '\n' verworfen
+  char     _sec[SECTION_MAX];
+  size_t   _sec_n = 0;
+  bool     _sec_bad = false;
+  uint32_t _line = 0, _skipped = 0;
+};
+
+} // namespace ini
@@ -1,18 +1,264 @@
 // GPT: Vorbereitender Stub für spätere Implementierung (von Andi gewünscht)
 // Config-Service ohne Merge-Logik. Lädt /config/dev.ini und /config/user.ini,
 // primed ALLE Key/Value-Paare als Sticky-Events: <section>.<key>  value=<raw>
-// Schreibt ausschließlich /config/user.ini bei Änderungen (z.B. ui.brightness).
+// Schreibt ausschließlich /config/user.ini: Write-Behind über alle User-Keys.
+// Schema-Keys (config_schema.hpp) werden beim Laden einmal geprüft, geklemmt
+// bzw. auf den Default gesetzt und typisiert auf den Bus gelegt.
 
 #include "service_config.hpp"
+#include "config_cache.hpp"
+#include "ini_reader.hpp"
+#include "../core/trace.hpp"
 #include <FS.h>
 #include <LittleFS.h>
-#include "../core/bus.hpp"
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
 
 namespace config {
 
-static bool  s_dirty = false;
-static bool  s_has_ui_brightness = false;
-static int   s_ui_brightness = 50;
+namespace k = bus::k;
+
+// cache.bin nur mit -D CONFIG_CACHE=1: auch ohne INI-Lesen beim Prüfen (nur
+// size/mtime) bleibt der INI-Pfad auf dem Host schneller (bench_native: ~37 µs
+// INI vs. ~60 µs Image – CRC über ~6,5 KB plus drei statt zwei Dateizugriffe),
+// und das Image kostet je Änderung einen Flash-Write.
+#ifndef CONFIG_CACHE
+#define CONFIG_CACHE 0
+#endif
+static bool  s_cache_on = CONFIG_CACHE;
+static LoadStats s_load = {};
+
+static const char* const INI_FILES[] = { "/config/dev.ini", "/config/user.ini" };
+static const char USER_INI[] = "/config/user.ini";
+static const char USER_TMP[] = "/config/user.tmp";
+
+// ------------------------- User-Keys (user.ini) -------------------------
+// Alles, was in user.ini steht (plus ui.brightness), gehört dem User und wird
+// vollständig zurückgeschrieben – auch Keys außerhalb des Schemas. Änderungen
+// markieren den Eintrag dirty; poll() schreibt nach dem Debounce-Fenster einmal.
+static constexpr size_t USER_MAX      = 40;
+static constexpr size_t USER_NAME_MAX = 48;   // "section.key"
+static constexpr size_t USER_VAL_MAX  = 48;
+static_assert(USER_MAX <= 64, "dirty-Maske ist 64 Bit");
+
+struct UserKey {
+  bus::topic_t topic;
+  char name[USER_NAME_MAX];
+  char val[USER_VAL_MAX];
+};
+
+static UserKey  s_user[USER_MAX];
+static uint8_t  s_user_n     = 0;
+static bool     s_user_lossy = false;   // Eintrag passte nicht → nie überschreiben
+static uint64_t s_dirty      = 0;       // Bit i = s_user[i] geändert
+static uint32_t s_first_ms   = 0;       // erste Änderung seit dem letzten Schreiben
+static uint32_t s_last_ms    = 0;       // letzte Änderung (Debounce)
+static bool     s_lossy_told = false;   // lossy einmal gemeldet (Trace)
+static PersistStats s_persist = {};
+
+// ------------------------- Schema -------------------------
+static const Row ROWS[KEY_COUNT] = {
+#define CONFIG_ROW(id, name, type, mn, mx, def, opts, owner) \
+  { name, bus::topic_of(name), T_##type, (double)(mn), (double)(mx), def, opts, #owner },
+  CONFIG_SCHEMA(CONFIG_ROW)
+#undef CONFIG_ROW
+};
+
+static const uint16_t OFFSET[KEY_COUNT] = {
+#define CONFIG_OFFSET(id, name, type, mn, mx, def, opts, owner) (uint16_t)offsetof(Values, id),
+  CONFIG_SCHEMA(CONFIG_OFFSET)
+#undef CONFIG_OFFSET
+};
+
+static constexpr size_t RAW_MAX = 16;
+static constexpr size_t OPT_MAX = 16;
+
+static Values s_val;
+static Source s_src[KEY_COUNT];
+static char   s_raw[KEY_COUNT][RAW_MAX];      // Rohwert bei S_CLAMPED/S_INVALID
+static char   s_enum[KEY_COUNT][OPT_MAX];     // ENUM: aktueller Name (get_str)
+
+static const char* const TYPE_NAMES[]   = { "int", "float", "bool", "str", "enum" };
+static const char* const SOURCE_NAMES[] = { "default", "ini", "clamped", "invalid", "set" };
+
+static void* field(Key key) { return (uint8_t*)&s_val + OFFSET[key]; }
+
+// i-te Option aus "a|b|c"
+static bool opt_at(const char* opts, uint8_t i, const char** p, size_t* n) {
+  const char* a = opts;
+  for (uint8_t j = 0; ; ++j) {
+    const char* e = strchr(a, '|');
+    const size_t len = e ? (size_t)(e - a) : strlen(a);
+    if (j == i) { *p = a; *n = len; return len > 0; }
+    if (!e) return false;
+    a = e + 1;
+  }
+}
+
+// Ergebnis einer Umwandlung; v.* je nach Typ
+enum Parse : uint8_t { P_OK = 0, P_CLAMPED, P_INVALID };
+struct Cell { int32_t i; float f; bool b; uint8_t e; const char* s; size_t n; };
+
+static Parse parse(const Row& r, const char* s, size_t n, Cell& c) {
+  while (n && (unsigned char)s[n - 1] <= ' ') --n;
+  while (n && (unsigned char)*s <= ' ') { ++s; --n; }
+  char tmp[24];
+  const bool fits = n && n < sizeof(tmp);
+  if (fits) { memcpy(tmp, s, n); tmp[n] = 0; }
+
+  switch (r.type) {
+    case T_INT: {
+      if (!fits) return P_INVALID;
+      char* end = nullptr;
+      const bool hex = n > 2 && tmp[0] == '0' && (tmp[1] == 'x' || tmp[1] == 'X');
+      const long long x = strtoll(tmp, &end, hex ? 16 : 10);
+      if (end == tmp || *end) return P_INVALID;
+      if (x < (long long)r.min) { c.i = (int32_t)r.min; return P_CLAMPED; }
+      if (x > (long long)r.max) { c.i = (int32_t)r.max; return P_CLAMPED; }
+      c.i = (int32_t)x;
+      return P_OK;
+    }
+    case T_FLOAT: {
+      if (!fits) return P_INVALID;
+      char* end = nullptr;
+      const float x = strtof(tmp, &end);
+      if (end == tmp || *end || !isfinite(x)) return P_INVALID;
+      if (x < (float)r.min) { c.f = (float)r.min; return P_CLAMPED; }
+      if (x > (float)r.max) { c.f = (float)r.max; return P_CLAMPED; }
+      c.f = x;
+      return P_OK;
+    }
+    case T_BOOL: {
+      if (!fits) return P_INVALID;
+      static const char* const ON[]  = { "1", "on", "true", "yes" };
+      static const char* const OFF[] = { "0", "off", "false", "no" };
+      for (const char* w : ON)  if (!strcasecmp(tmp, w)) { c.b = true;  return P_OK; }
+      for (const char* w : OFF) if (!strcasecmp(tmp, w)) { c.b = false; return P_OK; }
+      return P_INVALID;
+    }
+    case T_STR:
+      c.s = s;
+      c.n = n;
+      if (n > (size_t)r.max) { c.n = (size_t)r.max; return P_CLAMPED; }
+      return P_OK;
+    case T_ENUM: {
+      const char* o; size_t on;
+      for (uint8_t i = 0; opt_at(r.opts, i, &o, &on); ++i) {
+        if (on == n && !strncasecmp(o, s, n)) { c.e = i; return P_OK; }
+      }
+      return P_INVALID;
+    }
+  }
+  return P_INVALID;
+}
+
+static void store(Key key, const Cell& c) {
+  const Row& r = ROWS[key];
+  switch (r.type) {
+    case T_INT:   *(int32_t*)field(key) = c.i; break;
+    case T_FLOAT: *(float*)field(key)   = c.f; break;
+    case T_BOOL:  *(bool*)field(key)    = c.b; break;
+    case T_STR: {
+      char* d = (char*)field(key);
+      memcpy(d, c.s, c.n); d[c.n] = 0;
+      break;
+    }
+    case T_ENUM: {
+      *(uint8_t*)field(key) = c.e;
+      const char* o = ""; size_t on = 0;
+      opt_at(r.opts, c.e, &o, &on);
+      if (on >= OPT_MAX) on = OPT_MAX - 1;
+      memcpy(s_enum[key], o, on); s_enum[key][on] = 0;
+      break;
+    }
+  }
+}
+
+// Aktueller Wert als Bus-Payload (value=…)
+static bus::Payload payload_of(Key key) {
+  bus::Payload p;
+  switch (ROWS[key].type) {
+    case T_INT:   p.set(k::value, (int)get_int(key)); break;
+    case T_FLOAT: p.set(k::value, get_float(key));    break;
+    case T_BOOL:  p.set(k::value, get_bool(key));     break;
+    default:      p.set(k::value, get_str(key));      break;
+  }
+  return p;
+}
+
+static void note_raw(Key key, const char* s, size_t n) {
+  if (n >= RAW_MAX) n = RAW_MAX - 1;
+  memcpy(s_raw[key], s, n); s_raw[key][n] = 0;
+  for (size_t i = 0; i < n; ++i) if ((unsigned char)s_raw[key][i] <= ' ') s_raw[key][i] = '_';
+}
+
+static void reset_defaults() {
+  for (uint8_t i = 0; i < KEY_COUNT; ++i) {
+    Cell c = {};
+    const Parse r = parse(ROWS[i], ROWS[i].def, strlen(ROWS[i].def), c);
+    store((Key)i, c);
+    s_src[i] = r == P_OK ? S_DEFAULT : S_INVALID;   // kaputter Schema-Default fällt in info config.schema auf
+    s_raw[i][0] = 0;
+  }
+}
+
+static int user_find(bus::topic_t topic);
+
+// Reload: nur geänderte Keys emittieren (Vergleich mit dem aktuellen Sticky)
+static bool s_reloading   = false;
+static bool s_shadow_user = false;   // dev.ini-Durchlauf: Keys aus user.ini gewinnen später
+static ReloadStats s_reload = {};
+
+// Jeder Config-Emit beim Laden läuft hier durch (Cache-Aufzeichnung, Zählung)
+static void emit(bus::topic_t topic, const bus::Payload& p) {
+  if (s_reloading) {
+    if (s_shadow_user && user_find(topic) >= 0) return;
+    bus::Payload cur;
+    if (bus::get_sticky(topic, cur) && cur.same(p)) { ++s_reload.same; return; }
+    ++s_reload.changed;
+    bus::emit_sticky(topic, p);
+    return;
+  }
+  bus::emit_sticky(topic, p);
+  cache::record(topic, p);
+  ++s_load.keys;
+}
+
+// Schema-Hash: ändert sich mit jeder Row und mit dem Struct-Layout → alter Cache ungültig
+static uint32_t schema_hash() {
+  uint32_t h = 2166136261u;
+  auto mix = [&h](const void* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) { h ^= ((const uint8_t*)p)[i]; h *= 16777619u; }
+  };
+  const uint32_t layout[] = { (uint32_t)sizeof(Values), (uint32_t)KEY_COUNT, (uint32_t)RAW_MAX, (uint32_t)OPT_MAX };
+  mix(layout, sizeof(layout));
+  for (const Row& r : ROWS) {
+    mix(r.name, strlen(r.name) + 1); mix(r.def, strlen(r.def) + 1); mix(r.opts, strlen(r.opts) + 1);
+    mix(&r.type, sizeof(r.type)); mix(&r.min, sizeof(r.min)); mix(&r.max, sizeof(r.max));
+  }
+  return h;
+}
+
+// INI-Wert eines Schema-Keys: einmal prüfen/umwandeln, dann typisiert auf den Bus
+static void load_kv(Key key, bus::topic_t topic, const char* s, size_t n) {
+  Cell c = {};
+  switch (parse(ROWS[key], s, n, c)) {
+    case P_OK:      store(key, c); s_src[key] = S_INI; s_raw[key][0] = 0; break;
+    case P_CLAMPED: store(key, c); s_src[key] = S_CLAMPED; note_raw(key, s, n); break;
+    case P_INVALID: {
+      Cell d = {};
+      parse(ROWS[key], ROWS[key].def, strlen(ROWS[key].def), d);
+      store(key, d);
+      s_src[key] = S_INVALID;
+      note_raw(key, s, n);
+      break;
+    }
+  }
+  emit(topic, payload_of(key));
+}
 
 // ------------------------- Helpers -------------------------
 static bool ensure_dir(const char* path) {
@@ -20,72 +266,127 @@ static bool ensure_dir(const char* path) {
   return LittleFS.mkdir(path) || LittleFS.exists(path);
 }
 
-static void prime_kv(const String& section, const String& key, const String& rawValue) {
-  if (!section.length() || !key.length()) return;
-  // Topic: section.key  | Payload: value=<raw>
-  String topic = section + "." + key;
-  String kv = "value=" + rawValue;
-  bus::emit_sticky(topic, kv);
+static bus::topic_t prime_kv(const char* topic, size_t tn, const char* raw, size_t n) {
+  // Topic: section.key  | Payload: Schema-Key → typisiert, sonst value=<raw>
+  const bus::topic_t id = bus::intern(topic, tn);
+  if (id == bus::topic_t::NONE) return id;
+  const Key sk = key_of(id);
+  if (sk != K_NONE) { load_kv(sk, id, raw, n); return id; }
+  emit(id, bus::Payload().put(bus::k::value, raw, n));
+  return id;
 }
 
-// Parser für INI-Dateien: sehr einfach (Sections, key=value, ;/# Kommentare)
-static void parse_and_prime_ini(const char* filepath, bool also_update_user_state) {
-  if (!LittleFS.exists(filepath)) return;
-  File f = LittleFS.open(filepath, "r");
-  if (!f) return;
+static int user_find(bus::topic_t topic) {
+  for (uint8_t i = 0; i < s_user_n; ++i) if (s_user[i].topic == topic) return i;
+  return -1;
+}
 
-  String section;
-  while (f.available()) {
-    String line = f.readStringUntil('\n');
-    line.trim();
-    if (!line.length() || line.startsWith(";") || line.startsWith("#")) continue;
+// Neuer User-Key (Laden aus user.ini oder erstes set); -1 = passt nicht
+static int user_add(bus::topic_t topic, const char* name, size_t n) {
+  if (topic == bus::topic_t::NONE || s_user_n >= USER_MAX || n >= USER_NAME_MAX || !memchr(name, '.', n)) {
+    s_user_lossy = true;
+    return -1;
+  }
+  UserKey& u = s_user[s_user_n];
+  u.topic = topic;
+  memcpy(u.name, name, n); u.name[n] = 0;
+  u.val[0] = 0;
+  return s_user_n++;
+}
 
-    if (line.startsWith("[") && line.endsWith("]")) {
-      section = line.substring(1, line.length() - 1);
-      section.trim();
-      continue;
-    }
+static bool user_set_val(UserKey& u, const char* s, size_t n) {
+  if (n >= USER_VAL_MAX) return false;
+  memcpy(u.val, s, n); u.val[n] = 0;
+  return true;
+}
 
-    int eq = line.indexOf('=');
-    if (eq <= 0) continue;
+// Schema-Wert in kanonischer INI-Schreibweise
+static size_t format_value(Key key, char* buf, size_t cap) {
+  switch (ROWS[key].type) {
+    case T_INT:   return snprintf(buf, cap, "%ld", (long)get_int(key));
+    case T_FLOAT: return snprintf(buf, cap, "%g", (double)get_float(key));
+    case T_BOOL:  return snprintf(buf, cap, "%s", get_bool(key) ? "on" : "off");
+    default:      return snprintf(buf, cap, "%s", get_str(key));
+  }
+}
 
-    String key = line.substring(0, eq); key.trim();
-    String val = line.substring(eq + 1); val.trim();
+// INI-Datei streamen (ini_reader.hpp): Spans statt Strings, kein Heap je Key
+// prime = false: nur die User-Tabelle füllen (reload, erster Durchlauf)
+static void parse_and_prime_ini(const char* filepath, bool also_update_user_state, bool prime = true) {
+  if (!LittleFS.exists(filepath)) return;
+  File f = LittleFS.open(filepath, "r");
+  if (!f) return;
+
+  ini::Reader r(f);
+  ini::Entry e;
+  char topic[USER_NAME_MAX + 48];
+  while (r.next(e)) {
+    if (!e.section.n || e.section.n + 1 + e.key.n > sizeof(topic)) continue;
+    memcpy(topic, e.section.p, e.section.n);
+    topic[e.section.n] = '.';
+    memcpy(topic + e.section.n + 1, e.key.p, e.key.n);
+    const size_t tn = e.section.n + 1 + e.key.n;
 
     // 1) Immer: Prime als Sticky
-    prime_kv(section, key, val);
-
-    // 2) Optional: user.ini-spezifische State-Übernahmen (bekannte Keys)
-    if (also_update_user_state && section == "ui" && key == "brightness") {
-      int v = val.toInt();
-      if (v < 0) v = 0; if (v > 100) v = 100;
-      s_ui_brightness = v;
-      s_has_ui_brightness = true;
+    const bus::topic_t id = prime ? prime_kv(topic, tn, e.value.p, e.value.n) : bus::intern(topic, tn);
+
+    // 2) user.ini: Eintrag merken (Rohtext), damit das Zurückschreiben nichts verliert
+    if (also_update_user_state) {
+      int i = user_find(id);
+      if (i < 0) i = user_add(id, topic, tn);
+      if (i >= 0 && !user_set_val(s_user[i], e.value.p, e.value.n)) s_user_lossy = true;
       // Nicht dirty – Laden ist kein Änderungsgrund
     }
   }
   f.close();
 }
 
+// Abschnitt eines Eintrags ("ui.drawer.columns" → "ui.drawer")
+static size_t section_len(const UserKey& u) { return strrchr(u.name, '.') - u.name; }
+
+// Ganze user.ini in einen Puffer: Abschnitte in Reihenfolge ihres ersten Auftretens
+static size_t serialize_user(char* buf, size_t cap) {
+  static const char HEAD[] = "; TwatchOS+ user settings (auto-saved)\n";
+  size_t w = 0;
+  auto put = [&](const char* s, size_t n) { if (w + n <= cap) memcpy(buf + w, s, n); w += n; };
+  put(HEAD, sizeof(HEAD) - 1);
+  for (uint8_t i = 0; i < s_user_n; ++i) {
+    const size_t sl = section_len(s_user[i]);
+    bool seen = false;
+    for (uint8_t j = 0; j < i && !seen; ++j)
+      seen = section_len(s_user[j]) == sl && !memcmp(s_user[j].name, s_user[i].name, sl);
+    if (seen) continue;
+    put("\n[", 2); put(s_user[i].name, sl); put("]\n", 2);
+    for (uint8_t j = i; j < s_user_n; ++j) {
+      const UserKey& u = s_user[j];
+      if (section_len(u) != sl || memcmp(u.name, s_user[i].name, sl)) continue;
+      const char* key = u.name + sl + 1;
+      put(key, strlen(key)); put(" = ", 3); put(u.val, strlen(u.val)); put("\n", 1);
+    }
+  }
+  return w;
+}
+
+// Ein Puffer, ein write auf user.tmp, dann rename → user.ini ist immer alt oder neu
 static bool write_user_ini(size_t* bytes_written) {
   if (bytes_written) *bytes_written = 0;
+  if (s_user_lossy) return false;                 // unvollständige Kopie nie über das Original
 
   if (!ensure_dir("/config")) {
     return false;
   }
 
-  File f = LittleFS.open("/config/user.ini", "w");
-  if (!f) return false;
+  const size_t need = serialize_user(nullptr, 0);
+  char* buf = (char*)malloc(need);
+  if (!buf) return false;
+  serialize_user(buf, need);
 
-  size_t n = 0;
-  n += f.print("; TwatchOS+ user settings (auto-saved)\n");
-  if (s_has_ui_brightness) {
-    n += f.print("[ui]\n");
-    n += f.print("brightness = ");
-    n += f.print(String(s_ui_brightness));
-    n += f.print("\n");
-  }
+  File f = LittleFS.open(USER_TMP, "w");
+  if (!f) { free(buf); return false; }
+  const size_t n = f.write((const uint8_t*)buf, need);
   f.close();
+  free(buf);
+  if (n != need || !LittleFS.rename(USER_TMP, USER_INI)) { LittleFS.remove(USER_TMP); return false; }
 
   if (bytes_written) *bytes_written = n;
   return true;
@@ -93,31 +394,139 @@ static bool write_user_ini(size_t* bytes_written) {
 
 // ------------------------- Public API -------------------------
 void init() {
+  const uint32_t t0 = micros();
+  s_load = {};
+  reset_defaults();
+  s_user_n = 0;
+  s_user_lossy = false;
+  s_lossy_told = false;
+  s_dirty = 0;
+  if (LittleFS.exists(USER_TMP)) LittleFS.remove(USER_TMP);   // Rest eines abgebrochenen Schreibens
+
+  const cache::Block blocks[] = {
+    { &s_val, sizeof(s_val) }, { s_src, sizeof(s_src) }, { s_raw, sizeof(s_raw) },
+    { s_enum, sizeof(s_enum) }, { s_user, sizeof(s_user) }, { &s_user_n, sizeof(s_user_n) },
+    { &s_user_lossy, sizeof(s_user_lossy) },
+  };
+  const size_t nb = sizeof(blocks) / sizeof(blocks[0]);
+  const uint32_t schema = schema_hash();
+
+  // power.last_call: letzte Chance vor Deep-Sleep/Abschalten (ms=<Budget>)
+  bus::subscribe(bus::t::power_last_call, [](bus::topic_t, const bus::Payload& p) {
+    flush((uint32_t)p.get_int(k::ms, 0));
+  });
+
+  // Schneller Pfad: unverändertes Image → ein read, Stickies direkt aus den Einträgen
+  size_t keys = 0, bytes = 0;
+  if (s_cache_on && cache::load(INI_FILES, 2, blocks, nb, schema, &keys, &bytes)) {
+    s_load.cached = true;
+    s_load.keys   = (uint32_t)keys;
+    s_load.bytes  = (uint32_t)bytes;
+    s_load.us     = micros() - t0;
+    return;
+  }
+
+  if (s_cache_on) cache::begin(INI_FILES, 2);
+
   // dev.ini zuerst (Hardware-/System-Defaults), read-only
-  parse_and_prime_ini("/config/dev.ini", /*also_update_user_state=*/false);
+  parse_and_prime_ini(INI_FILES[0], /*also_update_user_state=*/false);
 
   // user.ini danach (User-Overrides & Präferenzen)
-  parse_and_prime_ini("/config/user.ini", /*also_update_user_state=*/true);
+  parse_and_prime_ini(INI_FILES[1], /*also_update_user_state=*/true);
+  s_load.us = micros() - t0;
 
-  // Laden setzt dirty NICHT
-  s_dirty = false;
+  // Image für den nächsten Boot (nach den Emits, zählt nicht zur Ladezeit)
+  if (s_cache_on) {
+    const uint32_t t1 = micros();
+    s_load.rebuilt  = cache::commit(blocks, nb, schema);
+    s_load.write_us = micros() - t1;
+  }
 }
 
-void note_ui_brightness(int value) {
-  s_has_ui_brightness = true;
-  if (s_ui_brightness != value) {
-    s_ui_brightness = value;
-    s_dirty = true;
+const ReloadStats& reload() {
+  const uint32_t t0 = micros();
+  s_reload = {};
+  s_reload.dropped = pending();            // Datei gewinnt über nicht gespeicherte Änderungen
+
+  reset_defaults();
+  s_user_n = 0;
+  s_user_lossy = false;
+  s_lossy_told = false;
+  s_dirty = 0;
+
+  // 1) user.ini-Keys kennen, damit dev.ini sie nicht kurz zurücksetzt
+  parse_and_prime_ini(INI_FILES[1], /*also_update_user_state=*/true, /*prime=*/false);
+
+  // 2) dev.ini, dann user.ini: wie beim Boot, aber nur Abweichungen auf den Bus
+  s_reloading = true;
+  s_shadow_user = true;
+  parse_and_prime_ini(INI_FILES[0], /*also_update_user_state=*/false);
+  s_shadow_user = false;
+  parse_and_prime_ini(INI_FILES[1], /*also_update_user_state=*/true);
+  s_reloading = false;
+
+  // 3) Schema-Keys, die in keiner INI mehr stehen → Default (falls je emittiert)
+  for (uint8_t i = 0; i < KEY_COUNT; ++i) {
+    if (s_src[i] != S_DEFAULT) continue;
+    bus::Payload cur;
+    const bus::Payload def = payload_of((Key)i);
+    if (!bus::get_sticky(ROWS[i].topic, cur) || cur.same(def)) continue;
+    bus::emit_sticky(ROWS[i].topic, def);
+    ++s_reload.reverted;
   }
+
+  s_reload.us = micros() - t0;
+  return s_reload;
 }
 
-bool is_dirty() { return s_dirty; }
+const LoadStats& load_stats() { return s_load; }
+void set_cache(bool on) { s_cache_on = on; }
+
+bool note(bus::topic_t topic, const char* raw, size_t n, bool create) {
+  int i = user_find(topic);
+  if (i < 0) {
+    if (!create) return false;
+    size_t tn = 0;
+    const char* name = bus::topic_name(topic, &tn);
+    if ((i = user_add(topic, name, tn)) < 0) return false;
+  }
+
+  // Schema-Keys kanonisch (Wert steht schon geprüft in s_val), sonst Rohtext
+  char buf[USER_VAL_MAX];
+  const Key key = key_of(topic);
+  if (key != K_NONE) { n = format_value(key, buf, sizeof(buf)); raw = buf; }
+  while (n && (unsigned char)*raw <= ' ') { ++raw; --n; }
+  while (n && (unsigned char)raw[n - 1] <= ' ') --n;
+
+  UserKey& u = s_user[i];
+  if (strlen(u.val) == n && !memcmp(u.val, raw, n)) return true;   // unverändert → kein Schreiben
+  if (!user_set_val(u, raw, n)) return false;
+
+  const uint32_t now = millis();
+  ++s_persist.changes;
+  if (s_dirty) ++s_persist.coalesced;
+  else         s_first_ms = now;
+  s_dirty |= 1ull << i;
+  s_last_ms = now;
+  return true;
+}
+
+void note_ui_brightness(int value) {
+  s_src[K_ui_brightness] = S_SET;
+  s_val.ui_brightness = value;
+  note(bus::t::ui_brightness, "", 0, /*create=*/true);
+}
+
+bool is_dirty() { return s_dirty != 0; }
+bool is_lossy() { return s_user_lossy; }
+uint8_t pending() { return (uint8_t)__builtin_popcountll(s_dirty); }
+const PersistStats& persist_stats() { return s_persist; }
 
 String snapshot() {
   String s;
-  if (s_has_ui_brightness) {
+  if (has_ui_brightness()) {
     if (s.length()) s += " ";
-    s += "ui.brightness="; s += String(s_ui_brightness);
+    s += "ui.brightness="; s += String(s_val.ui_brightness);
   }
   return s;
 }
@@ -125,22 +534,106 @@ String snapshot() {
 bool save_now(size_t* bytes_written) {
   if (!s_dirty) { if (bytes_written) *bytes_written = 0; return true; }
   size_t bw = 0;
-  bool ok = write_user_ini(&bw);
-  if (ok) {
-    s_dirty = false;
-    if (bytes_written) *bytes_written = bw;
+  const uint32_t t0 = micros();
+  const bool ok = write_user_ini(&bw);
+  const uint32_t us = micros() - t0;
+  if (!ok) {
+    ++s_persist.failed;
+    s_first_ms = s_last_ms = millis();  // nächster Versuch erst nach einem weiteren Fenster
+    return false;
   }
-  return ok;
+  cache::invalidate();                  // user.ini neu → Image beim nächsten Boot neu bauen
+  s_dirty = 0;
+  ++s_persist.writes;
+  s_persist.last_bytes = (uint32_t)bw;
+  s_persist.last_us    = us;
+  if (bytes_written) *bytes_written = bw;
+  bus::emit_sticky(bus::t::config_saved, bus::Payload().set(k::bytes, (int)bw).set(k::n, (int)s_user_n));
+  return true;
 }
 
-void on_power_last_call() {
+void poll() {
   if (!s_dirty) return;
-  size_t bw = 0;
-  (void)save_now(&bw);
-  // Optional: Event "evt config.saved bytes=<bw>" denkbar
+  if (s_user_lossy) {                   // kann nie gelingen → nicht zyklisch neu schreiben
+    if (!s_lossy_told) {
+      s_lossy_told = true;
+      TRACE_TXT(svc_config, LV_WARN, trace_svc_config_persist,
+                "user.ini not written: entry exceeds limits (keys/name/value)");
+    }
+    return;
+  }
+  const uint32_t now = millis();
+  const bool quiet   = now - s_last_ms  >= (uint32_t)s_val.config_persist_debounce_ms;
+  const bool overdue = now - s_first_ms >= (uint32_t)s_val.config_persist_max_delay_ms;
+  if (quiet || overdue) (void)save_now();
 }
 
-bool has_ui_brightness() { return s_has_ui_brightness; }
-int  get_ui_brightness() { return s_ui_brightness; }
+bool flush(uint32_t budget_ms) {
+  if (!s_dirty) return true;
+  ++s_persist.forced;
+  // Letzte gemessene Schreibdauer passt nicht ins Budget → nicht anfangen
+  if (budget_ms && s_persist.last_us > budget_ms * 1000u) { ++s_persist.missed; return false; }
+  const uint32_t t0 = millis();
+  const bool ok = save_now();
+  if (ok && budget_ms && millis() - t0 > budget_ms) ++s_persist.missed;
+  return ok;
+}
+
+void on_power_last_call() { (void)flush(0); }
+
+bool has_ui_brightness() { return user_find(bus::t::ui_brightness) >= 0; }
+int  get_ui_brightness() { return s_val.ui_brightness; }
+
+// ------------------------- Schema-API -------------------------
+const Values& values() { return s_val; }
+const Row&    row(Key key) { return ROWS[key < KEY_COUNT ? key : 0]; }
+
+Key key_of(bus::topic_t topic) {
+  for (uint8_t i = 0; i < KEY_COUNT; ++i) if (ROWS[i].topic == topic) return (Key)i;
+  return K_NONE;
+}
+
+Source      source(Key key)        { return key < KEY_COUNT ? s_src[key] : S_DEFAULT; }
+const char* raw(Key key)           { return key < KEY_COUNT ? s_raw[key] : ""; }
+const char* type_name(Type t)      { return t <= T_ENUM ? TYPE_NAMES[t] : "?"; }
+const char* source_name(Source s)  { return s <= S_SET ? SOURCE_NAMES[s] : "?"; }
+
+int32_t get_int(Key key) {
+  if (key >= KEY_COUNT) return 0;
+  switch (ROWS[key].type) {
+    case T_INT:   return *(const int32_t*)field(key);
+    case T_FLOAT: return (int32_t)*(const float*)field(key);
+    case T_BOOL:  return *(const bool*)field(key) ? 1 : 0;
+    case T_ENUM:  return *(const uint8_t*)field(key);
+    default:      return 0;
+  }
+}
+
+float get_float(Key key) {
+  if (key < KEY_COUNT && ROWS[key].type == T_FLOAT) return *(const float*)field(key);
+  return (float)get_int(key);
+}
+
+bool get_bool(Key key) { return get_int(key) != 0; }
+
+const char* get_str(Key key) {
+  if (key >= KEY_COUNT) return "";
+  if (ROWS[key].type == T_STR)  return (const char*)field(key);
+  if (ROWS[key].type == T_ENUM) return s_enum[key];
+  return "";
+}
+
+bool accept(bus::topic_t topic, const char* s, size_t n, bus::Payload& out, bool* known) {
+  const Key key = key_of(topic);
+  if (known) *known = key != K_NONE;
+  if (key == K_NONE) return false;
+  Cell c = {};
+  if (parse(ROWS[key], s, n, c) != P_OK) return false;   // zur Laufzeit nicht klemmen, ablehnen
+  store(key, c);
+  s_src[key] = S_SET;
+  s_raw[key][0] = 0;
+  out = payload_of(key);
+  return true;
+}
 
 } // namespace config
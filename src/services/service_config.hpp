@@ -1,31 +1,154 @@
 // GPT: Vorbereitender Stub für spätere Implementierung (von Andi gewünscht)
 // Schlanker Config-Service:
 //  - Lädt /config/dev.ini und /config/user.ini beim Boot
-//  - Primed ALLE Key/Value-Paare als Sticky-Events: <section>.<key>  value=<raw>
+//  - Primed ALLE Key/Value-Paare als Sticky-Events: <section>.<key>  value=<raw>;
+//    Schema-Keys (config_schema.hpp) einmal geprüft und typisiert (value=<int|float|0/1|str>)
 //  - Kein Merge; dev.ini wird nie geschrieben
-//  - user.ini wird nur bei Änderungs-Tracking gespeichert (z.B. ui.brightness)
+//  - user.ini: alle Einträge sind User-Keys; Änderungen werden gesammelt und
+//    verzögert, atomar (tmp + rename) zurückgeschrieben
 //  - Bietet minimalen State-Zugriff (ui.brightness) für andere Module
 
 #pragma once
 #include <Arduino.h>
+#include "config_schema.hpp"
+#include "../core/bus.hpp"
 
 namespace config {
 
+// ---------------------------------------------------------------------------
+// Schema (config_schema.hpp)
+enum Type : uint8_t { T_INT = 0, T_FLOAT, T_BOOL, T_STR, T_ENUM };
+
+enum Key : uint8_t {
+#define CONFIG_KEY_ENUM(id, name, type, mn, mx, def, opts, owner) K_##id,
+  CONFIG_SCHEMA(CONFIG_KEY_ENUM)
+#undef CONFIG_KEY_ENUM
+  KEY_COUNT,
+  K_NONE = 0xFF
+};
+
+// Herkunft des aktuellen Werts
+enum Source : uint8_t {
+  S_DEFAULT = 0,   // nicht in der INI → Schema-Default
+  S_INI,           // aus dev.ini/user.ini, im Bereich
+  S_CLAMPED,       // aus der INI, außerhalb des Bereichs → geklemmt
+  S_INVALID,       // aus der INI, nicht lesbar → Schema-Default
+  S_SET            // zur Laufzeit (set/emit/note_*)
+};
+
+// Flacher Struct mit allen Schema-Werten (ENUM als Index)
+struct Values {
+#define CONFIG_VALUE_FIELD(id, name, type, mn, mx, def, opts, owner) CONFIG_FIELD_##type(id)
+#define CONFIG_FIELD_INT(id)   int32_t id;
+#define CONFIG_FIELD_FLOAT(id) float   id;
+#define CONFIG_FIELD_BOOL(id)  bool    id;
+#define CONFIG_FIELD_ENUM(id)  uint8_t id;
+#define CONFIG_FIELD_STR(id)   char    id[CONFIG_STR_MAX];
+  CONFIG_SCHEMA(CONFIG_VALUE_FIELD)
+#undef CONFIG_VALUE_FIELD
+};
+
+struct Row {
+  const char*  name;
+  bus::topic_t topic;
+  Type         type;
+  double       min, max;
+  const char*  def;
+  const char*  opts;
+  const char*  owner;
+};
+
+const Values& values();                 // z. B. config::values().backlight_gamma
+const Row&    row(Key k);
+Key           key_of(bus::topic_t topic);   // K_NONE = nicht im Schema
+Source        source(Key k);
+const char*   raw(Key k);               // Rohwert bei S_CLAMPED/S_INVALID
+const char*   type_name(Type t);
+const char*   source_name(Source s);
+
+// Typisierte Zugriffe (ENUM: get_int = Index, get_str = Name)
+int32_t     get_int(Key k);
+float       get_float(Key k);
+bool        get_bool(Key k);
+const char* get_str(Key k);
+
+// Rohwert für ein Schema-Topic prüfen, umwandeln und übernehmen → typisierte
+// Payload value=… für den Bus. false bei Wert außerhalb des Bereichs / unlesbar
+// (Struct unverändert); Nicht-Schema-Topics → false mit *known = false.
+bool accept(bus::topic_t topic, const char* raw, size_t n, bus::Payload& out, bool* known = nullptr);
+
 // Init liest dev.ini & user.ini und primed die Werte auf den Event-Bus.
 //  - dev.ini: read-only, alle Einträge als Sticky 'section.key value=<raw>'
 //  - user.ini: dito; bekannte Keys werden in State übernommen
+// Nur mit -D CONFIG_CACHE=1 (Default aus): ist /config/cache.bin zu beiden INIs
+// passend (config_cache.hpp), kommt alles aus dem Image; sonst INI-Pfad und
+// Image neu schreiben.
 void init();
 
+struct LoadStats {
+  bool     cached;     // aus cache.bin
+  bool     rebuilt;    // INI-Pfad hat ein neues Image geschrieben
+  uint32_t us;         // init() bis alle Stickies emittiert sind
+  uint32_t write_us;   // Image schreiben (nur rebuilt)
+  uint32_t keys;       // emittierte Stickies
+  uint32_t bytes;      // Image-Größe (cached)
+};
+const LoadStats& load_stats();
+
+// do config.reload: beide INIs neu lesen und nur geänderte Keys emittieren
+// (Vergleich mit dem aktuellen Sticky). Endzustand wie nach einem Boot mit
+// diesen Dateien: Schema-Keys, die aus den INIs verschwunden sind, fallen auf
+// den Default zurück; andere Keys behalten ihren letzten Wert. Nicht
+// gespeicherte Änderungen an User-Keys werden verworfen (dropped).
+struct ReloadStats {
+  uint32_t changed;    // emittiert (neuer Wert)
+  uint32_t same;       // unverändert, nicht emittiert
+  uint32_t reverted;   // Schema-Key entfernt → Default emittiert
+  uint32_t dropped;    // verworfene ungespeicherte User-Änderungen
+  uint32_t us;
+};
+const ReloadStats& reload();
+void set_cache(bool on);   // Host-Bench / Diagnose: Image nutzen (true) oder ignorieren, Default CONFIG_CACHE
+
 // Tracking-APIs (von Parser/Modulen aufzurufen)
+// User-Key (steht in user.ini) geändert → dirty, Schreiben per poll() nach dem
+// Debounce-Fenster. Schema-Keys werden aus dem geprüften Wert formatiert, sonst
+// der Rohtext. create = auch neu anlegen. false = kein User-Key / passt nicht.
+bool note(bus::topic_t topic, const char* raw, size_t n, bool create = false);
 void note_ui_brightness(int value);
 
+// Write-Behind: Änderungen sammeln, dann ein Schreibvorgang (ganze user.ini in
+// einem Puffer → user.tmp → rename). Geschrieben wird, sobald
+// config.persist.debounce_ms lang nichts mehr kam, spätestens
+// config.persist.max_delay_ms nach der ersten Änderung.
+struct PersistStats {
+  uint32_t changes;     // note() mit neuem Wert
+  uint32_t coalesced;   // davon in einen schon offenen Schreibvorgang gefallen
+  uint32_t writes;      // erfolgreiche Schreibvorgänge
+  uint32_t failed;
+  uint32_t forced;      // flush() mit offenen Änderungen
+  uint32_t missed;      // flush() Budget nicht gehalten (übersprungen oder zu spät)
+  uint32_t last_bytes;
+  uint32_t last_us;     // Dauer des letzten Schreibvorgangs
+};
+
 // Status / Save
 bool is_dirty();
-bool save_now(size_t* bytes_written = nullptr);  // schreibt /config/user.ini
-void on_power_last_call();                       // ruft save_now() wenn dirty
+bool is_lossy();   // user.ini nicht vollständig geladen → wird nie überschrieben
+uint8_t pending();                               // geänderte, noch nicht geschriebene Keys
+const PersistStats& persist_stats();
+// aus loop(): schreibt, wenn das Fenster abgelaufen ist. Fehlschlag → neues
+// Fenster ab jetzt; lossy (user.ini passte nicht in die Tabelle) → gar nicht,
+// einmal als Trace gemeldet (info config lossy=true)
+void poll();
+bool save_now(size_t* bytes_written = nullptr);  // sofort schreiben (do config.save)
+// Erzwungen, ohne Debounce (power.last_call ms=<Budget>). Passt die letzte
+// gemessene Schreibdauer nicht ins Budget, wird nicht angefangen → false.
+bool flush(uint32_t budget_ms = 0);
+void on_power_last_call();                       // flush() ohne Budget
 
 // Zugriff auf geladene Werte
-bool has_ui_brightness();
+bool has_ui_brightness();   // ui.brightness stand in user.ini bzw. wurde gesetzt
 int  get_ui_brightness();
 
 // Debug/Snapshot (z. B. "ui.brightness=65")
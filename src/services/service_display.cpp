@@ -1,74 +1,76 @@
 // GPT: Vorbereitender Stub für spätere Implementierung (von Andi gewünscht)
 #include "service_display.hpp"
 #include "../core/bus.hpp"
+#include "../core/trace.hpp"
 #include "../drivers/drv_display_st7789v.hpp"
 
 namespace svc { namespace display {
 
+namespace k = bus::k;
+using bus::Payload;
+
 // --- internes Hilfslog (nicht persistent) ---
-static inline void TRACE_IGN(const String& key, const String& value, const char* reason) {
-  bus::emit_sticky(String("trace.svc.display.ignored"),
-                   String("key=") + key + " value=" + value + " reason=" + reason);
+static inline void TRACE_IGN(bus::topic_t key, const Payload& p, const char* reason) {
+  TRACE_TXT(svc_display, LV_WARN, trace_svc_display_ignored,
+            String("key=") + bus::topic_name(key) + " value=" + p.str(k::value) + " reason=" + reason);
 }
 
 // Whitelist-Forwarder zum Treiber
-static void forward_to_driver(const String& topic, const String& value) {
-  drv::display_st7789v::apply_kv(topic, value);
+static void forward_to_driver(bus::topic_t topic, const Payload& p) {
+  drv::display_st7789v::apply_kv(topic, p);
 }
 
-void init() {
+void hw_init() {
   // Treiber initialisieren (SPI/PWM + Panel-Setup fix verdrahtet)
   drv::display_st7789v::init();
+}
 
-  // UI-Helligkeit (%): akzeptiert "value=NN" oder "NN"
-  bus::subscribe("ui.brightness", [](const String& topic, const String& value){
-    String v = value;
-    int eq = v.indexOf('=');
-    if (eq >= 0) v = v.substring(eq + 1);
-    int pct = v.toInt();
-    drv::display_st7789v::set_brightness_pct((uint8_t)pct);
+void init() {
+  // UI-Helligkeit (%): Feld value
+  bus::subscribe(bus::t::ui_brightness, [](bus::topic_t, const Payload& p){
+    drv::display_st7789v::set_brightness_pct((uint8_t)p.get_int(k::value, 0));
   });
 
   // Backlight-Parameter (Timer Hz / Auflösung / Gamma / Min%)
   bus::subscribe("backlight.*", forward_to_driver);
 
   // SPI-„Profil“-Keys (nur Telemetrie im Treiber)
-  bus::subscribe("spi0.*", [](const String& topic, const String& value){
+  bus::subscribe("spi0.*", [](bus::topic_t topic, const Payload& p){
     // Treiber akzeptiert nur slice_ms / prio / role → Rest ignorieren
-    if (topic == "spi0.slice_ms" || topic == "spi0.prio" || topic == "spi0.role") {
-      forward_to_driver(topic, value);
+    if (topic == bus::t::spi0_slice_ms || topic == bus::t::spi0_prio || topic == bus::t::spi0_role) {
+      forward_to_driver(topic, p);
     } else {
-      TRACE_IGN(topic, value, "unsupported_spi_key");
+      TRACE_IGN(topic, p, "unsupported_spi_key");
     }
   });
 
   // Display-Befehle: nur zulässige Keys weiterreichen
-  bus::subscribe("display.*", [](const String& topic, const String& value){
+  bus::subscribe("display.*", [](bus::topic_t topic, const Payload& p){
     // Hart verdrahtet im Treiber → nicht weiterleiten
-    if (topic == "display.colmod" ||
-        topic == "display.rgb565_endian" ||
-        topic == "display.spi_mode" ||
-        topic == "display.spi_hz" ||
-        topic == "display.color_order" ||
-        topic == "display.invert") {
-      TRACE_IGN(topic, value, "hardwired_in_driver");
+    if (topic == bus::t::display_colmod ||
+        topic == bus::t::display_rgb565_endian ||
+        topic == bus::t::display_spi_mode ||
+        topic == bus::t::display_spi_hz ||
+        topic == bus::t::display_color_order ||
+        topic == bus::t::display_invert) {
+      TRACE_IGN(topic, p, "hardwired_in_driver");
       return;
     }
 
     // Erlaubte Keys
-    if (topic == "display.rotate" ||
-        topic == "display.fill" ||
-        topic == "display.test" ||
-        topic == "display.offset.rot0" ||
-        topic == "display.offset.rot1" ||
-        topic == "display.offset.rot2" ||
-        topic == "display.offset.rot3") {
-      forward_to_driver(topic, value);
+    if (topic == bus::t::display_rotate ||
+        topic == bus::t::display_fill ||
+        topic == bus::t::display_test ||
+        topic == bus::t::display_offset_rot0 ||
+        topic == bus::t::display_offset_rot1 ||
+        topic == bus::t::display_offset_rot2 ||
+        topic == bus::t::display_offset_rot3) {
+      forward_to_driver(topic, p);
       return;
     }
 
     // Alles andere: ignorieren (sicher)
-    TRACE_IGN(topic, value, "unsupported_display_key");
+    TRACE_IGN(topic, p, "unsupported_display_key");
   });
 
   // power.mode_changed wird vom gehärteten Displaytreiber nicht mehr benötigt
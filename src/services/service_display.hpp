@@ -4,6 +4,7 @@
 
 namespace svc { namespace display {
 
-void init();   // orchestriert Display-Start und ui.* / backlight.* / display.* Events
+void hw_init();   // Treiber + Panel-Setup (Boot-Stage, Hintergrund-Task, kein Bus)
+void init();      // ui.* / backlight.* / display.* Events an den Treiber (nach hw_init, loop)
 
 } } // namespace svc::display
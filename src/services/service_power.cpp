@@ -15,12 +15,16 @@
 #include <Wire.h>
 
 #include "../core/bus.hpp"
+#include "../core/trace.hpp"
+#include "../core/console.hpp"
 #include "../drivers/drv_power_axp2101.hpp"
 
 #include "esp_sleep.h"
 #include "esp_err.h"
 
 using drv::axp2101::Axp2101;
+using ::bus::Payload;
+namespace k = ::bus::k;
 
 // -------------------- Persistentes Logging -----------------------------------
 namespace {
@@ -53,15 +57,7 @@ namespace {
       s_log = LittleFS.open(k_log_path, "a");
     }
     if (s_log) { s_log.println(line); s_log.flush(); rotate_if_needed(); }
-    ::bus::emit_sticky("trace.svc.power.log", line);
-  }
-  String kv_get(const String& kv, const String& key) {
-    int p = kv.indexOf(key + "=");
-    if (p < 0) return "";
-    p += key.length() + 1;
-    int e = kv.indexOf(' ', p);
-    if (e < 0) e = kv.length();
-    return kv.substring(p, e);
+    TRACE_TXT(svc_power, LV_DEBUG, trace_svc_power_log, line);
   }
   void write_resume_capsule(const String& line) {
     ensure_log_dirs();
@@ -74,7 +70,7 @@ namespace {
     if (File f = LittleFS.open(k_resume_path, "r")) {
       String all = f.readString(); f.close(); all.trim();
       if (all.length()) {
-        ::bus::emit_sticky("trace.svc.power.resume.persist", all);
+        TRACE_TXT(svc_power, LV_INFO, trace_svc_power_resume_persist, all);
         log_line(String("[PERSIST] ") + all);
       }
     }
@@ -89,6 +85,7 @@ namespace {
 // -------------------- Policy / State ----------------------------------------
 namespace {
   static uint32_t s_autowake_ms = 0; // 0=aus
+  static const int LAST_CALL_BUDGET_MS = 200; // power.last_call: Zeit für Owner (Config-Flush)
 
   // Guards (aus Config)
   static bool s_prevent_ls  = false;
@@ -101,23 +98,52 @@ namespace {
 }
 
 // -------------------- Telemetrie --------------------------------------------
+// Messen (I2C) und Veröffentlichen (Bus/Log) getrennt: beim Boot misst die
+// Stage auf dem Hintergrund-Task, veröffentlicht wird im loop().
 namespace {
+  struct Telemetry {
+    uint16_t vbat_mv = 0, vsys_mv = 0, vbus_mv = 0;
+    bool     ok_vbat = false, ok_vsys = false, ok_vbus = false;
+  };
+  struct IrqSnap {
+    drv::axp2101::AxpEvents ev{};
+    bool ok = false;
+  };
+  static Telemetry s_boot_tel;
+  static IrqSnap   s_boot_irq;
+
+  // PMU-Ergebnisse der Boot-Stage (geloggt erst in hw_attach)
+  static bool s_pmu_begin_ok = false;
+  static bool s_pmu_on_ok    = false;
+
+  void read_telemetry(Telemetry& t) {
+    t.ok_vbat = s_pmu.readVBAT_mV(t.vbat_mv);
+    t.ok_vsys = s_pmu.readVSYS_mV(t.vsys_mv);
+    t.ok_vbus = s_pmu.readVBUS_mV(t.vbus_mv);
+  }
+
+  void publish_telemetry(const char* phase, const Telemetry& t) {
+    // Fehlgeschlagene Messungen fehlen im Payload (statt "…_mv=0?")
+    Payload p;
+    p.set(k::phase, phase);
+    if (t.ok_vbat) p.set(k::vbat_mv, (int)t.vbat_mv);
+    if (t.ok_vsys) p.set(k::vsys_mv, (int)t.vsys_mv);
+    if (t.ok_vbus) p.set(k::vbus_mv, (int)t.vbus_mv);
+    ::bus::emit_sticky(::bus::t::state_power_telemetry, p);
+    log_line(String("[TEL] ") + p.to_string());
+  }
+
   void snapshot_power_telemetry(const char* phase) {
-    uint16_t mv_vbat=0, mv_vsys=0, mv_vbus=0;
-    bool ok1 = s_pmu.readVBAT_mV(mv_vbat);
-    bool ok2 = s_pmu.readVSYS_mV(mv_vsys);
-    bool ok3 = s_pmu.readVBUS_mV(mv_vbus);
-    String msg = String("phase=") + phase +
-                 " vbat_mv=" + String((int)mv_vbat) + (ok1?"":"?") +
-                 " vsys_mv=" + String((int)mv_vsys) + (ok2?"":"?") +
-                 " vbus_mv=" + String((int)mv_vbus) + (ok3?"":"?");
-    ::bus::emit_sticky("state.power.telemetry", msg);
-    log_line(String("[TEL] ") + msg);
+    Telemetry t;
+    read_telemetry(t);
+    publish_telemetry(phase, t);
   }
 
-  void dump_irq_compact(const char* tag) {
-    drv::axp2101::AxpEvents ev{};
-    bool ok = s_pmu.pollIRQ(true, &ev);
+  void read_irq(IrqSnap& s) { s.ok = s_pmu.pollIRQ(true, &s.ev); }
+
+  void publish_irq(const char* tag, const IrqSnap& s) {
+    const drv::axp2101::AxpEvents& ev = s.ev;
+    const bool ok = s.ok;
     String msg = String("tag=") + tag +
                  " ok=" + (ok?"1":"0") +
                  " st1=" + String((int)ev.st1) +
@@ -126,9 +152,17 @@ namespace {
                  " vbus_in=" + String(ev.vbus_in ? 1 : 0) +
                  " chg_start=" + String(ev.chg_start ? 1 : 0) +
                  " chg_done="  + String(ev.chg_done  ? 1 : 0);
-    ::bus::emit_sticky("trace.svc.power.irq", msg);
+    TRACE_REC(svc_power, LV_INFO, trace_svc_power_irq,
+              {k::tag, tag}, {k::ok, ok}, {k::st, ::trace::Hex{(uint32_t)ev.st1 << 16 | ev.st2 << 8 | ev.st3}},
+              {k::vbus_in, ev.vbus_in}, {k::chg_start, ev.chg_start}, {k::chg_done, ev.chg_done});
     log_line(String("[IRQ] ") + msg);
   }
+
+  void dump_irq_compact(const char* tag) {
+    IrqSnap s;
+    read_irq(s);
+    publish_irq(tag, s);
+  }
 }
 
 // -------------------- Backlight-Handling (Flicker-Fix) ----------------------
@@ -136,7 +170,7 @@ namespace {
   void dim_backlight_for_sleep() {
     if (s_dimmed_for_sleep) return;
     s_saved_brightness = s_ui_brightness; // kann -1 sein
-    ::bus::emit_sticky("ui.brightness", "value=0 origin=power");
+    ::bus::emit_sticky(::bus::t::ui_brightness, Payload().set(k::value, 0).set(k::origin, "power"));
     log_line("[BL] dim to 0 for sleep");
     delay(60);
     s_dimmed_for_sleep = true;
@@ -144,7 +178,7 @@ namespace {
   void restore_backlight_after_sleep() {
     if (!s_dimmed_for_sleep) return;
     if (s_saved_brightness >= 0) {
-      ::bus::emit_sticky("ui.brightness", String("value=") + String(s_saved_brightness) + " origin=power");
+      ::bus::emit_sticky(::bus::t::ui_brightness, Payload().set(k::value, s_saved_brightness).set(k::origin, "power"));
       log_line(String("[BL] restore=") + String(s_saved_brightness));
       delay(10);
     }
@@ -155,7 +189,7 @@ namespace {
 // -------------------- Intents ------------------------------------------------
 namespace {
   void enter_ready(const String& origin) {
-    ::bus::emit_sticky("power.mode_changed", String("mode=ready origin=") + origin);
+    ::bus::emit_sticky(::bus::t::power_mode_changed, Payload().set(k::mode, "ready").set(k::origin, origin));
     log_line(String("[MODE] ready origin=") + origin);
     restore_backlight_after_sleep();
     snapshot_power_telemetry("ready");
@@ -164,17 +198,17 @@ namespace {
   void enter_standby(const String& origin) {
     if (s_prevent_sb) {
       log_line(String("[BLOCK] standby (prevent_standby=1) origin=") + origin);
-      ::bus::emit_sticky("trace.svc.power.block", "intent=standby reason=prevent_standby");
+      TRACE_REC(svc_power, LV_WARN, trace_svc_power_block, {k::intent, "standby"}, {k::reason, "prevent_standby"});
       return;
     }
-    ::bus::emit_sticky("power.mode_changed", String("mode=standby origin=") + origin);
+    ::bus::emit_sticky(::bus::t::power_mode_changed, Payload().set(k::mode, "standby").set(k::origin, origin));
     log_line(String("[MODE] standby origin=") + origin);
   }
 
   void enter_lightsleep(const String& origin) {
     if (s_prevent_ls) {
       log_line(String("[BLOCK] lightsleep (prevent_lightsleep=1) origin=") + origin);
-      ::bus::emit_sticky("trace.svc.power.block", "intent=lightsleep reason=prevent_lightsleep");
+      TRACE_REC(svc_power, LV_WARN, trace_svc_power_block, {k::intent, "lightsleep"}, {k::reason, "prevent_lightsleep"});
       return;
     }
 
@@ -187,19 +221,20 @@ namespace {
     // Autowake Timer
     if (s_autowake_ms > 0) {
       esp_sleep_enable_timer_wakeup((uint64_t)s_autowake_ms * 1000ULL);
-      ::bus::emit_sticky("trace.svc.power.autowake", String("ms=") + String((unsigned long)s_autowake_ms));
+      TRACE_REC(svc_power, LV_INFO, trace_svc_power_autowake, {k::ms, s_autowake_ms});
       log_line(String("[AUTO] timer ") + String((unsigned long)s_autowake_ms) + " ms");
     }
 
     // Backlight ruhigstellen
     dim_backlight_for_sleep();
 
-    ::bus::emit_sticky("power.mode_changed", String("mode=lightsleep origin=") + origin);
+    ::bus::emit_sticky(::bus::t::power_mode_changed, Payload().set(k::mode, "lightsleep").set(k::origin, origin));
     log_line(String("[MODE] lightsleep origin=") + origin);
 
     snapshot_power_telemetry("pre_ls");
 
-    // GO: Light-Sleep
+    // GO: Light-Sleep (Konsolen-Ring vorher kurz leeren, USB ist danach weg)
+    console::flush(50);
     esp_err_t err = esp_light_sleep_start();
     const int wl = s_pmu.intLevel();
     const esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
@@ -207,7 +242,7 @@ namespace {
                     " cause=" + String((int)cause) +
                     " pmu_int_lvl=" + String(wl);
     log_line(resume);
-    ::bus::emit_sticky("trace.svc.power.resume", resume);
+    TRACE_REC(svc_power, LV_INFO, trace_svc_power_resume, {k::err, (int)err}, {k::cause, (int)cause}, {k::lvl, wl});
 
     dump_irq_compact("post_ls_dump");
     snapshot_power_telemetry("post_ls");
@@ -228,31 +263,37 @@ namespace {
                        " vbus_mv=" + String((int)mv_vbus) +
                        " irq_st=" + String((int)ev.st1) + "," + String((int)ev.st2) + "," + String((int)ev.st3);
       write_resume_capsule(capsule);
-      ::bus::emit_sticky("trace.svc.power.resume.capsule", capsule);
+      TRACE_REC(svc_power, LV_INFO, trace_svc_power_resume_capsule,
+                {k::cause, (int)cause}, {k::lvl, wl}, {k::vbat_mv, mv_vbat}, {k::vsys_mv, mv_vsys}, {k::vbus_mv, mv_vbus},
+                {k::st, ::trace::Hex{(uint32_t)ev.st1 << 16 | ev.st2 << 8 | ev.st3}});
     }
 
     // zurück in READY
-    ::bus::emit_sticky("power.mode_changed", "mode=ready origin=lightsleep");
+    ::bus::emit_sticky(::bus::t::power_mode_changed, Payload().set(k::mode, "ready").set(k::origin, "lightsleep"));
     log_line("[MODE] ready origin=lightsleep");
     restore_backlight_after_sleep();
   }
 
   void enter_deepsleep(const String& origin) {
     log_line(String("[MODE] deepsleep origin=") + origin);
+    // Letzter Aufruf: offene Config schreiben (Owner entscheidet, Budget in ms)
+    ::bus::emit_sticky(::bus::t::power_last_call, Payload().set(k::ms, LAST_CALL_BUDGET_MS));
     snapshot_power_telemetry("pre_ds");
     s_pmu.releaseIRQLine();
     s_pmu.armWakeGpioLow();
+    console::flush(50);
     esp_deep_sleep_start(); // no return
   }
 
-  void handle_intent(const String& kv) {
-    const String target = kv_get(kv, "target");
-    const String origin = kv_get(kv, "origin");
+  void handle_intent(const Payload& p) {
+    const String target = p.str(k::target);
+    const String origin = p.str(k::origin);
     if (target == "ready")      { enter_ready(origin.length()?origin:"api");      return; }
     if (target == "standby")    { enter_standby(origin.length()?origin:"api");    return; }
     if (target == "lightsleep") { enter_lightsleep(origin.length()?origin:"api"); return; }
     if (target == "deepsleep")  { enter_deepsleep(origin.length()?origin:"api");  return; }
-    ::bus::emit_sticky("trace.svc.power.warn", String("unknown_intent kv=") + kv);
+    const String kv = p.to_string();
+    TRACE_TXT(svc_power, LV_WARN, trace_svc_power_warn, String("unknown_intent kv=") + kv);
     log_line(String("[WARN] unknown intent: ") + kv);
   }
 }
@@ -261,114 +302,107 @@ namespace {
 namespace {
   void subscribe_bus() {
     // Autowake
-    ::bus::subscribe("power.sleep.autowake_ms",
-      [](const String&, const String& kv){
-        String v = kv_get(kv, "ms"); if (!v.length()) v = kv_get(kv, "value");
-        s_autowake_ms = (uint32_t)v.toInt();
-        ::bus::emit_sticky("trace.svc.power.autowake.set", String("ms=") + String((unsigned long)s_autowake_ms));
+    ::bus::subscribe(::bus::t::power_sleep_autowake_ms,
+      [](::bus::topic_t, const Payload& p){
+        s_autowake_ms = (uint32_t)(p.has(k::ms) ? p.get_int(k::ms) : p.get_int(k::value));
+        TRACE_REC(svc_power, LV_INFO, trace_svc_power_autowake_set, {k::ms, s_autowake_ms});
         log_line(String("[CFG] autowake_ms=") + String((unsigned long)s_autowake_ms));
       });
 
     // Guards
-    ::bus::subscribe("power.dev.prevent_lightsleep",
-      [](const String&, const String& kv){
-        String v = kv_get(kv, "value"); v.toLowerCase();
-        s_prevent_ls = (v=="on"||v=="1"||v=="true"||v=="yes");
-        ::bus::emit_sticky("trace.svc.power.guard", String("prevent_lightsleep=") + (s_prevent_ls? "1":"0"));
+    ::bus::subscribe(::bus::t::power_dev_prevent_lightsleep,
+      [](::bus::topic_t, const Payload& p){
+        s_prevent_ls = p.get_bool(k::value, false);
+        TRACE_REC(svc_power, LV_INFO, trace_svc_power_guard, {k::key, ::bus::t::power_dev_prevent_lightsleep}, {k::value, s_prevent_ls});
       });
-    ::bus::subscribe("power.dev.prevent_standby",
-      [](const String&, const String& kv){
-        String v = kv_get(kv, "value"); v.toLowerCase();
-        s_prevent_sb = (v=="on"||v=="1"||v=="true"||v=="yes");
-        ::bus::emit_sticky("trace.svc.power.guard", String("prevent_standby=") + (s_prevent_sb? "1":"0"));
+    ::bus::subscribe(::bus::t::power_dev_prevent_standby,
+      [](::bus::topic_t, const Payload& p){
+        s_prevent_sb = p.get_bool(k::value, false);
+        TRACE_REC(svc_power, LV_INFO, trace_svc_power_guard, {k::key, ::bus::t::power_dev_prevent_standby}, {k::value, s_prevent_sb});
       });
 
     // UI-Brightness (für Restore)
-    ::bus::subscribe("ui.brightness",
-      [](const String&, const String& kv){
-        String v = kv_get(kv, "value");
-        if (v.length()) s_ui_brightness = v.toInt();
+    ::bus::subscribe(::bus::t::ui_brightness,
+      [](::bus::topic_t, const Payload& p){
+        if (p.has(k::value)) s_ui_brightness = p.get_int(k::value);
       });
 
     // Persist-Config (optional)
-    ::bus::subscribe("log.persist.path",
-      [](const String&, const String& kv){
-        String v = kv_get(kv, "value"); if (!v.length()) v = kv_get(kv, "path");
-        s_cfg_persist_path = v;
-        ::bus::emit_sticky("trace.svc.power.persist.path", String("path=") + (s_cfg_persist_path.length()? s_cfg_persist_path : "(unset)"));
+    ::bus::subscribe(::bus::t::log_persist_path,
+      [](::bus::topic_t, const Payload& p){
+        s_cfg_persist_path = p.has(k::value) ? p.str(k::value) : p.str(k::path);
+        TRACE_TXT(svc_power, LV_INFO, trace_svc_power_persist_path, String("path=") + (s_cfg_persist_path.length()? s_cfg_persist_path : "(unset)"));
       });
-    ::bus::subscribe("log.persist.tail_bytes",
-      [](const String&, const String& kv){
-        String v = kv_get(kv, "value"); if (!v.length()) v = kv_get(kv, "bytes");
-        if (v.length()) s_cfg_persist_tail = (uint32_t)v.toInt();
-        ::bus::emit_sticky("trace.svc.power.persist.tail", String("bytes=") + String((unsigned long)s_cfg_persist_tail));
+    ::bus::subscribe(::bus::t::log_persist_tail_bytes,
+      [](::bus::topic_t, const Payload& p){
+        const uint8_t key = p.has(k::value) ? k::value : k::bytes;
+        if (p.has(key)) s_cfg_persist_tail = (uint32_t)p.get_int(key);
+        TRACE_REC(svc_power, LV_INFO, trace_svc_power_persist_tail, {k::bytes, s_cfg_persist_tail});
       });
 
     // On-Demand: Resume-Dump
-    ::bus::subscribe("power.resume.dump",
-      [](const String&, const String& /*kv*/){
+    ::bus::subscribe(::bus::t::power_resume_dump,
+      [](::bus::topic_t, const Payload& /*p*/){
         if (File f = LittleFS.open(k_resume_path, "r")) {
           String all = f.readString(); f.close(); all.trim();
           if (all.length()) {
-            ::bus::emit_sticky("trace.svc.power.resume.persist", all);
+            TRACE_TXT(svc_power, LV_INFO, trace_svc_power_resume_persist, all);
             log_line(String("[DUMP] ") + all);
           } else {
-            ::bus::emit_sticky("trace.svc.power.resume.persist", "EMPTY");
+            TRACE_TXT(svc_power, LV_INFO, trace_svc_power_resume_persist, "EMPTY");
             log_line("[DUMP] EMPTY");
           }
         } else {
-          ::bus::emit_sticky("trace.svc.power.resume.persist", "NOFILE");
+          TRACE_TXT(svc_power, LV_INFO, trace_svc_power_resume_persist, "NOFILE");
           log_line("[DUMP] NOFILE");
         }
       });
 
     // Admin: AXP2101 IRQ-Controls (ersetzt das frühere *_irq_ext.cpp)
-    ::bus::subscribe("power.axp.irq",
-      [](const String& /*topic*/, const String& kv){
-        const bool op_dump      = kv.indexOf("op=dump")       >= 0;
-        const bool op_clear_all = kv.indexOf("op=clear_all")  >= 0;
-        const bool op_en_all    = kv.indexOf("op=enable_all") >= 0;
+    ::bus::subscribe(::bus::t::power_axp_irq,
+      [](::bus::topic_t /*topic*/, const Payload& p){
+        const bool op_dump      = p.is(k::op, "dump");
+        const bool op_clear_all = p.is(k::op, "clear_all");
+        const bool op_en_all    = p.is(k::op, "enable_all");
 
         if (op_dump) {
           uint8_t e1=0,e2=0,e3=0, s1=0,s2=0,s3=0;
           s_pmu.getIRQEnableMask(e1,e2,e3);
           s_pmu.getIRQStatus(s1,s2,s3); // nicht-destruktiv
-          ::bus::emit_sticky("trace.svc.power.irq",
-             String("dump en40=0x")+String(e1,16)+" en41=0x"+String(e2,16)+" en42=0x"+String(e3,16)+
-             " st48=0x"+String(s1,16)+" st49=0x"+String(s2,16)+" st4A=0x"+String(s3,16)+
-             " int_lvl="+String(s_pmu.intLevel()));
+          // en = Reg 0x40..0x42, st = Reg 0x48..0x4A (je ein Byte, MSB zuerst)
+          TRACE_REC(svc_power, LV_INFO, trace_svc_power_irq, {k::op, "dump"},
+                    {k::en, ::trace::Hex{(uint32_t)e1 << 16 | e2 << 8 | e3}},
+                    {k::st, ::trace::Hex{(uint32_t)s1 << 16 | s2 << 8 | s3}}, {k::lvl, s_pmu.intLevel()});
           return;
         }
         if (op_clear_all) {
           uint8_t s1=0,s2=0,s3=0; s_pmu.getIRQStatus(s1,s2,s3);
-          ::bus::emit_sticky("trace.svc.power.irq", String("before_clear st=") +
-             String(s1,16)+","+String(s2,16)+","+String(s3,16));
+          TRACE_REC(svc_power, LV_INFO, trace_svc_power_irq, {k::op, "before_clear"},
+                    {k::st, ::trace::Hex{(uint32_t)s1 << 16 | s2 << 8 | s3}});
           s_pmu.clearIRQStatus(); s_pmu.releaseIRQLine();
           s_pmu.getIRQStatus(s1,s2,s3);
-          ::bus::emit_sticky("trace.svc.power.irq", String("after_clear st=") +
-             String(s1,16)+","+String(s2,16)+","+String(s3,16) +
-             " int_lvl="+String(s_pmu.intLevel()));
+          TRACE_REC(svc_power, LV_INFO, trace_svc_power_irq, {k::op, "after_clear"},
+                    {k::st, ::trace::Hex{(uint32_t)s1 << 16 | s2 << 8 | s3}}, {k::lvl, s_pmu.intLevel()});
           return;
         }
         if (op_en_all) {
-          const bool on = (kv.indexOf("value=on")>=0 || kv.indexOf("value=1")>=0 || kv.indexOf("value=true")>=0);
+          const bool on = p.get_bool(k::value, false);
           s_pmu.setIRQEnableMask(on?0xFF:0x00, on?0xFF:0x00, on?0xFF:0x00);
           uint8_t e1=0,e2=0,e3=0; s_pmu.getIRQEnableMask(e1,e2,e3);
-          ::bus::emit_sticky("trace.svc.power.irq", String("en_all on=")+(on?"1":"0")+
-             " en40=0x"+String(e1,16)+" en41=0x"+String(e2,16)+" en42=0x"+String(e3,16));
+          TRACE_REC(svc_power, LV_INFO, trace_svc_power_irq, {k::op, "enable_all"}, {k::value, on},
+                    {k::en, ::trace::Hex{(uint32_t)e1 << 16 | e2 << 8 | e3}});
           return;
         }
       });
   }
 
+  // Nur Hardware + Trace (läuft als Boot-Stage auf dem Hintergrund-Task)
   void pmu_basic_setup() {
-    bool ok = s_pmu.begin(400000 /*Hz*/, true /*release_irq_if_low*/);
-    ::bus::emit_sticky("trace.svc.power.pmu.begin", String("ok=") + (ok?"1":"0"));
-    log_line(String("[PMU] begin ok=") + (ok?"1":"0"));
+    s_pmu_begin_ok = s_pmu.begin(400000 /*Hz*/, true /*release_irq_if_low*/);
+    TRACE_REC(svc_power, LV_INFO, trace_svc_power_pmu_begin, {k::ok, s_pmu_begin_ok});
 
-    bool on = s_pmu.twatchS3_basicPowerOn();
-    ::bus::emit_sticky("trace.svc.power.pmu.twatchS3", String("ok=") + (on?"1":"0"));
-    log_line(String("[PMU] twatchS3_basicPowerOn ok=") + (on?"1":"0"));
+    s_pmu_on_ok = s_pmu.twatchS3_basicPowerOn();
+    TRACE_REC(svc_power, LV_INFO, trace_svc_power_pmu_twatchS3, {k::ok, s_pmu_on_ok});
 
     // ADC: VBAT/VSYS/VBUS aktivieren
     s_pmu.setAdcEnable(
@@ -380,9 +414,6 @@ namespace {
 
     // IRQ-Monitor an
     s_pmu.enableIRQMonitor(true);
-
-    snapshot_power_telemetry("boot");
-    dump_irq_compact("boot_irq");
   }
 }
 
@@ -396,14 +427,27 @@ void init() {
 
   emit_last_resume_capsule_on_boot(); // Boot-Replay
 
-  pmu_basic_setup();
-  subscribe_bus();
+  ::bus::emit_sticky(::bus::t::power_mode_changed, Payload().set(k::mode, "ready").set(k::origin, "boot"));
+  log_line("[MODE] ready origin=boot");
+}
+
+void hw_init() { pmu_basic_setup(); }
 
-  ::bus::emit_sticky("trace.svc.power.policy",
-                     String("pmu_int=? auto_ms=") + String((unsigned long)s_autowake_ms));
+void hw_attach() {
+  log_line(String("[PMU] begin ok=") + (s_pmu_begin_ok?"1":"0"));
+  log_line(String("[PMU] twatchS3_basicPowerOn ok=") + (s_pmu_on_ok?"1":"0"));
+  subscribe_bus();   // Replay: Autowake/Guards/Persist aus den Stickies
+  TRACE_REC(svc_power, LV_INFO, trace_svc_power_policy, {k::ms, s_autowake_ms});
+}
 
-  ::bus::emit_sticky("power.mode_changed", "mode=ready origin=boot");
-  log_line("[MODE] ready origin=boot");
+void telemetry_read() {
+  read_telemetry(s_boot_tel);
+  read_irq(s_boot_irq);
+}
+
+void telemetry_publish() {
+  publish_telemetry("boot", s_boot_tel);
+  publish_irq("boot_irq", s_boot_irq);
 }
 
 } } // namespace svc::power
@@ -3,7 +3,14 @@
 
 namespace svc { namespace power {
 
-// Initialisiert Power-Service inkl. PMU (AXP2101), Logging und Bus-Subscriptions.
+// Früh in setup(): Logging, Resume-Replay, power.mode_changed – ohne PMU-Zugriff.
 void init();
 
+// Boot-Stages (boot.hpp): *_init/*_read auf dem Hintergrund-Task (nur I2C + Trace),
+// hw_attach/telemetry_publish danach im loop().
+void hw_init();             // PMU (AXP2101): begin, Rails, ADC, IRQ-Monitor
+void hw_attach();           // PMU-Log + Bus-Subscriptions (Intents, Guards, Autowake, IRQ-Admin)
+void telemetry_read();      // VBAT/VSYS/VBUS + IRQ-Status messen
+void telemetry_publish();   // state.power.telemetry phase=boot + IRQ-Trace
+
 } } // namespace svc::power
@@ -2,6 +2,7 @@
 #include "service_touch.hpp"
 #include "../drivers/drv_touch_ft6236u.hpp"
 #include "../core/bus.hpp"
+#include "../core/trace.hpp"
 
 namespace svc { namespace touch {
 
@@ -10,91 +11,80 @@ static bool s_wake_touch_lightsleep = false; // default wie user.ini
 static bool s_irq_on                = true;  // aktueller IRQ-Zustand
 static bool s_active                = true;  // aktueller Power-Zustand (active/sleep)
 
-static String kv_find(const String& args, const char* key) {
-  String needle = String(key) + "=";
-  int i = args.indexOf(needle);
-  if (i < 0) return "";
-  int start = i + needle.length();
-  int end = args.indexOf(' ', start);
-  if (end < 0) end = args.length();
-  return args.substring(start, end);
-}
+namespace k = bus::k;
+using bus::Payload;
 
-static inline void TRACE(const char* topic, const String& msg){
-  bus::emit_sticky(String(topic), msg);
+static inline void trace_state(const char* st){
+  TRACE_TXT(svc_touch, LV_INFO, trace_svc_touch_state,
+            String("state=") + st + " power=" + (s_active?"active":"sleep") + " irq=" + (s_irq_on?"on":"off"));
 }
 
 static void apply_power(bool active){
   s_active = active;
-  drv::touch_ft6236u::apply_kv("touch.power", active ? "active" : "sleep");
+  drv::touch_ft6236u::apply_kv(bus::t::touch_power, Payload().set(k::value, active ? "active" : "sleep"));
 }
 
 static void apply_irq(bool on){
   s_irq_on = on;
-  drv::touch_ft6236u::apply_kv("touch.irq", on ? "on" : "off");
+  drv::touch_ft6236u::apply_kv(bus::t::touch_irq, Payload().set(k::value, on ? "on" : "off"));
 }
 
 static void enter_standby(){
   apply_power(false);
   apply_irq(s_wake_touch_standby); // on = Wake-Quelle erlaubt
-  TRACE("trace.svc.touch.state",
-        String("state=standby power=")+(s_active?"active":"sleep")+
-        " irq=" + (s_irq_on?"on":"off"));
+  trace_state("standby");
 }
 
 static void enter_lightsleep(){
   apply_power(false);
   apply_irq(s_wake_touch_lightsleep); // oft off
-  TRACE("trace.svc.touch.state",
-        String("state=lightsleep power=")+(s_active?"active":"sleep")+
-        " irq=" + (s_irq_on?"on":"off"));
+  trace_state("lightsleep");
 }
 
 static void enter_ready(){
   apply_power(true);
   apply_irq(true);
-  TRACE("trace.svc.touch.state",
-        String("state=ready power=")+(s_active?"active":"sleep")+
-        " irq=" + (s_irq_on?"on":"off"));
+  trace_state("ready");
 }
 
-static void on_power_evt(const String& topic, const String& kv){
-  if (topic == "power.intent") {
-    String tgt = kv_find(kv, "target"); tgt.toLowerCase();
-    if (tgt == "standby")    { enter_standby();    return; }
-    if (tgt == "lightsleep") { enter_lightsleep(); return; }
-    if (tgt == "ready")      { enter_ready();      return; }
+static void on_power_evt(bus::topic_t topic, const Payload& p){
+  if (topic == bus::t::power_intent) {
+    if (p.is(k::target, "standby"))    { enter_standby();    return; }
+    if (p.is(k::target, "lightsleep")) { enter_lightsleep(); return; }
+    if (p.is(k::target, "ready"))      { enter_ready();      return; }
   }
 }
 
-static void on_wake_policy(const String& topic, const String& kv){
-  bool on = (kv.indexOf("on")>=0) || (kv.indexOf("true")>=0) || (kv.indexOf("1")>=0);
-  if (topic == "wake.touch_standby") {
+static void on_wake_policy(bus::topic_t topic, const Payload& p){
+  const bool on = p.get_bool(k::value, false);
+  if (topic == bus::t::wake_touch_standby) {
     s_wake_touch_standby = on;
-    TRACE("trace.svc.touch.policy", String("touch_standby=")+(on?1:0));
+    TRACE_TXT(svc_touch, LV_INFO, trace_svc_touch_policy, on ? "touch_standby=1" : "touch_standby=0");
     return;
   }
-  if (topic == "wake.touch_lightsleep") {
+  if (topic == bus::t::wake_touch_lightsleep) {
     s_wake_touch_lightsleep = on;
-    TRACE("trace.svc.touch.policy", String("touch_lightsleep=")+(on?1:0));
+    TRACE_TXT(svc_touch, LV_INFO, trace_svc_touch_policy, on ? "touch_lightsleep=1" : "touch_lightsleep=0");
     return;
   }
 }
 
-void init(){
+void hw_init(){
   // Treiber init (I2C/IRQ Setup), falls das nicht schon woanders geschieht.
   drv::touch_ft6236u::init();
+}
 
+void init(){
   // Power-Intents steuern Touch-Power/IRQ
-  bus::subscribe("power.intent", on_power_evt);
+  bus::subscribe(bus::t::power_intent, on_power_evt);
 
   // Wake-Policy aus dev.ini/user.ini (wird beim Boot als Sticky geprimed)
-  bus::subscribe("wake.touch_standby", on_wake_policy);
-  bus::subscribe("wake.touch_lightsleep", on_wake_policy);
+  bus::subscribe(bus::t::wake_touch_standby, on_wake_policy);
+  bus::subscribe(bus::t::wake_touch_lightsleep, on_wake_policy);
 
   // I2C-Härtung fürs Touch (Forward)
-  bus::subscribe("i2c0.*", [](const String& topic, const String& value){
-    drv::touch_ft6236u::apply_kv(topic, value);
+  bus::subscribe("i2c0.*", [](bus::topic_t topic, const Payload& p){
+    drv::touch_ft6236u::apply_kv(topic, p);
   });
 
   // Bei Ready standardmäßig aktiv + IRQ an
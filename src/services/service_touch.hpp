@@ -4,6 +4,7 @@
 
 namespace svc { namespace touch {
 
-void init();   // managed Touch power/irq based on power intents + wake policy
+void hw_init();   // Treiber (I2C/IRQ), Boot-Stage auf dem Hintergrund-Task
+void init();      // managed Touch power/irq based on power intents + wake policy (nach hw_init)
 
 } } // namespace svc::touch
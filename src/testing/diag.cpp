@@ -1,4 +1,6 @@
 #include "diag.hpp"
+#include "../core/bus.hpp"
+#include "../core/trace.hpp"
 #include <FS.h>
 #include <LittleFS.h>
 #include <freertos/FreeRTOS.h>
@@ -47,6 +49,7 @@ static void IRAM_ATTR axp_isr(void* /*arg*/) {
   w = (w + 1) % RB_N;
   if (rb_cnt < RB_N) { rb_cnt++; rb_w = w; }
   else { rb_over++; rb_w = w; } // überschreiben (älteste raus)
+  TRACE_REC(testing, LV_DEBUG, trace_testing_diag_isr, {bus::k::lvl, lvl});   // Ring ist ISR-fest
 }
 
 static void compute_isr_stats(String& out, bool clearAfter) {
@@ -116,6 +119,7 @@ static void watch_task(void*) {
     vTaskDelay(pdMS_TO_TICKS(1000));
     String s; compute_isr_stats(s, /*clearAfter*/true);
     log_line(s);
+    TRACE_TXT(testing, LV_INFO, trace_testing_diag_stats, s);   // Core 0 → Trace-Ring
   }
 }
 